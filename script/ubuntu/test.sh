@@ -10,11 +10,15 @@ RED='\033[0;31m'
 OFF='\033[0m'
 STATUS=0
 
+# The seconds that a test can take, so a slow schedule fails instead of
+# hanging (a timeout, with status 124, is never a rejection).
+TIMEOUT=60
+
 echo "Compiler should accept..."
 echo ""
 
 for test in $(ls src/test/c/accept/); do
-	cat "src/test/c/accept/$test" | build/Compiler >/dev/null 2>&1
+	cat "src/test/c/accept/$test" | timeout $TIMEOUT build/Compiler >/dev/null 2>&1
 	RESULT="$?"
 	if [ "$RESULT" == "0" ]; then
 		echo -e "    $test, ${GREEN}and it does${OFF} (status $RESULT)"
@@ -29,9 +33,9 @@ echo "Compiler should reject..."
 echo ""
 
 for test in $(ls src/test/c/reject/); do
-	cat "src/test/c/reject/$test" | build/Compiler >/dev/null 2>&1
+	cat "src/test/c/reject/$test" | timeout $TIMEOUT build/Compiler >/dev/null 2>&1
 	RESULT="$?"
-	if [ "$RESULT" != "0" ]; then
+	if [ "$RESULT" != "0" ] && [ "$RESULT" != "124" ]; then
 		echo -e "    $test, ${GREEN}and it does${OFF} (status $RESULT)"
 	else
 		STATUS=1
@@ -1,5 +1,21 @@
 #include "backend/code-generation/Generator.h"
+#include "backend/scheduling/Availability.h"
+#include "backend/scheduling/Bounds.h"
+#include "backend/scheduling/Clashes.h"
+#include "backend/scheduling/Deadline.h"
+#include "backend/scheduling/Decomposition.h"
+#include "backend/scheduling/LocalSearch.h"
+#include "backend/scheduling/Model.h"
+#include "backend/scheduling/Optimizer.h"
+#include "backend/scheduling/Partition.h"
+#include "backend/scheduling/Portfolio.h"
+#include "backend/scheduling/Propagation.h"
+#include "backend/scheduling/Repair.h"
+#include "backend/scheduling/SatEncoding.h"
+#include "backend/scheduling/Solver.h"
+#include "backend/scheduling/Verifier.h"
 #include "frontend/lexical-analysis/FlexActions.h"
+#include "frontend/semantic-analysis/SemanticAnalyzer.h"
 #include "frontend/syntactic-analysis/AbstractSyntaxTree.h"
 #include "frontend/syntactic-analysis/BisonActions.h"
 #include "frontend/syntactic-analysis/SyntacticAnalyzer.h"
@@ -20,7 +36,22 @@ const int main(const int count, const char **arguments)
 	initializeBisonActionsModule();
 	initializeSyntacticAnalyzerModule();
 	initializeAbstractSyntaxTreeModule();
-	// initializeCalculatorModule();
+	initializeSemanticAnalyzerModule();
+	initializeAvailabilityModule();
+	initializePartitionModule();
+	initializeClashesModule();
+	initializeBoundsModule();
+	initializeDeadlineModule();
+	initializeModelModule();
+	initializePropagationModule();
+	initializeSolverModule();
+	initializePortfolioModule();
+	initializeOptimizerModule();
+	initializeLocalSearchModule();
+	initializeDecompositionModule();
+	initializeRepairModule();
+	initializeSatEncodingModule();
+	initializeVerifierModule();
 	initializeGeneratorModule();
 
 	// Logs the arguments of the application.
@@ -32,31 +63,47 @@ const int main(const int count, const char **arguments)
 	// Begin compilation process.
 	CompilerState compilerState = {
 		.abstractSyntaxtTree = NULL,
+		.arena = createArena(0),
 		.succeed = false,
+		.symbolTable = createSymbolTable(),
 		.value = 0};
 	const SyntacticAnalysisStatus syntacticAnalysisStatus = parse(&compilerState);
 	CompilationStatus compilationStatus = SUCCEED;
-	if (syntacticAnalysisStatus == ACCEPT)
+	if (syntacticAnalysisStatus == ACCEPT && analyzeSemantics(&compilerState) == SEMANTIC_REJECT)
+	{
+		logError(logger, "The semantic-analysis phase rejects the input program.");
+		compilationStatus = FAILED;
+	}
+	else if (syntacticAnalysisStatus == ACCEPT && hasScheduleToVerify())
+	{
+		if (verifyScheduleFile(&compilerState) == VERIFICATION_REJECT)
+		{
+			logError(logger, "The verifier rejects the schedule of the input program.");
+			compilationStatus = FAILED;
+		}
+	}
+	else if (syntacticAnalysisStatus == ACCEPT && analyzeClashes(&compilerState) == CLASHES_REJECT)
+	{
+		logError(logger, "The clash analysis rejects the hard preferences of the input program, without scheduling it.");
+		compilationStatus = FAILED;
+	}
+	else if (syntacticAnalysisStatus == ACCEPT && analyzeBounds(&compilerState) == BOUNDS_REJECT)
+	{
+		logError(logger, "The bounds analysis rejects the input program, without scheduling it.");
+		compilationStatus = FAILED;
+	}
+	else if (syntacticAnalysisStatus == ACCEPT)
 	{
 		// ----------------------------------------------------------------------------------------
 		// Beginning of the Backend... ------------------------------------------------------------
-		// logDebugging(logger, "Computing expression value...");
-		Program *program = compilerState.abstractSyntaxtTree;
-		// ComputationResult computationResult = computeExpression(program->expression);
-		// if (computationResult.succeed)
-		//{
-		//	compilerState.value = computationResult.value;
-		//	generate(&compilerState);
-		//}
-		// else
-		//{
-		//	logError(logger, "The computation phase rejects the input program.");
-		//	compilationStatus = FAILED;
-		//}
+		generate(&compilerState);
+		if (!compilerState.succeed)
+		{
+			logError(logger, "The backend cannot schedule the input program.");
+			compilationStatus = FAILED;
+		}
 		// ...end of the Backend. -----------------------------------------------------------------
 		// ----------------------------------------------------------------------------------------
-		logDebugging(logger, "Releasing AST resources...");
-		releaseProgram(program);
 	}
 	else
 	{
@@ -64,9 +111,32 @@ const int main(const int count, const char **arguments)
 		compilationStatus = FAILED;
 	}
 
+	logDebugging(logger, "Releasing AST resources (%zu allocations served from %zu chunks, %zu of %zu bytes used)...",
+				 compilerState.arena->statistics.allocations,
+				 compilerState.arena->statistics.chunks,
+				 compilerState.arena->statistics.requestedBytes,
+				 compilerState.arena->statistics.reservedBytes);
+	destroySymbolTable(compilerState.symbolTable);
+	destroyArena(compilerState.arena);
+
 	logDebugging(logger, "Releasing modules resources...");
 	shutdownGeneratorModule();
-	// shutdownCalculatorModule();
+	shutdownVerifierModule();
+	shutdownSatEncodingModule();
+	shutdownRepairModule();
+	shutdownDecompositionModule();
+	shutdownLocalSearchModule();
+	shutdownOptimizerModule();
+	shutdownPortfolioModule();
+	shutdownSolverModule();
+	shutdownPropagationModule();
+	shutdownModelModule();
+	shutdownDeadlineModule();
+	shutdownBoundsModule();
+	shutdownClashesModule();
+	shutdownPartitionModule();
+	shutdownAvailabilityModule();
+	shutdownSemanticAnalyzerModule();
 	shutdownAbstractSyntaxTreeModule();
 	shutdownSyntacticAnalyzerModule();
 	shutdownBisonActionsModule();
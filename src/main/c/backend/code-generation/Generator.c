@@ -2,13 +2,86 @@
 
 /* MODULE INTERNAL STATE */
 
+/**
+ * The engines that can solve a scheduling model (see "SOLVER_ENGINE").
+ */
+typedef enum
+{
+	// The optimizer if there are soft preferences, or the portfolio otherwise.
+	ENGINE_AUTOMATIC,
+	ENGINE_LOCAL_SEARCH,
+	ENGINE_OPTIMIZER,
+	ENGINE_PORTFOLIO,
+	ENGINE_SAT
+} SolverEngine;
+
+/**
+ * The sink of the improving schedules (see "SCHEDULE_STREAM"): the file is
+ * replaced with every better schedule, so it always holds the best one found
+ * so far.
+ */
+typedef struct
+{
+	const Program *program;
+	const PropagationReport *report;
+	SolverEngine engine;
+	int score;
+	double writtenAt;
+	unsigned int writeCount;
+} ScheduleStream;
+
+// The minimum seconds between two writes of the stream, unless a schedule
+// has a better score.
+#define MINIMUM_STREAM_INTERVAL 1.0
+
 const char _indentationCharacter = ' ';
 const char _indentationSize = 4;
 static Logger *_logger = NULL;
+static SolverEngine _engine = ENGINE_AUTOMATIC;
+static const char *_streamPath = NULL;
+static const char *_dimacsPath = NULL;
+static unsigned int _automaticTimeLimit = 10;
 
 void initializeGeneratorModule()
 {
 	_logger = createLogger("Generator");
+	const char *engine = getStringOrDefault("SOLVER_ENGINE", "automatic");
+	if (strcmp(engine, "local-search") == 0)
+	{
+		_engine = ENGINE_LOCAL_SEARCH;
+	}
+	else if (strcmp(engine, "optimizer") == 0)
+	{
+		_engine = ENGINE_OPTIMIZER;
+	}
+	else if (strcmp(engine, "portfolio") == 0)
+	{
+		_engine = ENGINE_PORTFOLIO;
+	}
+	else if (strcmp(engine, "sat") == 0)
+	{
+		_engine = ENGINE_SAT;
+	}
+	else if (strcmp(engine, "automatic") != 0)
+	{
+		logWarning(_logger, "Unknown solver engine: \"%s\" (using \"automatic\" instead).", engine);
+	}
+	const int automaticTimeLimit = getIntegerOrDefault("AUTOMATIC_TIME_LIMIT", (int)_automaticTimeLimit);
+	if (automaticTimeLimit < 0)
+	{
+		logWarning(_logger, "Invalid time limit of the automatic engine: %d second(s) (using %u instead).", automaticTimeLimit, _automaticTimeLimit);
+	}
+	_automaticTimeLimit = automaticTimeLimit < 0 ? _automaticTimeLimit : (unsigned int)automaticTimeLimit;
+	_streamPath = getStringOrDefault("SCHEDULE_STREAM", NULL);
+	if (_streamPath != NULL && _streamPath[0] == '\0')
+	{
+		_streamPath = NULL;
+	}
+	_dimacsPath = getStringOrDefault("DIMACS_OUTPUT", NULL);
+	if (_dimacsPath != NULL && _dimacsPath[0] == '\0')
+	{
+		_dimacsPath = NULL;
+	}
 }
 
 void shutdownGeneratorModule()
@@ -21,13 +94,304 @@ void shutdownGeneratorModule()
 
 /** PRIVATE FUNCTIONS */
 
+static void _generateConfiguration(FILE *file, const Configuration *configuration);
+static void _generateSchedule(FILE *file, const Program *program, const Schedule *schedule, const PropagationReport *report, const Optimization *optimization);
+static boolean _hasSoftPreferences(const Program *program);
+static boolean _reportsPreferences(const SolverEngine engine);
+static void _writeStream(ScheduleStream *stream, const Model *model, const Assignment *assignments, const Optimization *optimization);
+static void _streamSchedule(const Model *model, const Assignment *assignments, const int score, void *argument);
+static Optimization *_solve(const Model *model, const unsigned int threadCount, const ScheduleListener *listener, void *argument);
+static void _output(FILE *file, const unsigned int indentationLevel, const char *const format, ...);
+
+/**
+ * Generates the configuration of the schedule (the same of the input).
+ */
+static void _generateConfiguration(FILE *file, const Configuration *configuration)
+{
+	_output(file, 0, "university open from %02d:%02d to %02d:%02d;\n",
+			configuration->universityOpen.openFrom.hour, configuration->universityOpen.openFrom.minute,
+			configuration->universityOpen.openTo.hour, configuration->universityOpen.openTo.minute);
+	if (configuration->hasClassDuration)
+	{
+		_output(file, 0, "class duration between %dh and %dh;\n", configuration->classDuration.minHours, configuration->classDuration.maxHours);
+	}
+}
+
+/**
+ * Generates the schedule as hard preferences of the input language, so the
+ * output is also a valid program (grouped by day).
+ */
+static void _generateSchedule(FILE *file, const Program *program, const Schedule *schedule, const PropagationReport *report, const Optimization *optimization)
+{
+	_output(file, 0, "// Schedule of %u class(es).\n", schedule->sessionCount);
+	_output(file, 0, "// Propagation prunes the candidate times from %u to %u.\n", report->initialPlacements, report->finalPlacements);
+	if (optimization != NULL)
+	{
+		if (weighsPreferences())
+		{
+			_output(file, 0, "// It satisfies %d of %u soft preference(s), with a score of %d of %d%s.\n", optimization->satisfied, optimization->preferenceCount,
+					optimization->score, optimization->maximumScore, optimization->optimal ? " (optimal)" : "");
+		}
+		else
+		{
+			_output(file, 0, "// It satisfies %d of %u soft preference(s)%s.\n", optimization->satisfied, optimization->preferenceCount,
+					optimization->optimal ? " (optimal)" : "");
+		}
+	}
+	_generateConfiguration(file, &program->configuration);
+	for (unsigned int k = 0; k < schedule->sessionCount; ++k)
+	{
+		const ScheduledSession *session = &schedule->sessions[k];
+		if (k == 0 || schedule->sessions[k - 1].day != session->day)
+		{
+			_output(file, 0, "\n// %s.\n", dayOfWeekToString(session->day));
+		}
+		_output(file, 0, "%s teaches %s from %02d:%02d to %02d:%02d on %s",
+				program->professors[session->professor].id, program->courses[session->course].id,
+				session->start.hour, session->start.minute, session->end.hour, session->end.minute,
+				dayOfWeekToString(session->day));
+		if (session->classroom != UNDEFINED_SYMBOL)
+		{
+			_output(file, 0, " in %s", program->classrooms[session->classroom].id);
+		}
+		_output(file, 0, ";\n");
+	}
+}
+
+static boolean _hasSoftPreferences(const Program *program)
+{
+	for (unsigned int k = 0; k < program->preferenceCount; ++k)
+	{
+		if (program->preferences[k].type == SOFT_PREFERENCE)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Returns true if an engine optimizes the soft preferences (the portfolio
+ * and the SAT engine only find a schedule).
+ */
+static boolean _reportsPreferences(const SolverEngine engine)
+{
+	return engine != ENGINE_PORTFOLIO && engine != ENGINE_SAT;
+}
+
+/**
+ * Replaces the file of the stream with a schedule (writing a temporary file
+ * first, so a reader never sees a partial schedule). The schedule is
+ * verified first, as the final one, so the stream never holds a schedule
+ * that violates a hard constraint.
+ */
+static void _writeStream(ScheduleStream *stream, const Model *model, const Assignment *assignments, const Optimization *optimization)
+{
+	Schedule *schedule = createScheduleFromAssignments(model, assignments);
+	if (verifySchedule(stream->program, schedule) == VERIFICATION_REJECT)
+	{
+		logCritical(_logger, "A schedule of the stream violates the hard constraints of the program, so it's not written.");
+		destroySchedule(schedule);
+		return;
+	}
+	char *temporaryPath = concatenate(2, _streamPath, ".tmp");
+	FILE *file = fopen(temporaryPath, "w");
+	if (file == NULL)
+	{
+		logWarning(_logger, "Cannot write the schedule stream \"%s\".", temporaryPath);
+		destroySchedule(schedule);
+		free(temporaryPath);
+		return;
+	}
+	_generateSchedule(file, stream->program, schedule, stream->report, _reportsPreferences(stream->engine) ? optimization : NULL);
+	destroySchedule(schedule);
+	fclose(file);
+	if (rename(temporaryPath, _streamPath) != 0)
+	{
+		logWarning(_logger, "Cannot replace the schedule stream \"%s\".", _streamPath);
+	}
+	free(temporaryPath);
+	stream->writtenAt = elapsedSeconds();
+	stream->writeCount += 1;
+}
+
+/**
+ * The listener of the solver engines: it writes every better schedule to the
+ * stream, unless the last write is too recent and the schedule has no better
+ * score (the final schedule is always written).
+ */
+static void _streamSchedule(const Model *model, const Assignment *assignments, const int score, void *argument)
+{
+	ScheduleStream *stream = argument;
+	if (0 < stream->writeCount && score <= stream->score && elapsedSeconds() < stream->writtenAt + MINIMUM_STREAM_INTERVAL)
+	{
+		return;
+	}
+	Optimization optimization = {
+		.status = SOLVER_SATISFIABLE,
+		.assignments = NULL,
+		.satisfied = 0,
+		.preferenceCount = model->softPreferenceCount,
+		.score = score,
+		.maximumScore = model->maximumScore,
+		.optimal = false,
+		.nodes = 0};
+	scoreAssignments(model, assignments, &optimization.satisfied);
+	stream->score = score;
+	_writeStream(stream, model, assignments, &optimization);
+	logDebugging(_logger, "Streams a schedule that satisfies %d soft preference(s), after %.3f second(s).", optimization.satisfied, elapsedSeconds());
+}
+
+/**
+ * Solves a model (or a component of it) with an engine, other than
+ * automatic. The portfolio and the SAT engine only find a schedule, so they
+ * never report the satisfied soft preferences.
+ */
+static Optimization *_solve(const Model *model, const unsigned int threadCount, const ScheduleListener *listener, void *argument)
+{
+	const SolverEngine engine = *(const SolverEngine *)argument;
+	if (engine == ENGINE_SAT)
+	{
+		return satisfyModel(model, listener);
+	}
+	Optimization *optimization = NULL;
+	SolverStatus status = SOLVER_UNSATISFIABLE;
+	Solver *solver = solvePortfolio(model, threadCount, &status);
+	if (engine == ENGINE_OPTIMIZER && status == SOLVER_SATISFIABLE)
+	{
+		// The local search finds a good incumbent fast, so the bound of the
+		// optimizer prunes far more from the start.
+		Optimization *seed = improveSchedule(model, solver->assignments, listener);
+		optimization = optimize(model, seed->assignments, threadCount, listener);
+		destroyOptimization(seed);
+	}
+	else if (engine == ENGINE_LOCAL_SEARCH && status == SOLVER_SATISFIABLE)
+	{
+		optimization = improveSchedule(model, solver->assignments, listener);
+	}
+	else
+	{
+		optimization = calloc(1, sizeof(Optimization));
+		optimization->status = status;
+		optimization->preferenceCount = model->softPreferenceCount;
+		optimization->maximumScore = model->maximumScore;
+		if (status == SOLVER_SATISFIABLE)
+		{
+			optimization->assignments = calloc(1 + model->sessionCount, sizeof(Assignment));
+			memcpy(optimization->assignments, solver->assignments, model->sessionCount * sizeof(Assignment));
+			optimization->nodes = solver->nodes;
+			notifySchedule(listener, model, optimization->assignments, 0);
+		}
+	}
+	destroySolver(solver);
+	return optimization;
+}
+
+/**
+ * Outputs a formatted string to a file (e.g., the standard output).
+ */
+static void _output(FILE *file, const unsigned int indentationLevel, const char *const format, ...)
+{
+	va_list arguments;
+	va_start(arguments, format);
+	char *indentationString = indentation(_indentationCharacter, indentationLevel, _indentationSize);
+	char *effectiveFormat = concatenate(2, indentationString, format);
+	vfprintf(file, effectiveFormat, arguments);
+	free(effectiveFormat);
+	free(indentationString);
+	va_end(arguments);
+}
+
 /** PUBLIC FUNCTIONS */
 
 void generate(CompilerState *compilerState)
 {
 	logDebugging(_logger, "Generating final output...");
-	//_generatePrologue();
-	//_generateProgram(compilerState->abstractSyntaxtTree);
-	//_generateEpilogue(compilerState->value);
+	const Program *program = compilerState->abstractSyntaxtTree;
+	Model *model = createModel(program);
+	if (model == NULL)
+	{
+		logError(_logger, "The program has contradictory hard constraints.");
+		compilerState->succeed = false;
+		return;
+	}
+	PropagationReport report;
+	if (!propagateModel(model, &report))
+	{
+		logError(_logger, "The program has contradictory hard constraints.");
+		compilerState->succeed = false;
+		destroyModel(model);
+		return;
+	}
+	if (_dimacsPath != NULL)
+	{
+		exportDimacs(model, _dimacsPath);
+	}
+	SolverEngine engine = _engine;
+	if (engine == ENGINE_AUTOMATIC)
+	{
+		// The optimizer may never prove optimality on a large program, so its
+		// improvement has a budget (besides the time limit of the solver).
+		engine = _hasSoftPreferences(program) ? ENGINE_OPTIMIZER : ENGINE_PORTFOLIO;
+		limitImprovement(_automaticTimeLimit);
+	}
+	ScheduleStream stream = {
+		.program = program,
+		.report = &report,
+		.engine = engine,
+		.score = -1,
+		.writtenAt = 0,
+		.writeCount = 0};
+	const ScheduleListener streamListener = {
+		.function = _streamSchedule,
+		.argument = &stream};
+	const ScheduleListener *listener = _streamPath == NULL ? NULL : &streamListener;
+	Optimization *optimization = NULL;
+	if (hasPreviousSchedule())
+	{
+		optimization = repairSchedule(model, compilerState->symbolTable, _solve, listener, &engine);
+	}
+	if (optimization == NULL)
+	{
+		optimization = solveComponents(model, _solve, listener, &engine);
+	}
+	Schedule *schedule = NULL;
+	if (optimization->status == SOLVER_SATISFIABLE)
+	{
+		schedule = createScheduleFromAssignments(model, optimization->assignments);
+	}
+	if (schedule != NULL && verifySchedule(program, schedule) == VERIFICATION_REJECT)
+	{
+		logCritical(_logger, "The schedule violates the hard constraints of the program, so it's discarded.");
+		destroySchedule(schedule);
+		compilerState->succeed = false;
+	}
+	else if (schedule != NULL)
+	{
+		_generateSchedule(stdout, program, schedule, &report, _reportsPreferences(engine) ? optimization : NULL);
+		destroySchedule(schedule);
+		if (listener != NULL)
+		{
+			_writeStream(&stream, model, optimization->assignments, optimization);
+		}
+	}
+	else if (optimization->status == SOLVER_TIMEOUT)
+	{
+		logError(_logger, "The time limit expired before any schedule was found (after %.3f second(s)).", elapsedSeconds());
+		compilerState->succeed = false;
+	}
+	else if (model->usesClassrooms && engine != ENGINE_SAT)
+	{
+		// Only the SAT engine assigns the classrooms exhaustively.
+		logError(_logger, "No schedule that satisfies every hard constraint was found (the search of classrooms is bounded, so the \"sat\" engine might still find one).");
+		compilerState->succeed = false;
+	}
+	else
+	{
+		logError(_logger, "There is no schedule that satisfies every hard constraint.");
+		compilerState->succeed = false;
+	}
+	destroyOptimization(optimization);
+	destroyModel(model);
 	logDebugging(_logger, "Generation is done.");
 }
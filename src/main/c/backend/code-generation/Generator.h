@@ -3,8 +3,21 @@
 
 #include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
 #include "../../shared/CompilerState.h"
+#include "../../shared/Environment.h"
 #include "../../shared/Logger.h"
 #include "../../shared/String.h"
+#include "../scheduling/Deadline.h"
+#include "../scheduling/Decomposition.h"
+#include "../scheduling/LocalSearch.h"
+#include "../scheduling/Model.h"
+#include "../scheduling/Optimizer.h"
+#include "../scheduling/Portfolio.h"
+#include "../scheduling/Propagation.h"
+#include "../scheduling/Repair.h"
+#include "../scheduling/SatEncoding.h"
+#include "../scheduling/Schedule.h"
+#include "../scheduling/Solver.h"
+#include "../scheduling/Verifier.h"
 #include <stdarg.h>
 #include <stdio.h>
 
@@ -15,7 +28,10 @@ void initializeGeneratorModule();
 void shutdownGeneratorModule();
 
 /**
- * Generates the final output using the current compiler state.
+ * Generates the final output using the current compiler state: a schedule
+ * that satisfies every hard constraint of the program. If there is no such
+ * schedule, the compiler state is marked as failed. The final schedule is
+ * checked again by the verifier, before it's written.
  */
 void generate(CompilerState * compilerState);
 
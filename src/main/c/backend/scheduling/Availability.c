@@ -0,0 +1,190 @@
+#include "Availability.h"
+
+/* MODULE INTERNAL STATE */
+
+static Logger *_logger = NULL;
+static unsigned int _granularity = 30;
+
+void initializeAvailabilityModule()
+{
+	_logger = createLogger("Availability");
+	const int granularity = getIntegerOrDefault("SCHEDULE_GRANULARITY", _granularity);
+	if (granularity <= 0 || 24 * 60 < granularity)
+	{
+		logWarning(_logger, "Invalid granularity of %d minutes (using %u minutes instead).", granularity, _granularity);
+	}
+	else
+	{
+		_granularity = granularity;
+	}
+}
+
+void shutdownAvailabilityModule()
+{
+	if (_logger != NULL)
+	{
+		destroyLogger(_logger);
+	}
+}
+
+/** PRIVATE FUNCTIONS */
+
+static unsigned int _toMinutes(const Time time);
+
+/**
+ * The minute of the day of a time.
+ */
+static unsigned int _toMinutes(const Time time)
+{
+	return 60 * time.hour + time.minute;
+}
+
+/** PUBLIC FUNCTIONS */
+
+TimeGrid createTimeGrid(const Configuration *configuration)
+{
+	TimeGrid grid;
+	grid.granularity = _granularity;
+	grid.openMinute = _toMinutes(configuration->universityOpen.openFrom);
+	grid.closeMinute = _toMinutes(configuration->universityOpen.openTo);
+	if (grid.closeMinute < grid.openMinute)
+	{
+		grid.closeMinute = grid.openMinute;
+	}
+	grid.slotsPerDay = (grid.closeMinute - grid.openMinute) / grid.granularity;
+	grid.slotCount = WEEK_DAY_COUNT * grid.slotsPerDay;
+	grid.wordCount = BITSET_WORDS(grid.slotCount);
+	if (grid.wordCount == 0)
+	{
+		grid.wordCount = 1;
+	}
+	return grid;
+}
+
+boolean intervalToSlots(const TimeGrid *grid, const Time start, const Time end, unsigned int *firstSlot, unsigned int *slotCount)
+{
+	const unsigned int startMinute = _toMinutes(start) < grid->openMinute ? grid->openMinute : _toMinutes(start);
+	const unsigned int endMinute = grid->closeMinute < _toMinutes(end) ? grid->closeMinute : _toMinutes(end);
+	if (endMinute <= startMinute)
+	{
+		return false;
+	}
+	// Rounds inwards: only slots completely inside the interval.
+	const unsigned int first = (startMinute - grid->openMinute + grid->granularity - 1) / grid->granularity;
+	const unsigned int last = (endMinute - grid->openMinute) / grid->granularity;
+	if (last <= first)
+	{
+		return false;
+	}
+	*firstSlot = first;
+	*slotCount = last - first;
+	return true;
+}
+
+Time slotToTime(const TimeGrid *grid, const unsigned int slot)
+{
+	const unsigned int minutes = grid->openMinute + slot * grid->granularity;
+	Time time;
+	time.hour = minutes / 60;
+	time.minute = minutes % 60;
+	return time;
+}
+
+void markInterval(const TimeGrid *grid, BitsetWord *set, const IntervalDayOfWeek interval)
+{
+	unsigned int firstSlot = 0;
+	unsigned int slotCount = 0;
+	if (!intervalToSlots(grid, interval.start, interval.end, &firstSlot, &slotCount))
+	{
+		return;
+	}
+	if (interval.dayOfWeek == DAY_EVERYDAY)
+	{
+		for (unsigned int day = 0; day < WEEK_DAY_COUNT; ++day)
+		{
+			bitsetSetRange(set, day * grid->slotsPerDay + firstSlot, slotCount);
+		}
+	}
+	else
+	{
+		bitsetSetRange(set, interval.dayOfWeek * grid->slotsPerDay + firstSlot, slotCount);
+	}
+}
+
+AvailabilityTable *createAvailabilityTable(const Program *program)
+{
+	AvailabilityTable *table = calloc(1, sizeof(AvailabilityTable));
+	table->grid = createTimeGrid(&program->configuration);
+	const TimeGrid *grid = &table->grid;
+	const unsigned int words = grid->wordCount;
+	table->professorCount = program->professorCount;
+	table->classroomCount = program->classroomCount;
+	table->preferenceCount = program->preferenceCount;
+	table->professors = calloc(1 + table->professorCount * words, sizeof(BitsetWord));
+	table->classrooms = calloc(1 + table->classroomCount * words, sizeof(BitsetWord));
+	table->preferences = calloc(1 + table->preferenceCount * words, sizeof(BitsetWord));
+
+	for (unsigned int k = 0; k < program->professorCount; ++k)
+	{
+		const Professor *professor = &program->professors[k];
+		BitsetWord *row = professorAvailability(table, k);
+		if (!professor->declared)
+		{
+			continue;
+		}
+		if (professor->availabilityCount == 0)
+		{
+			bitsetSetRange(row, 0, grid->slotCount);
+		}
+		for (unsigned int a = 0; a < professor->availabilityCount; ++a)
+		{
+			markInterval(grid, row, professor->availability[a]);
+		}
+	}
+
+	for (unsigned int k = 0; k < program->preferenceCount; ++k)
+	{
+		const PreferenceDetails *details = &program->preferences[k].details;
+		BitsetWord *row = preferenceWindow(table, k);
+		IntervalDayOfWeek interval;
+		interval.dayOfWeek = details->hasDay ? details->day : DAY_EVERYDAY;
+		interval.start = details->hasTime ? details->startTime : program->configuration.universityOpen.openFrom;
+		interval.end = details->hasTime ? details->endTime : program->configuration.universityOpen.openTo;
+		markInterval(grid, row, interval);
+		if (program->preferences[k].type == HARD_PREFERENCE && details->hasTime && details->classroom != UNDEFINED_SYMBOL)
+		{
+			BitsetWord *occupancy = classroomOccupancy(table, details->classroom);
+			bitsetUnion(occupancy, occupancy, row, words);
+		}
+	}
+
+	logDebugging(_logger, "Time-grid of %u slots of %u minutes (%u per day, %u words per bitset).",
+				 grid->slotCount, grid->granularity, grid->slotsPerDay, words);
+	return table;
+}
+
+void destroyAvailabilityTable(AvailabilityTable *availabilityTable)
+{
+	if (availabilityTable != NULL)
+	{
+		free(availabilityTable->professors);
+		free(availabilityTable->classrooms);
+		free(availabilityTable->preferences);
+		free(availabilityTable);
+	}
+}
+
+BitsetWord *professorAvailability(const AvailabilityTable *availabilityTable, const SymbolId professor)
+{
+	return availabilityTable->professors + professor * availabilityTable->grid.wordCount;
+}
+
+BitsetWord *classroomOccupancy(const AvailabilityTable *availabilityTable, const SymbolId classroom)
+{
+	return availabilityTable->classrooms + classroom * availabilityTable->grid.wordCount;
+}
+
+BitsetWord *preferenceWindow(const AvailabilityTable *availabilityTable, const unsigned int preference)
+{
+	return availabilityTable->preferences + preference * availabilityTable->grid.wordCount;
+}
@@ -0,0 +1,103 @@
+#ifndef AVAILABILITY_HEADER
+#define AVAILABILITY_HEADER
+
+#include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
+#include "../../shared/Environment.h"
+#include "../../shared/Logger.h"
+#include "../../shared/Type.h"
+#include "Bitset.h"
+
+/** Initialize module's internal state. */
+void initializeAvailabilityModule();
+
+/** Shutdown module's internal state. */
+void shutdownAvailabilityModule();
+
+/**
+ * The amount of days of the week with classes (from MONDAY to FRIDAY).
+ */
+#define WEEK_DAY_COUNT 5
+
+/**
+ * A discretization of the week in fixed slots of "granularity" minutes,
+ * bounded by the opening hours of the university. The slot "s" of the day
+ * "d" has the week-index "d * slotsPerDay + s", so every set of slots of the
+ * week (i.e., a professor availability, or a classroom occupancy) is a bitset
+ * of "wordCount" words.
+ */
+typedef struct {
+	unsigned int granularity;
+	unsigned int openMinute;
+	unsigned int closeMinute;
+	unsigned int slotsPerDay;
+	unsigned int slotCount;
+	unsigned int wordCount;
+} TimeGrid;
+
+/**
+ * The availability of every entity of a program, as bitsets over a time-grid
+ * (stored contiguously, one row per entity).
+ */
+typedef struct {
+	TimeGrid grid;
+
+	// Slots where each professor is available (indexed by symbol).
+	BitsetWord * professors;
+	unsigned int professorCount;
+
+	// Slots where each classroom is already reserved by a hard preference
+	// (indexed by symbol).
+	BitsetWord * classrooms;
+	unsigned int classroomCount;
+
+	// Slots allowed by each preference (indexed like the program preferences):
+	// the exact interval if it has time, or the whole day otherwise.
+	BitsetWord * preferences;
+	unsigned int preferenceCount;
+} AvailabilityTable;
+
+/**
+ * Creates the time-grid of a configuration, using the configured granularity
+ * (see "SCHEDULE_GRANULARITY").
+ */
+TimeGrid createTimeGrid(const Configuration * configuration);
+
+/**
+ * Converts an interval of a single day to the slots of a time-grid that are
+ * completely inside of it, clipped to the opening hours. Returns false if
+ * there is no such slot.
+ */
+boolean intervalToSlots(const TimeGrid * grid, const Time start, const Time end, unsigned int * firstSlot, unsigned int * slotCount);
+
+/**
+ * Converts a slot of a day back to the time when it begins.
+ */
+Time slotToTime(const TimeGrid * grid, const unsigned int slot);
+
+/**
+ * Sets the slots of an interval in a week bitset. The EVERYDAY interval sets
+ * the slots of every day of the week.
+ */
+void markInterval(const TimeGrid * grid, BitsetWord * set, const IntervalDayOfWeek interval);
+
+/**
+ * Builds the availability table of a program. A professor without "available"
+ * declarations is considered available whenever the university is open.
+ */
+AvailabilityTable * createAvailabilityTable(const Program * program);
+
+/**
+ * Destroy an availability table and its resources.
+ */
+void destroyAvailabilityTable(AvailabilityTable * availabilityTable);
+
+/** The availability row of a professor. */
+BitsetWord * professorAvailability(const AvailabilityTable * availabilityTable, const SymbolId professor);
+
+/** The occupancy row of a classroom. */
+BitsetWord * classroomOccupancy(const AvailabilityTable * availabilityTable, const SymbolId classroom);
+
+/** The allowed slots of a preference. */
+BitsetWord * preferenceWindow(const AvailabilityTable * availabilityTable, const unsigned int preference);
+
+#endif
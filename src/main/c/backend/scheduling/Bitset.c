@@ -0,0 +1,216 @@
+#include "Bitset.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/* PRIVATE FUNCTIONS */
+
+static unsigned int _population(const BitsetWord word);
+static BitsetWord _rangeMask(const unsigned int from, const unsigned int to);
+
+/**
+ * The amount of bits set in a single word.
+ */
+static unsigned int _population(const BitsetWord word) {
+#if defined(__GNUC__) || defined(__clang__)
+	return (unsigned int) __builtin_popcountll(word);
+#else
+	BitsetWord x = word - ((word >> 1) & 0x5555555555555555ULL);
+	x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+	x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	return (unsigned int) ((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/**
+ * A word with the bits in [from, to) set, where 0 <= from < to <= 64.
+ */
+static BitsetWord _rangeMask(const unsigned int from, const unsigned int to) {
+	const BitsetWord high = to == BITSET_WORD_BITS ? ~((BitsetWord) 0) : (((BitsetWord) 1) << to) - 1;
+	return high & ~((((BitsetWord) 1) << from) - 1);
+}
+
+/* PUBLIC FUNCTIONS */
+
+BitsetWord * createBitset(const unsigned int words) {
+	return calloc(words == 0 ? 1 : words, sizeof(BitsetWord));
+}
+
+void destroyBitset(BitsetWord * set) {
+	free(set);
+}
+
+void bitsetClear(BitsetWord * set, const unsigned int words) {
+	memset(set, 0, words * sizeof(BitsetWord));
+}
+
+void bitsetCopy(BitsetWord * target, const BitsetWord * source, const unsigned int words) {
+	memcpy(target, source, words * sizeof(BitsetWord));
+}
+
+void bitsetSetRange(BitsetWord * set, const unsigned int from, const unsigned int count) {
+	unsigned int bit = from;
+	const unsigned int end = from + count;
+	while (bit < end) {
+		const unsigned int offset = bit % BITSET_WORD_BITS;
+		const unsigned int to = end - bit + offset < BITSET_WORD_BITS ? end - bit + offset : BITSET_WORD_BITS;
+		set[bit / BITSET_WORD_BITS] |= _rangeMask(offset, to);
+		bit += to - offset;
+	}
+}
+
+void bitsetResetRange(BitsetWord * set, const unsigned int from, const unsigned int count) {
+	unsigned int bit = from;
+	const unsigned int end = from + count;
+	while (bit < end) {
+		const unsigned int offset = bit % BITSET_WORD_BITS;
+		const unsigned int to = end - bit + offset < BITSET_WORD_BITS ? end - bit + offset : BITSET_WORD_BITS;
+		set[bit / BITSET_WORD_BITS] &= ~_rangeMask(offset, to);
+		bit += to - offset;
+	}
+}
+
+boolean bitsetAnyInRange(const BitsetWord * set, const unsigned int from, const unsigned int count) {
+	unsigned int bit = from;
+	const unsigned int end = from + count;
+	while (bit < end) {
+		const unsigned int offset = bit % BITSET_WORD_BITS;
+		const unsigned int to = end - bit + offset < BITSET_WORD_BITS ? end - bit + offset : BITSET_WORD_BITS;
+		if (set[bit / BITSET_WORD_BITS] & _rangeMask(offset, to)) {
+			return true;
+		}
+		bit += to - offset;
+	}
+	return false;
+}
+
+boolean bitsetAllInRange(const BitsetWord * set, const unsigned int from, const unsigned int count) {
+	unsigned int bit = from;
+	const unsigned int end = from + count;
+	while (bit < end) {
+		const unsigned int offset = bit % BITSET_WORD_BITS;
+		const unsigned int to = end - bit + offset < BITSET_WORD_BITS ? end - bit + offset : BITSET_WORD_BITS;
+		const BitsetWord mask = _rangeMask(offset, to);
+		if ((set[bit / BITSET_WORD_BITS] & mask) != mask) {
+			return false;
+		}
+		bit += to - offset;
+	}
+	return true;
+}
+
+void bitsetIntersection(BitsetWord * target, const BitsetWord * left, const BitsetWord * right, const unsigned int words) {
+	unsigned int k = 0;
+#if defined(__AVX2__)
+	for (; k + 4 <= words; k += 4) {
+		const __m256i l = _mm256_loadu_si256((const __m256i *) (left + k));
+		const __m256i r = _mm256_loadu_si256((const __m256i *) (right + k));
+		_mm256_storeu_si256((__m256i *) (target + k), _mm256_and_si256(l, r));
+	}
+#endif
+	for (; k < words; ++k) {
+		target[k] = left[k] & right[k];
+	}
+}
+
+void bitsetUnion(BitsetWord * target, const BitsetWord * left, const BitsetWord * right, const unsigned int words) {
+	unsigned int k = 0;
+#if defined(__AVX2__)
+	for (; k + 4 <= words; k += 4) {
+		const __m256i l = _mm256_loadu_si256((const __m256i *) (left + k));
+		const __m256i r = _mm256_loadu_si256((const __m256i *) (right + k));
+		_mm256_storeu_si256((__m256i *) (target + k), _mm256_or_si256(l, r));
+	}
+#endif
+	for (; k < words; ++k) {
+		target[k] = left[k] | right[k];
+	}
+}
+
+void bitsetDifference(BitsetWord * target, const BitsetWord * left, const BitsetWord * right, const unsigned int words) {
+	unsigned int k = 0;
+#if defined(__AVX2__)
+	for (; k + 4 <= words; k += 4) {
+		const __m256i l = _mm256_loadu_si256((const __m256i *) (left + k));
+		const __m256i r = _mm256_loadu_si256((const __m256i *) (right + k));
+		_mm256_storeu_si256((__m256i *) (target + k), _mm256_andnot_si256(r, l));
+	}
+#endif
+	for (; k < words; ++k) {
+		target[k] = left[k] & ~right[k];
+	}
+}
+
+boolean bitsetIntersects(const BitsetWord * left, const BitsetWord * right, const unsigned int words) {
+	unsigned int k = 0;
+#if defined(__AVX2__)
+	for (; k + 4 <= words; k += 4) {
+		const __m256i l = _mm256_loadu_si256((const __m256i *) (left + k));
+		const __m256i r = _mm256_loadu_si256((const __m256i *) (right + k));
+		if (!_mm256_testz_si256(l, r)) {
+			return true;
+		}
+	}
+#endif
+	for (; k < words; ++k) {
+		if (left[k] & right[k]) {
+			return true;
+		}
+	}
+	return false;
+}
+
+boolean bitsetIsSubset(const BitsetWord * subset, const BitsetWord * superset, const unsigned int words) {
+	unsigned int k = 0;
+#if defined(__AVX2__)
+	for (; k + 4 <= words; k += 4) {
+		const __m256i sub = _mm256_loadu_si256((const __m256i *) (subset + k));
+		const __m256i super = _mm256_loadu_si256((const __m256i *) (superset + k));
+		// testc(super, sub) is 1 iff (~super & sub) == 0.
+		if (!_mm256_testc_si256(super, sub)) {
+			return false;
+		}
+	}
+#endif
+	for (; k < words; ++k) {
+		if (subset[k] & ~superset[k]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+unsigned int bitsetPopulation(const BitsetWord * set, const unsigned int words) {
+	unsigned int population = 0;
+	for (unsigned int k = 0; k < words; ++k) {
+		population += _population(set[k]);
+	}
+	return population;
+}
+
+unsigned int bitsetIntersectionPopulation(const BitsetWord * left, const BitsetWord * right, const unsigned int words) {
+	unsigned int population = 0;
+	for (unsigned int k = 0; k < words; ++k) {
+		population += _population(left[k] & right[k]);
+	}
+	return population;
+}
+
+int bitsetLast(const BitsetWord * set, const unsigned int words) {
+	for (unsigned int k = words; 0 < k; --k) {
+		const BitsetWord word = set[k - 1];
+		if (word != 0) {
+#if defined(__GNUC__) || defined(__clang__)
+			const int bit = BITSET_WORD_BITS - 1 - __builtin_clzll(word);
+#else
+			int bit = BITSET_WORD_BITS - 1;
+			while (!((word >> bit) & 1)) {
+				--bit;
+			}
+#endif
+			return (int) ((k - 1) * BITSET_WORD_BITS) + bit;
+		}
+	}
+	return -1;
+}
@@ -0,0 +1,83 @@
+#ifndef BITSET_HEADER
+#define BITSET_HEADER
+
+#include "../../shared/Type.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Fixed-width bitsets, stored as arrays of 64-bit words. The width is not
+ * stored inside the bitset: every kernel receives the amount of words, which
+ * is the same for every bitset of a time-grid.
+ *
+ * If the compiler targets AVX2 (e.g., with "-mavx2"), the kernels process 256
+ * bits per instruction; otherwise, they are word-parallel (64 bits).
+ */
+typedef unsigned long long BitsetWord;
+
+#define BITSET_WORD_BITS 64
+
+/** The amount of words required to store the specified amount of bits. */
+#define BITSET_WORDS(bits) (((bits) + BITSET_WORD_BITS - 1) / BITSET_WORD_BITS)
+
+static inline boolean bitsetTest(const BitsetWord * set, const unsigned int bit) {
+	return (set[bit / BITSET_WORD_BITS] >> (bit % BITSET_WORD_BITS)) & 1 ? true : false;
+}
+
+static inline void bitsetSet(BitsetWord * set, const unsigned int bit) {
+	set[bit / BITSET_WORD_BITS] |= ((BitsetWord) 1) << (bit % BITSET_WORD_BITS);
+}
+
+static inline void bitsetReset(BitsetWord * set, const unsigned int bit) {
+	set[bit / BITSET_WORD_BITS] &= ~(((BitsetWord) 1) << (bit % BITSET_WORD_BITS));
+}
+
+/** Allocates a zeroed bitset (heap-memory). */
+BitsetWord * createBitset(const unsigned int words);
+
+/** Destroy a bitset. */
+void destroyBitset(BitsetWord * set);
+
+/** Resets every bit. */
+void bitsetClear(BitsetWord * set, const unsigned int words);
+
+/** Copies a bitset. */
+void bitsetCopy(BitsetWord * target, const BitsetWord * source, const unsigned int words);
+
+/** Sets the bits in [from, from + count). */
+void bitsetSetRange(BitsetWord * set, const unsigned int from, const unsigned int count);
+
+/** Resets the bits in [from, from + count). */
+void bitsetResetRange(BitsetWord * set, const unsigned int from, const unsigned int count);
+
+/** Returns true if any bit in [from, from + count) is set (i.e., an overlap). */
+boolean bitsetAnyInRange(const BitsetWord * set, const unsigned int from, const unsigned int count);
+
+/** Returns true if every bit in [from, from + count) is set (i.e., a fit). */
+boolean bitsetAllInRange(const BitsetWord * set, const unsigned int from, const unsigned int count);
+
+/** target = left & right. */
+void bitsetIntersection(BitsetWord * target, const BitsetWord * left, const BitsetWord * right, const unsigned int words);
+
+/** target = left | right. */
+void bitsetUnion(BitsetWord * target, const BitsetWord * left, const BitsetWord * right, const unsigned int words);
+
+/** target = left & ~right. */
+void bitsetDifference(BitsetWord * target, const BitsetWord * left, const BitsetWord * right, const unsigned int words);
+
+/** Returns true if (left & right) is not empty. */
+boolean bitsetIntersects(const BitsetWord * left, const BitsetWord * right, const unsigned int words);
+
+/** Returns true if every bit of "subset" is also set in "superset". */
+boolean bitsetIsSubset(const BitsetWord * subset, const BitsetWord * superset, const unsigned int words);
+
+/** The amount of bits set. */
+unsigned int bitsetPopulation(const BitsetWord * set, const unsigned int words);
+
+/** The amount of bits set in (left & right), without materializing it. */
+unsigned int bitsetIntersectionPopulation(const BitsetWord * left, const BitsetWord * right, const unsigned int words);
+
+/** The highest bit set, or -1 if the set is empty. */
+int bitsetLast(const BitsetWord * set, const unsigned int words);
+
+#endif
@@ -0,0 +1,364 @@
+#include "Bounds.h"
+
+/* MODULE INTERNAL STATE */
+
+static Logger *_logger = NULL;
+
+void initializeBoundsModule()
+{
+	_logger = createLogger("Bounds");
+}
+
+void shutdownBoundsModule()
+{
+	if (_logger != NULL)
+	{
+		destroyLogger(_logger);
+	}
+}
+
+/** PRIVATE FUNCTIONS */
+
+/**
+ * The aggregates of a program, in slots of its time-grid.
+ */
+typedef struct
+{
+	const Program *program;
+	const SymbolTable *symbolTable;
+	TimeGrid grid;
+
+	// The slots that each professor can use for classes, by day: [professor *
+	// WEEK_DAY_COUNT + day].
+	unsigned int *usable;
+
+	// The length of each course (or zero, if it's not scheduled), the amount of
+	// professors that can teach it, and the last of them.
+	unsigned int *lengths;
+	unsigned int *qualifiedCount;
+	SymbolId *qualified;
+} BoundsAnalyzer;
+
+static void _countUsableSlots(BoundsAnalyzer *analyzer);
+static void _measureCourses(BoundsAnalyzer *analyzer);
+static boolean _checkCourses(const BoundsAnalyzer *analyzer);
+static boolean _checkProfessors(const BoundsAnalyzer *analyzer);
+static int _compareCapacities(const void *left, const void *right);
+static boolean _checkClassrooms(const BoundsAnalyzer *analyzer);
+
+/**
+ * Counts the available slots of every professor, by day, that belong to a
+ * stretch of at least the minimum class duration (the shorter ones can never
+ * host a class).
+ */
+static void _countUsableSlots(BoundsAnalyzer *analyzer)
+{
+	const Program *program = analyzer->program;
+	const Configuration *configuration = &program->configuration;
+	const TimeGrid *grid = &analyzer->grid;
+	const unsigned int g = grid->granularity;
+	const unsigned int minimumLength = configuration->hasClassDuration ? (60 * configuration->classDuration.minHours + g - 1) / g : 1;
+	AvailabilityTable *availability = createAvailabilityTable(program);
+	analyzer->usable = calloc(WEEK_DAY_COUNT * program->professorCount + 1, sizeof(unsigned int));
+	for (unsigned int p = 0; p < program->professorCount; ++p)
+	{
+		const BitsetWord *row = professorAvailability(availability, p);
+		for (unsigned int day = 0; program->professors[p].declared && day < WEEK_DAY_COUNT; ++day)
+		{
+			unsigned int stretch = 0;
+			for (unsigned int slot = 0; slot <= grid->slotsPerDay; ++slot)
+			{
+				if (slot < grid->slotsPerDay && bitsetTest(row, day * grid->slotsPerDay + slot))
+				{
+					++stretch;
+					continue;
+				}
+				if (minimumLength <= stretch)
+				{
+					analyzer->usable[p * WEEK_DAY_COUNT + day] += stretch;
+				}
+				stretch = 0;
+			}
+		}
+	}
+	destroyAvailabilityTable(availability);
+}
+
+/**
+ * Computes the length of the courses that the backend schedules (i.e.,
+ * declared, with hours, and with a professor), and their qualified
+ * professors.
+ */
+static void _measureCourses(BoundsAnalyzer *analyzer)
+{
+	const Program *program = analyzer->program;
+	const unsigned int g = analyzer->grid.granularity;
+	analyzer->lengths = calloc(program->courseCount + 1, sizeof(unsigned int));
+	analyzer->qualifiedCount = calloc(program->courseCount + 1, sizeof(unsigned int));
+	analyzer->qualified = calloc(program->courseCount + 1, sizeof(SymbolId));
+	for (unsigned int p = 0; p < program->professorCount; ++p)
+	{
+		const Professor *professor = &program->professors[p];
+		for (unsigned int k = 0; professor->declared && k < professor->courseCount; ++k)
+		{
+			analyzer->qualifiedCount[professor->courses[k]] += 1;
+			analyzer->qualified[professor->courses[k]] = p;
+		}
+	}
+	for (unsigned int c = 0; c < program->courseCount; ++c)
+	{
+		const Course *course = &program->courses[c];
+		if (course->declared && 0 < course->hours && 0 < analyzer->qualifiedCount[c])
+		{
+			analyzer->lengths[c] = (60 * course->hours + g - 1) / g;
+		}
+	}
+}
+
+/**
+ * Every course with hours that students require needs a professor that can
+ * teach it (the rest are only left out of the schedule). Besides,
+ * pigeonhole over the days: a course has at most "classesPerDay" classes a
+ * day, so each day gives it at most that many times the maximum class
+ * duration, and at most the usable slots of its professors.
+ */
+static boolean _checkCourses(const BoundsAnalyzer *analyzer)
+{
+	const Program *program = analyzer->program;
+	const Configuration *configuration = &program->configuration;
+	const unsigned int g = analyzer->grid.granularity;
+	unsigned int *capacities = calloc(WEEK_DAY_COUNT * program->courseCount + 1, sizeof(unsigned int));
+	for (unsigned int p = 0; p < program->professorCount; ++p)
+	{
+		const Professor *professor = &program->professors[p];
+		for (unsigned int k = 0; professor->declared && k < professor->courseCount; ++k)
+		{
+			for (unsigned int day = 0; day < WEEK_DAY_COUNT; ++day)
+			{
+				capacities[professor->courses[k] * WEEK_DAY_COUNT + day] += analyzer->usable[p * WEEK_DAY_COUNT + day];
+			}
+		}
+	}
+	boolean succeed = true;
+	for (unsigned int c = 0; c < program->courseCount; ++c)
+	{
+		const Course *course = &program->courses[c];
+		if (course->declared && 0 < course->hours && analyzer->qualifiedCount[c] == 0 && 0 < program->index.courseStudents[c])
+		{
+			logError(_logger, "The %d student(s) of \"%s\" require it, but no professor can teach it.", program->index.courseStudents[c], course->id);
+			succeed = false;
+			continue;
+		}
+		const unsigned int length = analyzer->lengths[c];
+		const unsigned int dailyLength = classesPerDay() * (configuration->hasClassDuration ? 60 * configuration->classDuration.maxHours / g : length);
+		unsigned int capacity = 0;
+		for (unsigned int day = 0; day < WEEK_DAY_COUNT; ++day)
+		{
+			const unsigned int daily = capacities[c * WEEK_DAY_COUNT + day];
+			capacity += daily < dailyLength ? daily : dailyLength;
+		}
+		if (capacity < length)
+		{
+			logError(_logger, "The course \"%s\" needs %u minute(s) of classes (at most %u a day), but its professors can only teach %u of them.",
+					 course->id, length * g, classesPerDay(), capacity * g);
+			succeed = false;
+		}
+	}
+	free(capacities);
+	return succeed;
+}
+
+/**
+ * Pigeonhole over the professors: the courses with a single professor need
+ * their hours from that professor, and every course needs its hours from the
+ * professors that teach any of them.
+ */
+static boolean _checkProfessors(const BoundsAnalyzer *analyzer)
+{
+	const Program *program = analyzer->program;
+	const unsigned int g = analyzer->grid.granularity;
+	unsigned int *exclusive = calloc(program->professorCount + 1, sizeof(unsigned int));
+	boolean *teaches = calloc(program->professorCount + 1, sizeof(boolean));
+	unsigned int demanded = 0;
+	for (unsigned int c = 0; c < program->courseCount; ++c)
+	{
+		if (analyzer->lengths[c] != 0 && analyzer->qualifiedCount[c] == 1)
+		{
+			exclusive[analyzer->qualified[c]] += analyzer->lengths[c];
+		}
+		demanded += analyzer->lengths[c];
+	}
+	boolean succeed = true;
+	unsigned int supplied = 0;
+	for (unsigned int p = 0; p < program->professorCount; ++p)
+	{
+		const Professor *professor = &program->professors[p];
+		unsigned int usable = 0;
+		for (unsigned int day = 0; day < WEEK_DAY_COUNT; ++day)
+		{
+			usable += analyzer->usable[p * WEEK_DAY_COUNT + day];
+		}
+		for (unsigned int k = 0; professor->declared && k < professor->courseCount; ++k)
+		{
+			teaches[p] = teaches[p] || analyzer->lengths[professor->courses[k]] != 0;
+		}
+		if (usable < exclusive[p])
+		{
+			logError(_logger, "The professor \"%s\" is the only one that can teach %u minute(s) of classes, but only has %u usable minute(s) available.",
+					 professor->id, exclusive[p] * g, usable * g);
+			succeed = false;
+		}
+		supplied += teaches[p] ? usable : 0;
+	}
+	if (succeed && supplied < demanded)
+	{
+		logError(_logger, "The courses need %u minute(s) of classes, but their professors only have %u usable minute(s) available.", demanded * g, supplied * g);
+		succeed = false;
+	}
+	free(exclusive);
+	free(teaches);
+	return succeed;
+}
+
+static int _compareCapacities(const void *left, const void *right)
+{
+	const int a = *(const int *)left;
+	const int b = *(const int *)right;
+	return (a < b) - (b < a);
+}
+
+/**
+ * Checks that every course has a classroom with its capacity and with each
+ * of its features (a single classroom may still lack their combination),
+ * and that the courses that only fit in the "k" largest classrooms need at
+ * most the weekly slots of "k" classrooms.
+ */
+static boolean _checkClassrooms(const BoundsAnalyzer *analyzer)
+{
+	const Program *program = analyzer->program;
+	const unsigned int g = analyzer->grid.granularity;
+	const unsigned int featureCount = symbolCount(analyzer->symbolTable, SYMBOL_FEATURE);
+	int *capacities = calloc(program->classroomCount + 1, sizeof(int));
+	int *largestWithFeature = calloc(featureCount + 1, sizeof(int));
+	unsigned int classroomCount = 0;
+	for (unsigned int f = 0; f < featureCount; ++f)
+	{
+		largestWithFeature[f] = -1;
+	}
+	for (unsigned int r = 0; r < program->classroomCount; ++r)
+	{
+		const Classroom *classroom = &program->classrooms[r];
+		if (!classroom->declared)
+		{
+			continue;
+		}
+		capacities[classroomCount++] = classroom->capacity;
+		for (unsigned int f = 0; f < featureCount; ++f)
+		{
+			if (featureMaskHas(&classroom->features, (SymbolId)f) && largestWithFeature[f] < classroom->capacity)
+			{
+				largestWithFeature[f] = classroom->capacity;
+			}
+		}
+	}
+	if (classroomCount == 0)
+	{
+		free(capacities);
+		free(largestWithFeature);
+		return true;
+	}
+	qsort(capacities, classroomCount, sizeof(int), _compareCapacities);
+
+	// The slots needed by the courses that fit in exactly the "k" largest
+	// classrooms (by capacity).
+	unsigned int *needed = calloc(classroomCount + 1, sizeof(unsigned int));
+	boolean succeed = true;
+	for (unsigned int c = 0; c < program->courseCount; ++c)
+	{
+		const Course *course = &program->courses[c];
+		const int demand = program->index.courseStudents[c];
+		if (analyzer->lengths[c] == 0)
+		{
+			continue;
+		}
+		for (unsigned int f = 0; f < featureCount; ++f)
+		{
+			if (!featureMaskHas(&course->requires, (SymbolId)f))
+			{
+				continue;
+			}
+			const char *feature = getSymbol(analyzer->symbolTable, SYMBOL_FEATURE, f)->name;
+			if (largestWithFeature[f] == -1)
+			{
+				logError(_logger, "No classroom has the feature %s that \"%s\" requires.", feature, course->id);
+				succeed = false;
+			}
+			else if (largestWithFeature[f] < demand)
+			{
+				logError(_logger, "No classroom with the feature %s hosts the %d student(s) of \"%s\" (the largest has %d seat(s)).",
+						 feature, demand, course->id, largestWithFeature[f]);
+				succeed = false;
+			}
+		}
+		unsigned int low = 0;
+		unsigned int high = classroomCount;
+		while (low < high)
+		{
+			const unsigned int middle = (low + high) / 2;
+			if (demand <= capacities[middle])
+			{
+				low = middle + 1;
+			}
+			else
+			{
+				high = middle;
+			}
+		}
+		if (low == 0)
+		{
+			logError(_logger, "No classroom hosts the %d student(s) of \"%s\" (the largest has %d seat(s)).", demand, course->id, capacities[0]);
+			succeed = false;
+			continue;
+		}
+		needed[low] += analyzer->lengths[c];
+	}
+	unsigned long long cumulative = 0;
+	for (unsigned int k = 1; succeed && k <= classroomCount; ++k)
+	{
+		cumulative += needed[k];
+		const unsigned long long available = (unsigned long long)k * analyzer->grid.slotCount;
+		if (available < cumulative)
+		{
+			logError(_logger, "The courses that only fit in the %u largest classroom(s) need %llu minute(s) of classes, but those classrooms are open for %llu minute(s) a week.",
+					 k, cumulative * g, available * g);
+			succeed = false;
+		}
+	}
+	free(capacities);
+	free(largestWithFeature);
+	free(needed);
+	return succeed;
+}
+
+/** PUBLIC FUNCTIONS */
+
+BoundsAnalysisStatus analyzeBounds(CompilerState *compilerState)
+{
+	logDebugging(_logger, "Analyzing bounds...");
+	BoundsAnalyzer analyzer;
+	memset(&analyzer, 0, sizeof(BoundsAnalyzer));
+	analyzer.program = compilerState->abstractSyntaxtTree;
+	analyzer.symbolTable = compilerState->symbolTable;
+	analyzer.grid = createTimeGrid(&analyzer.program->configuration);
+	_countUsableSlots(&analyzer);
+	_measureCourses(&analyzer);
+	boolean succeed = _checkCourses(&analyzer);
+	succeed = _checkProfessors(&analyzer) && succeed;
+	succeed = _checkClassrooms(&analyzer) && succeed;
+	free(analyzer.usable);
+	free(analyzer.lengths);
+	free(analyzer.qualifiedCount);
+	free(analyzer.qualified);
+	logDebugging(_logger, "Bounds analysis is done.");
+	return succeed ? BOUNDS_ACCEPT : BOUNDS_REJECT;
+}
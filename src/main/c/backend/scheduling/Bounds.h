@@ -0,0 +1,43 @@
+#ifndef BOUNDS_HEADER
+#define BOUNDS_HEADER
+
+#include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
+#include "../../shared/CompilerState.h"
+#include "../../shared/Logger.h"
+#include "../../shared/SymbolTable.h"
+#include "../../shared/Type.h"
+#include "Availability.h"
+#include "Partition.h"
+
+/** Initialize module's internal state. */
+void initializeBoundsModule();
+
+/** Shutdown module's internal state. */
+void shutdownBoundsModule();
+
+typedef enum {
+	BOUNDS_ACCEPT,
+	BOUNDS_REJECT
+} BoundsAnalysisStatus;
+
+/**
+ * Rejects the programs that obviously cannot be scheduled, by counting
+ * (without any search), in time linear in the size of the program and its
+ * time-grid:
+ *
+ * - Every course needs its hours from the usable time of its professors (the
+ *   available stretches long enough for a class), with at most
+ *   "classesPerDay" classes a day, each within the class duration.
+ * - Every professor needs the hours of the courses that only it can teach,
+ *   and all the professors need the hours of every course.
+ * - Every course needs a classroom with its capacity and with each of its
+ *   features, and the courses that only fit in the largest classrooms need
+ *   their hours from those classrooms (i.e., Hall's condition over the nested
+ *   sets of classrooms, by capacity).
+ *
+ * These are necessary conditions only: an accepted program may still have no
+ * schedule. Returns BOUNDS_REJECT after logging every violated bound.
+ */
+BoundsAnalysisStatus analyzeBounds(CompilerState * compilerState);
+
+#endif
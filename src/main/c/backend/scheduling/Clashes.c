@@ -0,0 +1,333 @@
+#include "Clashes.h"
+
+/* MODULE INTERNAL STATE */
+
+static Logger *_logger = NULL;
+
+void initializeClashesModule()
+{
+	_logger = createLogger("Clashes");
+}
+
+void shutdownClashesModule()
+{
+	if (_logger != NULL)
+	{
+		destroyLogger(_logger);
+	}
+}
+
+/** PRIVATE FUNCTIONS */
+
+/**
+ * An interval of a resource in a day, in minutes since midnight: the time of
+ * a hard preference (or -1 for an available window of a professor).
+ */
+typedef struct
+{
+	ResourceType type;
+	SymbolId resource;
+	unsigned int day;
+	int start;
+	int end;
+	int preference;
+} TimedInterval;
+
+/**
+ * The intervals of a program (in any order, until they are sorted).
+ */
+typedef struct
+{
+	const Program *program;
+	TimedInterval *intervals;
+	unsigned int count;
+	unsigned int capacity;
+} ClashAnalyzer;
+
+static void _append(ClashAnalyzer *analyzer, const ResourceType type, const SymbolId resource, const unsigned int day, const int start, const int end, const int preference);
+static int _compareIntervals(const void *left, const void *right);
+static void _describe(const Program *program, const int preference, char *buffer, const size_t size);
+static const char *_resourceName(const Program *program, const TimedInterval *interval);
+static boolean _collectPreferences(ClashAnalyzer *analyzer);
+static boolean _checkOverlaps(const ClashAnalyzer *analyzer);
+static boolean _checkAvailability(const ClashAnalyzer *analyzer);
+
+static void _append(ClashAnalyzer *analyzer, const ResourceType type, const SymbolId resource, const unsigned int day, const int start, const int end, const int preference)
+{
+	if (analyzer->count == analyzer->capacity)
+	{
+		analyzer->capacity = analyzer->capacity < 64 ? 64 : 2 * analyzer->capacity;
+		analyzer->intervals = realloc(analyzer->intervals, analyzer->capacity * sizeof(TimedInterval));
+	}
+	TimedInterval *interval = &analyzer->intervals[analyzer->count++];
+	interval->type = type;
+	interval->resource = resource;
+	interval->day = day;
+	interval->start = start;
+	interval->end = end;
+	interval->preference = preference;
+}
+
+/**
+ * By resource, day and start (the available windows first), and then by
+ * order of declaration.
+ */
+static int _compareIntervals(const void *left, const void *right)
+{
+	const TimedInterval *a = left;
+	const TimedInterval *b = right;
+	if (a->type != b->type)
+	{
+		return a->type < b->type ? -1 : 1;
+	}
+	if (a->resource != b->resource)
+	{
+		return a->resource < b->resource ? -1 : 1;
+	}
+	if (a->day != b->day)
+	{
+		return a->day < b->day ? -1 : 1;
+	}
+	if (a->start != b->start)
+	{
+		return a->start < b->start ? -1 : 1;
+	}
+	return (a->preference > b->preference) - (a->preference < b->preference);
+}
+
+/**
+ * Writes a hard preference as "Ana teaches ATLyC from 16:00 to 19:00 on
+ * WEDNESDAY".
+ */
+static void _describe(const Program *program, const int preference, char *buffer, const size_t size)
+{
+	const PreferenceDetails *details = &program->preferences[preference].details;
+	snprintf(buffer, size, "\"%s\" teaches \"%s\" from %02d:%02d to %02d:%02d on %s",
+			 program->professors[details->professor].id, program->courses[details->course].id,
+			 details->startTime.hour, details->startTime.minute, details->endTime.hour, details->endTime.minute,
+			 details->hasDay && details->day != DAY_EVERYDAY ? dayOfWeekToString(details->day) : "any day");
+}
+
+static const char *_resourceName(const Program *program, const TimedInterval *interval)
+{
+	switch (interval->type)
+	{
+		case RESOURCE_PROFESSOR:
+			return program->professors[interval->resource].id;
+		case RESOURCE_CLASSROOM:
+			return program->classrooms[interval->resource].id;
+		default:
+			return program->courses[interval->resource].id;
+	}
+}
+
+/**
+ * Collects the intervals of the hard preferences with time and day (for their
+ * professor, classroom and course), and checks the opening hours of every
+ * hard preference with time. The preferences of undeclared entities are
+ * ignored.
+ */
+static boolean _collectPreferences(ClashAnalyzer *analyzer)
+{
+	const Program *program = analyzer->program;
+	const UniversityOpen *open = &program->configuration.universityOpen;
+	boolean succeed = true;
+	char description[256];
+	for (unsigned int k = 0; k < program->preferenceCount; ++k)
+	{
+		const Preference *preference = &program->preferences[k];
+		const PreferenceDetails *details = &preference->details;
+		if (preference->type != HARD_PREFERENCE || !details->hasTime
+			|| details->professor == UNDEFINED_SYMBOL || !program->professors[details->professor].declared
+			|| details->course == UNDEFINED_SYMBOL || !program->courses[details->course].declared)
+		{
+			continue;
+		}
+		const int start = timeToMinutes(details->startTime);
+		const int end = timeToMinutes(details->endTime);
+		if (start < timeToMinutes(open->openFrom) || timeToMinutes(open->openTo) < end || end <= start)
+		{
+			_describe(program, (int)k, description, sizeof(description));
+			logError(_logger, "The hard preference %s is outside of the opening hours.", description);
+			succeed = false;
+			continue;
+		}
+		if (!details->hasDay || details->day == DAY_EVERYDAY)
+		{
+			continue;
+		}
+		_append(analyzer, RESOURCE_PROFESSOR, details->professor, details->day, start, end, (int)k);
+		_append(analyzer, RESOURCE_COURSE, details->course, details->day, start, end, (int)k);
+		if (details->classroom != UNDEFINED_SYMBOL && program->classrooms[details->classroom].declared)
+		{
+			_append(analyzer, RESOURCE_CLASSROOM, details->classroom, details->day, start, end, (int)k);
+		}
+	}
+	return succeed;
+}
+
+/**
+ * Sweeps the preferences of each resource and day by start: a preference
+ * overlaps the one with the latest end so far, if it starts before that end.
+ */
+static boolean _checkOverlaps(const ClashAnalyzer *analyzer)
+{
+	const Program *program = analyzer->program;
+	boolean succeed = true;
+	char first[256];
+	char second[256];
+	const TimedInterval *latest = NULL;
+	unsigned int daily = 0;
+	for (unsigned int k = 0; k < analyzer->count; ++k)
+	{
+		const TimedInterval *interval = &analyzer->intervals[k];
+		if (interval->preference < 0)
+		{
+			continue;
+		}
+		if (latest == NULL || latest->type != interval->type || latest->resource != interval->resource || latest->day != interval->day)
+		{
+			latest = interval;
+			daily = 1;
+			continue;
+		}
+		daily += 1;
+		if (interval->type == RESOURCE_COURSE && daily == classesPerDay() + 1)
+		{
+			logError(_logger, "The course \"%s\" has more than %u class(es) on %s by its hard preferences.",
+					 program->courses[interval->resource].id, classesPerDay(), dayOfWeekToString((DayOfWeek)interval->day));
+			succeed = false;
+		}
+		if (interval->start < latest->end)
+		{
+			_describe(program, latest->preference, first, sizeof(first));
+			_describe(program, interval->preference, second, sizeof(second));
+			logError(_logger, "The hard preferences %s and %s overlap in the %s \"%s\".", first, second,
+					 interval->type == RESOURCE_PROFESSOR ? "professor" : (interval->type == RESOURCE_CLASSROOM ? "classroom" : "course"),
+					 _resourceName(program, interval));
+			succeed = false;
+		}
+		latest = latest->end < interval->end ? interval : latest;
+	}
+	return succeed;
+}
+
+/**
+ * Merges the available windows of each professor and day that overlap (or
+ * touch), and then sweeps its preferences by start: each one must fit in the
+ * merged window where it starts.
+ */
+static boolean _checkAvailability(const ClashAnalyzer *analyzer)
+{
+	const Program *program = analyzer->program;
+	boolean succeed = true;
+	char description[256];
+
+	// The merged windows of the current professor and day.
+	int *starts = calloc(1 + analyzer->count, sizeof(int));
+	int *ends = calloc(1 + analyzer->count, sizeof(int));
+	unsigned int first = 0;
+	while (first < analyzer->count && analyzer->intervals[first].type == RESOURCE_PROFESSOR)
+	{
+		const TimedInterval *group = &analyzer->intervals[first];
+		unsigned int last = first;
+		unsigned int windows = 0;
+		for (; last < analyzer->count; ++last)
+		{
+			const TimedInterval *interval = &analyzer->intervals[last];
+			if (interval->type != group->type || interval->resource != group->resource || interval->day != group->day)
+			{
+				break;
+			}
+			if (0 <= interval->preference)
+			{
+				continue;
+			}
+			if (0 < windows && interval->start <= ends[windows - 1])
+			{
+				ends[windows - 1] = ends[windows - 1] < interval->end ? interval->end : ends[windows - 1];
+			}
+			else
+			{
+				starts[windows] = interval->start;
+				ends[windows] = interval->end;
+				windows += 1;
+			}
+		}
+
+		// The professors without windows are always available.
+		const boolean constrained = program->professors[group->resource].availabilityCount != 0;
+		unsigned int window = 0;
+		for (unsigned int k = first; constrained && k < last; ++k)
+		{
+			const TimedInterval *interval = &analyzer->intervals[k];
+			if (interval->preference < 0)
+			{
+				continue;
+			}
+			while (window < windows && ends[window] <= interval->start)
+			{
+				++window;
+			}
+			if (window == windows || interval->start < starts[window] || ends[window] < interval->end)
+			{
+				_describe(program, interval->preference, description, sizeof(description));
+				logError(_logger, "The hard preference %s is outside of the availability of \"%s\".", description, program->professors[interval->resource].id);
+				succeed = false;
+			}
+		}
+		first = last;
+	}
+	free(starts);
+	free(ends);
+	return succeed;
+}
+
+/** PUBLIC FUNCTIONS */
+
+ClashAnalysisStatus analyzeClashes(CompilerState *compilerState)
+{
+	logDebugging(_logger, "Analyzing clashes...");
+	ClashAnalyzer analyzer;
+	memset(&analyzer, 0, sizeof(ClashAnalyzer));
+	analyzer.program = compilerState->abstractSyntaxtTree;
+	const Program *program = analyzer.program;
+	boolean succeed = _collectPreferences(&analyzer);
+
+	// The available windows of the professors with a timed preference.
+	const unsigned int preferenceIntervals = analyzer.count;
+	boolean *timed = calloc(1 + program->professorCount, sizeof(boolean));
+	for (unsigned int k = 0; k < preferenceIntervals; ++k)
+	{
+		if (analyzer.intervals[k].type == RESOURCE_PROFESSOR)
+		{
+			timed[analyzer.intervals[k].resource] = true;
+		}
+	}
+	for (unsigned int p = 0; p < program->professorCount; ++p)
+	{
+		const Professor *professor = &program->professors[p];
+		for (unsigned int a = 0; timed[p] && a < professor->availabilityCount; ++a)
+		{
+			const IntervalDayOfWeek *window = &professor->availability[a];
+			for (unsigned int day = 0; day < WEEK_DAY_COUNT; ++day)
+			{
+				if (window->dayOfWeek == DAY_EVERYDAY || window->dayOfWeek == (DayOfWeek)day)
+				{
+					_append(&analyzer, RESOURCE_PROFESSOR, p, day, timeToMinutes(window->start), timeToMinutes(window->end), -1);
+				}
+			}
+		}
+	}
+	free(timed);
+
+	if (0 < analyzer.count)
+	{
+		qsort(analyzer.intervals, analyzer.count, sizeof(TimedInterval), _compareIntervals);
+	}
+	succeed = _checkOverlaps(&analyzer) && succeed;
+	succeed = _checkAvailability(&analyzer) && succeed;
+	free(analyzer.intervals);
+	logDebugging(_logger, "Clash analysis is done.");
+	return succeed ? CLASHES_ACCEPT : CLASHES_REJECT;
+}
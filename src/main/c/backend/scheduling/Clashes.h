@@ -0,0 +1,44 @@
+#ifndef CLASHES_HEADER
+#define CLASHES_HEADER
+
+#include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
+#include "../../shared/CompilerState.h"
+#include "../../shared/Logger.h"
+#include "../../shared/Type.h"
+#include "Availability.h"
+#include "Partition.h"
+#include "Schedule.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Initialize module's internal state. */
+void initializeClashesModule();
+
+/** Shutdown module's internal state. */
+void shutdownClashesModule();
+
+typedef enum {
+	CLASHES_ACCEPT,
+	CLASHES_REJECT
+} ClashAnalysisStatus;
+
+/**
+ * Rejects the hard preferences with time that contradict each other or the
+ * configuration, before any scheduling:
+ *
+ * - A hard preference must be inside of the opening hours.
+ * - A hard preference with a day must be inside of a single available window
+ *   of its professor (after merging the overlapping and adjacent windows).
+ * - Two hard preferences with the same day cannot overlap if they share the
+ *   professor, the classroom or the course, and a course cannot have more
+ *   than "classesPerDay" of them in the same day.
+ *
+ * The intervals are sorted by resource, day and start, and then swept once,
+ * so it runs in O(n log n) for n intervals. Every overlapping preference is
+ * reported (against the one that ends last before it). Returns CLASHES_REJECT
+ * after logging every clash.
+ */
+ClashAnalysisStatus analyzeClashes(CompilerState * compilerState);
+
+#endif
@@ -0,0 +1,68 @@
+#include "Deadline.h"
+
+/* MODULE INTERNAL STATE */
+
+static Logger *_logger = NULL;
+static double _start = 0;
+static double _limit = 0;
+static double _improvementLimit = 0;
+
+/** PRIVATE FUNCTIONS */
+
+static double _now();
+
+/**
+ * The current time of a monotonic clock, in seconds.
+ */
+static double _now()
+{
+#if defined(WINDOWS_THREADS)
+	return GetTickCount64() / 1000.0;
+#else
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+#endif
+}
+
+/** PUBLIC FUNCTIONS */
+
+void initializeDeadlineModule()
+{
+	_logger = createLogger("Deadline");
+	_start = _now();
+	const int limit = getIntegerOrDefault("SOLVER_TIME_LIMIT", 0);
+	if (limit < 0)
+	{
+		logWarning(_logger, "Invalid time limit: %d second(s) (using no limit instead).", limit);
+	}
+	_limit = limit < 0 ? 0 : limit;
+}
+
+void shutdownDeadlineModule()
+{
+	if (_logger != NULL)
+	{
+		destroyLogger(_logger);
+	}
+}
+
+double elapsedSeconds()
+{
+	return _now() - _start;
+}
+
+boolean isDeadlineExpired()
+{
+	return 0 < _limit && _limit <= elapsedSeconds();
+}
+
+void limitImprovement(const unsigned int seconds)
+{
+	_improvementLimit = seconds == 0 ? 0 : elapsedSeconds() + seconds;
+}
+
+boolean isImprovementExpired()
+{
+	return isDeadlineExpired() || (0 < _improvementLimit && _improvementLimit <= elapsedSeconds());
+}
@@ -0,0 +1,50 @@
+#ifndef DEADLINE_HEADER
+#define DEADLINE_HEADER
+
+#include "../../shared/Environment.h"
+#include "../../shared/Logger.h"
+#include "../../shared/Thread.h"
+#include "../../shared/Type.h"
+#include <time.h>
+
+/** Initialize module's internal state. */
+void initializeDeadlineModule();
+
+/** Shutdown module's internal state. */
+void shutdownDeadlineModule();
+
+/**
+ * The nodes of a search between two polls of the time limit.
+ */
+#define DEADLINE_POLL_NODES 1024
+
+/**
+ * The seconds since the module was initialized (i.e., since the compiler
+ * started), with a monotonic clock.
+ */
+double elapsedSeconds();
+
+/**
+ * Returns true if the time limit of the solver expired (see
+ * "SOLVER_TIME_LIMIT"). Without limit, it's always false. Every search polls
+ * it periodically: the ones that improve a schedule stop with the best
+ * schedule found so far, and the ones that look for a first schedule stop
+ * with SOLVER_TIMEOUT.
+ */
+boolean isDeadlineExpired();
+
+/**
+ * Bounds the searches that improve a schedule to some seconds from now (or
+ * lifts the bound, with 0), besides the time limit of the solver.
+ */
+void limitImprovement(const unsigned int seconds);
+
+/**
+ * Returns true if the time limit of the solver expired, or the bound of the
+ * searches that improve a schedule (see "limitImprovement"). The optimizer
+ * and the local search poll it instead of "isDeadlineExpired", so they stop
+ * with the best schedule found so far.
+ */
+boolean isImprovementExpired();
+
+#endif
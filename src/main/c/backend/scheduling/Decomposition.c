@@ -0,0 +1,372 @@
+#include "Decomposition.h"
+
+/* MODULE INTERNAL STATE */
+
+static Logger *_logger = NULL;
+
+void initializeDecompositionModule()
+{
+	_logger = createLogger("Decomposition");
+}
+
+void shutdownDecompositionModule()
+{
+	if (_logger != NULL)
+	{
+		destroyLogger(_logger);
+	}
+}
+
+/** PRIVATE FUNCTIONS */
+
+typedef struct ComponentPool ComponentPool;
+
+/**
+ * An independent part of a model: its sessions (as ascending indexes of the
+ * whole model), its own model, and its result. Its listener forwards its
+ * schedules to the pool (with the score of the last one).
+ */
+typedef struct
+{
+	unsigned int *sessions;
+	unsigned int sessionCount;
+	Model *model;
+	Optimization *optimization;
+	ComponentPool *pool;
+	ScheduleListener listener;
+	int score;
+	boolean reported;
+} Component;
+
+/**
+ * The components to solve, shared by every thread of the pool. A thread
+ * takes the next unsolved component, until there are none, or until any
+ * component has no schedule (so the whole model has none either).
+ *
+ * Once every component has a schedule, each better schedule of a component
+ * is merged with the last ones of the others, and the listener of the whole
+ * model receives it.
+ */
+struct ComponentPool
+{
+	Component *components;
+	unsigned int componentCount;
+	ComponentSolver solver;
+	void *argument;
+
+	// The threads of the solver of each component.
+	unsigned int threadCount;
+	Atomic next;
+	Atomic failed;
+
+	const Model *model;
+	const ScheduleListener *listener;
+	Mutex listenerMutex;
+	Assignment *merged;
+	unsigned int reportedCount;
+};
+
+static unsigned int _find(unsigned int *parents, unsigned int session);
+static void _join(unsigned int *parents, int *representative, const unsigned int session);
+static unsigned int _splitComponents(const Model *model, Component **components);
+static int _compareComponents(const void *left, const void *right);
+static void _translate(const Model *model, const Component *component, const Assignment *assignments, Assignment *merged);
+static void _forward(const Model *model, const Assignment *assignments, const int score, void *argument);
+static void _work(void *argument);
+static Optimization *_merge(const Model *model, const Component *components, const unsigned int componentCount);
+
+/**
+ * The root of the set of a session (halving the path on the way).
+ */
+static unsigned int _find(unsigned int *parents, unsigned int session)
+{
+	while (parents[session] != session)
+	{
+		parents[session] = parents[parents[session]];
+		session = parents[session];
+	}
+	return session;
+}
+
+/**
+ * Joins a session with the first session of a resource (i.e., a course, a
+ * professor or a classroom), or makes it the first one.
+ */
+static void _join(unsigned int *parents, int *representative, const unsigned int session)
+{
+	if (*representative == -1)
+	{
+		*representative = (int)session;
+		return;
+	}
+	const unsigned int left = _find(parents, session);
+	const unsigned int right = _find(parents, (unsigned int)*representative);
+	if (left != right)
+	{
+		parents[left < right ? right : left] = left < right ? left : right;
+	}
+}
+
+/**
+ * Builds the connected components of the sessions of a model, with their
+ * sessions in ascending order. Returns the amount of components.
+ */
+static unsigned int _splitComponents(const Model *model, Component **components)
+{
+	unsigned int *parents = calloc(1 + model->sessionCount, sizeof(unsigned int));
+	int *courses = calloc(1 + model->courseCount, sizeof(int));
+	int *professors = calloc(1 + model->professorCount, sizeof(int));
+	int *classrooms = calloc(1 + model->classroomCount, sizeof(int));
+	memset(courses, -1, (1 + model->courseCount) * sizeof(int));
+	memset(professors, -1, (1 + model->professorCount) * sizeof(int));
+	memset(classrooms, -1, (1 + model->classroomCount) * sizeof(int));
+	for (unsigned int s = 0; s < model->sessionCount; ++s)
+	{
+		const Session *session = &model->sessions[s];
+		parents[s] = s;
+		_join(parents, &courses[session->course], s);
+		for (unsigned int p = session->firstPlacement; p < session->firstPlacement + session->placementCount; ++p)
+		{
+			_join(parents, &professors[model->placements[p].professor], s);
+		}
+		for (unsigned int r = session->firstRoom; model->usesClassrooms && r < session->firstRoom + session->roomCount; ++r)
+		{
+			_join(parents, &classrooms[model->rooms[r]], s);
+		}
+	}
+
+	// The roots are always the smallest session of their sets, so the
+	// components are numbered in order of their first session.
+	unsigned int *componentOf = calloc(1 + model->sessionCount, sizeof(unsigned int));
+	unsigned int componentCount = 0;
+	for (unsigned int s = 0; s < model->sessionCount; ++s)
+	{
+		const unsigned int root = _find(parents, s);
+		componentOf[s] = root == s ? componentCount++ : componentOf[root];
+	}
+	*components = calloc(1 + componentCount, sizeof(Component));
+	for (unsigned int s = 0; s < model->sessionCount; ++s)
+	{
+		(*components)[componentOf[s]].sessionCount += 1;
+	}
+	for (unsigned int k = 0; k < componentCount; ++k)
+	{
+		(*components)[k].sessions = calloc((*components)[k].sessionCount, sizeof(unsigned int));
+		(*components)[k].sessionCount = 0;
+	}
+	for (unsigned int s = 0; s < model->sessionCount; ++s)
+	{
+		Component *component = &(*components)[componentOf[s]];
+		component->sessions[component->sessionCount++] = s;
+	}
+	free(parents);
+	free(courses);
+	free(professors);
+	free(classrooms);
+	free(componentOf);
+	return componentCount;
+}
+
+/**
+ * Sorts the components by descending size, so the largest ones start first
+ * (and by first session, so the order is deterministic).
+ */
+static int _compareComponents(const void *left, const void *right)
+{
+	const Component *a = left;
+	const Component *b = right;
+	if (a->sessionCount != b->sessionCount)
+	{
+		return a->sessionCount < b->sessionCount ? 1 : -1;
+	}
+	return a->sessions[0] < b->sessions[0] ? -1 : 1;
+}
+
+/**
+ * Writes the assignments of a component to the sessions of the whole model,
+ * translating their placements.
+ */
+static void _translate(const Model *model, const Component *component, const Assignment *assignments, Assignment *merged)
+{
+	for (unsigned int s = 0; s < component->sessionCount; ++s)
+	{
+		const unsigned int session = component->sessions[s];
+		merged[session].placement = assignments[s].placement < 0
+			? -1
+			: (int)(model->sessions[session].firstPlacement + (assignments[s].placement - component->model->sessions[s].firstPlacement));
+		merged[session].classroom = assignments[s].classroom;
+	}
+}
+
+/**
+ * The listener of a component: it merges its new schedule, and forwards the
+ * whole one if every component already has a schedule.
+ */
+static void _forward(const Model *model, const Assignment *assignments, const int score, void *argument)
+{
+	// The model of the component; the pool has the whole one.
+	(void)model;
+	Component *component = argument;
+	ComponentPool *pool = component->pool;
+	lockMutex(&pool->listenerMutex);
+	_translate(pool->model, component, assignments, pool->merged);
+	component->score = score;
+	if (!component->reported)
+	{
+		component->reported = true;
+		pool->reportedCount += 1;
+	}
+	if (pool->reportedCount == pool->componentCount)
+	{
+		int total = 0;
+		for (unsigned int k = 0; k < pool->componentCount; ++k)
+		{
+			total += pool->components[k].score;
+		}
+		notifySchedule(pool->listener, pool->model, pool->merged, total);
+	}
+	unlockMutex(&pool->listenerMutex);
+}
+
+/**
+ * Solves components of the pool, until there are none left. A component that
+ * starts after the time limit expired has no schedule.
+ */
+static void _work(void *argument)
+{
+	ComponentPool *pool = argument;
+	while (true)
+	{
+		const long k = atomicAdd(&pool->next, 1) - 1;
+		if (pool->componentCount <= (unsigned long)k || atomicLoad(&pool->failed) != 0)
+		{
+			return;
+		}
+		Component *component = &pool->components[k];
+		if (isDeadlineExpired())
+		{
+			// The time limit expired before the component had a schedule.
+			component->optimization = calloc(1, sizeof(Optimization));
+			component->optimization->status = SOLVER_TIMEOUT;
+		}
+		else
+		{
+			component->optimization = pool->solver(component->model, pool->threadCount, pool->listener == NULL ? NULL : &component->listener, pool->argument);
+		}
+		if (component->optimization->status != SOLVER_SATISFIABLE)
+		{
+			atomicStore(&pool->failed, 1);
+		}
+	}
+}
+
+/**
+ * Merges the results of every component, translating their placements back
+ * to the placements of the whole model.
+ */
+static Optimization *_merge(const Model *model, const Component *components, const unsigned int componentCount)
+{
+	Optimization *optimization = calloc(1, sizeof(Optimization));
+	optimization->status = SOLVER_SATISFIABLE;
+	optimization->preferenceCount = model->softPreferenceCount;
+	optimization->maximumScore = model->maximumScore;
+	optimization->optimal = true;
+	for (unsigned int k = 0; k < componentCount; ++k)
+	{
+		const Optimization *part = components[k].optimization;
+		if (part != NULL && optimization->status == SOLVER_SATISFIABLE)
+		{
+			optimization->status = part->status;
+		}
+		if (part != NULL)
+		{
+			optimization->satisfied += part->satisfied;
+			optimization->score += part->score;
+			optimization->optimal = optimization->optimal && part->optimal;
+			optimization->nodes += part->nodes;
+		}
+	}
+	if (optimization->status != SOLVER_SATISFIABLE)
+	{
+		return optimization;
+	}
+	optimization->assignments = calloc(1 + model->sessionCount, sizeof(Assignment));
+	for (unsigned int k = 0; k < componentCount; ++k)
+	{
+		_translate(model, &components[k], components[k].optimization->assignments, optimization->assignments);
+	}
+	return optimization;
+}
+
+/** PUBLIC FUNCTIONS */
+
+Optimization *solveComponents(const Model *model, ComponentSolver solver, const ScheduleListener *listener, void *argument)
+{
+	Component *components = NULL;
+	const unsigned int componentCount = _splitComponents(model, &components);
+	if (componentCount <= 1)
+	{
+		for (unsigned int k = 0; k < componentCount; ++k)
+		{
+			free(components[k].sessions);
+		}
+		free(components);
+		return solver(model, solverThreads(), listener, argument);
+	}
+	qsort(components, componentCount, sizeof(Component), _compareComponents);
+	for (unsigned int k = 0; k < componentCount; ++k)
+	{
+		components[k].model = extractModel(model, components[k].sessions, components[k].sessionCount);
+	}
+	logDebugging(_logger, "The model splits in %u independent component(s) (the largest has %u of %u session(s)).",
+				 componentCount, components[0].sessionCount, model->sessionCount);
+
+	// The current thread is also a worker of the pool, so the components are
+	// solved even if no thread can be started. Every worker gets an equal
+	// share of the threads for its components.
+	const unsigned int threads = solverThreads();
+	const unsigned int workerCount = threads < componentCount ? threads : componentCount;
+	ComponentPool pool = {
+		.components = components,
+		.componentCount = componentCount,
+		.solver = solver,
+		.argument = argument,
+		.threadCount = threads / workerCount,
+		.next = 0,
+		.failed = 0,
+		.model = model,
+		.listener = listener,
+		.merged = calloc(1 + model->sessionCount, sizeof(Assignment)),
+		.reportedCount = 0};
+	createMutex(&pool.listenerMutex);
+	for (unsigned int k = 0; k < componentCount; ++k)
+	{
+		components[k].pool = &pool;
+		components[k].listener.function = _forward;
+		components[k].listener.argument = &components[k];
+	}
+	Thread *workers = calloc(workerCount, sizeof(Thread));
+	unsigned int startedCount = 0;
+	while (startedCount + 1 < workerCount && createThread(&workers[startedCount], _work, &pool))
+	{
+		++startedCount;
+	}
+	_work(&pool);
+	for (unsigned int k = 0; k < startedCount; ++k)
+	{
+		joinThread(&workers[k]);
+	}
+
+	Optimization *optimization = _merge(model, components, componentCount);
+	destroyMutex(&pool.listenerMutex);
+	free(pool.merged);
+	for (unsigned int k = 0; k < componentCount; ++k)
+	{
+		destroyOptimization(components[k].optimization);
+		destroyModel(components[k].model);
+		free(components[k].sessions);
+	}
+	free(components);
+	free(workers);
+	return optimization;
+}
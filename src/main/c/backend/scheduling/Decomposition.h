@@ -0,0 +1,46 @@
+#ifndef DECOMPOSITION_HEADER
+#define DECOMPOSITION_HEADER
+
+#include "../../shared/Environment.h"
+#include "../../shared/Logger.h"
+#include "../../shared/Thread.h"
+#include "../../shared/Type.h"
+#include "Model.h"
+#include "Optimizer.h"
+#include "Solver.h"
+
+/** Initialize module's internal state. */
+void initializeDecompositionModule();
+
+/** Shutdown module's internal state. */
+void shutdownDecompositionModule();
+
+/**
+ * Solves a model and returns its best schedule (e.g., with the optimizer, or
+ * with the portfolio), notifying the listener (if it's not NULL) of every
+ * better schedule, with at most "threadCount" threads of its own. The
+ * argument is the one passed to "solveComponents".
+ */
+typedef Optimization * (* ComponentSolver)(const Model * model, const unsigned int threadCount, const ScheduleListener * listener, void * argument);
+
+/**
+ * Splits the sessions of a model in connected components, where two sessions
+ * are connected if they belong to the same course, or share a professor or a
+ * classroom in their domains (i.e., with union-find), so no constraint nor
+ * soft preference relates different components.
+ *
+ * Every component is solved independently with the solver, in a pool of
+ * threads (see "solverThreads") that takes the largest components first,
+ * and the results are merged in a single optimization of the whole model: it
+ * is satisfiable if every component is, and optimal if every component is.
+ * The threads are split between the workers of the pool, so each component
+ * solver gets an equal share (at least one), and the engines never start more
+ * threads than the budget. A model with a single component is solved
+ * directly, with every thread.
+ *
+ * The listener (if it's not NULL) receives the schedules of the whole model:
+ * once every component has one, every better schedule of any component.
+ */
+Optimization * solveComponents(const Model * model, ComponentSolver solver, const ScheduleListener * listener, void * argument);
+
+#endif
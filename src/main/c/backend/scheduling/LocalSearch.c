@@ -0,0 +1,465 @@
+#include "LocalSearch.h"
+
+/* MODULE INTERNAL STATE */
+
+static Logger *_logger = NULL;
+static unsigned long long _moves = 1000000;
+static unsigned long long _seed = 1;
+
+void initializeLocalSearchModule()
+{
+	_logger = createLogger("LocalSearch");
+	const int moves = getIntegerOrDefault("LOCAL_SEARCH_MOVES", (int)_moves);
+	if (moves < 0)
+	{
+		logWarning(_logger, "Invalid amount of moves: %d (using %llu instead).", moves, _moves);
+	}
+	_moves = moves < 0 ? _moves : (unsigned long long)moves;
+	_seed = (unsigned long long)getIntegerOrDefault("SOLVER_SEED", (int)_seed);
+}
+
+void shutdownLocalSearchModule()
+{
+	if (_logger != NULL)
+	{
+		destroyLogger(_logger);
+	}
+}
+
+/** PRIVATE FUNCTIONS */
+
+// The iterations that a moved session stays tabu.
+#define TABU_TENURE 16
+
+// The temperature of the annealing at the last move.
+#define FINAL_TEMPERATURE 0.05
+
+// The moves between two polls of the time limit.
+#define DEADLINE_POLL_MOVES 4096
+
+/**
+ * The current schedule of the search, and the incremental state of its
+ * score.
+ */
+typedef struct
+{
+	const Model *model;
+	Assignment *assignments;
+
+	// The occupied slots of each professor, classroom and course (bitset
+	// rows), and the amount of sessions of each course in each day.
+	BitsetWord *professorBusy;
+	BitsetWord *classroomBusy;
+	BitsetWord *courseBusy;
+	unsigned char *courseDayLoad;
+
+	// The sessions that satisfy each soft preference of the model, and the
+	// score of the satisfied ones.
+	unsigned int *matches;
+	int preferenceScore;
+	long long waste;
+
+	// The score of a unit of preference weight (above any amount of waste).
+	long long weight;
+
+	// The iteration of the last move of each session.
+	unsigned long long *movedAt;
+	unsigned long long random;
+} LocalSearch;
+
+static unsigned long long _nextRandom(LocalSearch *search);
+static double _nextUniform(LocalSearch *search);
+static long long _score(const LocalSearch *search);
+static long long _waste(const Model *model, const unsigned int session, const SymbolId classroom);
+static boolean _fits(const LocalSearch *search, const unsigned int session, const unsigned int placement, const SymbolId classroom);
+static void _place(LocalSearch *search, const unsigned int session, const unsigned int placement, const SymbolId classroom);
+static void _remove(LocalSearch *search, const unsigned int session);
+static unsigned int _proposeMove(LocalSearch *search, unsigned int *sessions, Assignment *values);
+static unsigned int _proposeSwap(LocalSearch *search, unsigned int *sessions, Assignment *values);
+static unsigned int _proposeRepair(LocalSearch *search, unsigned int *sessions, Assignment *values);
+static boolean _apply(LocalSearch *search, const unsigned int *sessions, const Assignment *values, const unsigned int count);
+static boolean _step(LocalSearch *search, const unsigned long long iteration, const double temperature, const long long bestScore);
+
+static unsigned long long _nextRandom(LocalSearch *search)
+{
+	search->random ^= search->random >> 12;
+	search->random ^= search->random << 25;
+	search->random ^= search->random >> 27;
+	return search->random * 2685821657736338717ULL;
+}
+
+/**
+ * A random number in [0, 1).
+ */
+static double _nextUniform(LocalSearch *search)
+{
+	return (_nextRandom(search) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static long long _score(const LocalSearch *search)
+{
+	return search->preferenceScore * search->weight - search->waste;
+}
+
+/**
+ * The seats of a classroom above the demand of the course of a session, by
+ * slot.
+ */
+static long long _waste(const Model *model, const unsigned int session, const SymbolId classroom)
+{
+	if (classroom == UNDEFINED_SYMBOL)
+	{
+		return 0;
+	}
+	const Session *variable = &model->sessions[session];
+	const long long seats = model->program->classrooms[classroom].capacity - model->demands[variable->course];
+	return seats < 0 ? 0 : seats * variable->length;
+}
+
+/**
+ * Returns true if an unplaced session can take a value without breaking a
+ * hard constraint.
+ */
+static boolean _fits(const LocalSearch *search, const unsigned int session, const unsigned int placement, const SymbolId classroom)
+{
+	const Model *model = search->model;
+	const Session *variable = &model->sessions[session];
+	const Placement *value = &model->placements[placement];
+	const unsigned int weekSlot = placementWeekSlot(model, value);
+	const unsigned int words = model->grid.wordCount;
+	if (model->sessionsPerDay <= search->courseDayLoad[variable->course * WEEK_DAY_COUNT + value->day])
+	{
+		return false;
+	}
+	if (bitsetAnyInRange(search->professorBusy + value->professor * words, weekSlot, variable->length)
+		|| bitsetAnyInRange(search->courseBusy + variable->course * words, weekSlot, variable->length))
+	{
+		return false;
+	}
+	return classroom == UNDEFINED_SYMBOL || !bitsetAnyInRange(search->classroomBusy + classroom * words, weekSlot, variable->length);
+}
+
+static void _place(LocalSearch *search, const unsigned int session, const unsigned int placement, const SymbolId classroom)
+{
+	const Model *model = search->model;
+	const Session *variable = &model->sessions[session];
+	const Placement *value = &model->placements[placement];
+	const unsigned int weekSlot = placementWeekSlot(model, value);
+	const unsigned int words = model->grid.wordCount;
+	search->assignments[session].placement = (int)placement;
+	search->assignments[session].classroom = classroom;
+	bitsetSetRange(search->professorBusy + value->professor * words, weekSlot, variable->length);
+	bitsetSetRange(search->courseBusy + variable->course * words, weekSlot, variable->length);
+	if (classroom != UNDEFINED_SYMBOL)
+	{
+		bitsetSetRange(search->classroomBusy + classroom * words, weekSlot, variable->length);
+	}
+	search->courseDayLoad[variable->course * WEEK_DAY_COUNT + value->day] += 1;
+	for (unsigned int m = model->placementFirstMatch[placement]; m < model->placementFirstMatch[placement + 1]; ++m)
+	{
+		const unsigned int k = model->placementMatches[m];
+		if (preferenceHolds(model, k, classroom) && search->matches[k]++ == 0)
+		{
+			search->preferenceScore += model->preferenceWeights[k];
+		}
+	}
+	search->waste += _waste(model, session, classroom);
+}
+
+static void _remove(LocalSearch *search, const unsigned int session)
+{
+	const Model *model = search->model;
+	const Session *variable = &model->sessions[session];
+	Assignment *assignment = &search->assignments[session];
+	const Placement *value = &model->placements[assignment->placement];
+	const unsigned int weekSlot = placementWeekSlot(model, value);
+	const unsigned int words = model->grid.wordCount;
+	bitsetResetRange(search->professorBusy + value->professor * words, weekSlot, variable->length);
+	bitsetResetRange(search->courseBusy + variable->course * words, weekSlot, variable->length);
+	if (assignment->classroom != UNDEFINED_SYMBOL)
+	{
+		bitsetResetRange(search->classroomBusy + assignment->classroom * words, weekSlot, variable->length);
+	}
+	search->courseDayLoad[variable->course * WEEK_DAY_COUNT + value->day] -= 1;
+	for (unsigned int m = model->placementFirstMatch[assignment->placement]; m < model->placementFirstMatch[assignment->placement + 1]; ++m)
+	{
+		const unsigned int k = model->placementMatches[m];
+		if (preferenceHolds(model, k, assignment->classroom) && --search->matches[k] == 0)
+		{
+			search->preferenceScore -= model->preferenceWeights[k];
+		}
+	}
+	search->waste -= _waste(model, session, assignment->classroom);
+	assignment->placement = -1;
+	assignment->classroom = UNDEFINED_SYMBOL;
+}
+
+/**
+ * Proposes to move a random session to a random placement of its domain, or
+ * to a random classroom (or both). Returns the amount of moved sessions.
+ */
+static unsigned int _proposeMove(LocalSearch *search, unsigned int *sessions, Assignment *values)
+{
+	const Model *model = search->model;
+	sessions[0] = (unsigned int)(_nextRandom(search) % model->sessionCount);
+	const Session *session = &model->sessions[sessions[0]];
+	const Assignment *current = &search->assignments[sessions[0]];
+	const unsigned long long random = _nextRandom(search);
+	values[0] = *current;
+	if (random & 1)
+	{
+		values[0].placement = (int)(session->firstPlacement + (random >> 2) % session->placementCount);
+	}
+	if (model->usesClassrooms && (random & 2))
+	{
+		values[0].classroom = model->rooms[session->firstRoom + (random >> 32) % session->roomCount];
+	}
+	return values[0].placement == current->placement && values[0].classroom == current->classroom ? 0 : 1;
+}
+
+/**
+ * Proposes to swap the times and classrooms of two random sessions with the
+ * same length, where each one keeps its professor (or its classroom, if the
+ * other one is not eligible). Returns the amount of moved sessions.
+ */
+static unsigned int _proposeSwap(LocalSearch *search, unsigned int *sessions, Assignment *values)
+{
+	const Model *model = search->model;
+	sessions[0] = (unsigned int)(_nextRandom(search) % model->sessionCount);
+	sessions[1] = (unsigned int)(_nextRandom(search) % model->sessionCount);
+	const Session *first = &model->sessions[sessions[0]];
+	const Session *second = &model->sessions[sessions[1]];
+	if (sessions[0] == sessions[1] || first->length != second->length)
+	{
+		return 0;
+	}
+	const Assignment *firstCurrent = &search->assignments[sessions[0]];
+	const Assignment *secondCurrent = &search->assignments[sessions[1]];
+	const Placement *firstValue = &model->placements[firstCurrent->placement];
+	const Placement *secondValue = &model->placements[secondCurrent->placement];
+	if (firstValue->day == secondValue->day && firstValue->slot == secondValue->slot)
+	{
+		return 0;
+	}
+	values[0].placement = findPlacement(model, first, firstValue->professor, secondValue->day, secondValue->slot);
+	values[1].placement = findPlacement(model, second, secondValue->professor, firstValue->day, firstValue->slot);
+	if (values[0].placement == -1 || values[1].placement == -1)
+	{
+		return 0;
+	}
+	const boolean exchange = sessionFits(model, first, secondCurrent->classroom) && sessionFits(model, second, firstCurrent->classroom);
+	values[0].classroom = exchange ? secondCurrent->classroom : firstCurrent->classroom;
+	values[1].classroom = exchange ? firstCurrent->classroom : secondCurrent->classroom;
+	return 2;
+}
+
+/**
+ * Proposes to satisfy a random preference that is not satisfied yet: a
+ * random session of its course moves to a placement that satisfies it (from
+ * a random one of its domain onwards), in its classroom (if it has one, and
+ * it's eligible). Returns the amount of moved sessions.
+ */
+static unsigned int _proposeRepair(LocalSearch *search, unsigned int *sessions, Assignment *values)
+{
+	const Model *model = search->model;
+	if (model->softPreferenceCount == 0)
+	{
+		return 0;
+	}
+	const unsigned int k = (unsigned int)(_nextRandom(search) % model->softPreferenceCount);
+	const unsigned int preference = model->softPreferences[k];
+	const SymbolId course = model->program->preferences[preference].details.course;
+	const SymbolId preferred = model->preferenceClassrooms[k];
+	const unsigned int first = model->courseFirstSession[course];
+	const unsigned int sessionCount = model->courseFirstSession[course + 1] - first;
+	if (search->matches[k] != 0 || model->preferenceWeights[k] == 0 || sessionCount == 0)
+	{
+		return 0;
+	}
+	sessions[0] = first + (unsigned int)(_nextRandom(search) % sessionCount);
+	const Session *session = &model->sessions[sessions[0]];
+	values[0] = search->assignments[sessions[0]];
+	if (preferred != UNDEFINED_SYMBOL && sessionFits(model, session, preferred))
+	{
+		values[0].classroom = preferred;
+	}
+	const unsigned int offset = (unsigned int)(_nextRandom(search) % session->placementCount);
+	for (unsigned int j = 0; j < session->placementCount; ++j)
+	{
+		const unsigned int placement = session->firstPlacement + (offset + j) % session->placementCount;
+		if (placementSatisfies(model, preference, sessions[0], &model->placements[placement]))
+		{
+			values[0].placement = (int)placement;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/**
+ * Removes the sessions, and places them with their new values. If any of
+ * them does not fit, the previous values are restored.
+ */
+static boolean _apply(LocalSearch *search, const unsigned int *sessions, const Assignment *values, const unsigned int count)
+{
+	Assignment previous[2];
+	for (unsigned int k = 0; k < count; ++k)
+	{
+		previous[k] = search->assignments[sessions[k]];
+		_remove(search, sessions[k]);
+	}
+	unsigned int placed = 0;
+	while (placed < count && _fits(search, sessions[placed], values[placed].placement, values[placed].classroom))
+	{
+		_place(search, sessions[placed], values[placed].placement, values[placed].classroom);
+		placed += 1;
+	}
+	if (placed == count)
+	{
+		return true;
+	}
+	for (unsigned int k = 0; k < placed; ++k)
+	{
+		_remove(search, sessions[k]);
+	}
+	for (unsigned int k = 0; k < count; ++k)
+	{
+		_place(search, sessions[k], previous[k].placement, previous[k].classroom);
+	}
+	return false;
+}
+
+/**
+ * Proposes a move, and accepts it if it's not worse, or with the probability
+ * of the annealing otherwise. A move of a tabu session is only accepted if it
+ * improves the best score. Returns true if the move is accepted.
+ */
+static boolean _step(LocalSearch *search, const unsigned long long iteration, const double temperature, const long long bestScore)
+{
+	unsigned int sessions[2];
+	Assignment values[2];
+	Assignment previous[2];
+	unsigned int count = 0;
+	switch (_nextRandom(search) % 4)
+	{
+	case 0:
+		count = _proposeRepair(search, sessions, values);
+		break;
+	case 1:
+		count = _proposeSwap(search, sessions, values);
+		break;
+	default:
+		count = _proposeMove(search, sessions, values);
+	}
+	boolean tabu = false;
+	for (unsigned int k = 0; k < count; ++k)
+	{
+		previous[k] = search->assignments[sessions[k]];
+		tabu = tabu || (search->movedAt[sessions[k]] != 0 && iteration < search->movedAt[sessions[k]] + TABU_TENURE);
+	}
+	const long long before = _score(search);
+	if (count == 0 || !_apply(search, sessions, values, count))
+	{
+		return false;
+	}
+	const long long after = _score(search);
+	const boolean accepted = (!tabu || bestScore < after)
+		&& (before <= after || _nextUniform(search) < exp((double)(after - before) / temperature));
+	if (!accepted)
+	{
+		_apply(search, sessions, previous, count);
+		return false;
+	}
+	for (unsigned int k = 0; k < count; ++k)
+	{
+		search->movedAt[sessions[k]] = iteration;
+	}
+	return true;
+}
+
+/** PUBLIC FUNCTIONS */
+
+Optimization *improveSchedule(const Model *model, const Assignment *seed, const ScheduleListener *listener)
+{
+	const unsigned int words = model->grid.wordCount;
+	LocalSearch search;
+	memset(&search, 0, sizeof(LocalSearch));
+	search.model = model;
+	search.assignments = calloc(1 + model->sessionCount, sizeof(Assignment));
+	search.professorBusy = calloc(1 + model->professorCount * words, sizeof(BitsetWord));
+	search.classroomBusy = calloc(1 + model->classroomCount * words, sizeof(BitsetWord));
+	search.courseBusy = calloc(1 + model->courseCount * words, sizeof(BitsetWord));
+	search.courseDayLoad = calloc(1 + model->courseCount * WEEK_DAY_COUNT, sizeof(unsigned char));
+	search.matches = calloc(1 + model->softPreferenceCount, sizeof(unsigned int));
+	search.movedAt = calloc(1 + model->sessionCount, sizeof(unsigned long long));
+	search.random = _seed == 0 ? 1 : _seed;
+
+	// The classrooms of a session are sorted by capacity, so the last one
+	// wastes the most.
+	search.weight = 1;
+	for (unsigned int s = 0; s < model->sessionCount; ++s)
+	{
+		const Session *session = &model->sessions[s];
+		if (model->usesClassrooms && 0 < session->roomCount)
+		{
+			search.weight += _waste(model, s, model->rooms[session->firstRoom + session->roomCount - 1]);
+		}
+		_place(&search, s, seed[s].placement, seed[s].classroom);
+	}
+
+	Assignment *best = calloc(1 + model->sessionCount, sizeof(Assignment));
+	memcpy(best, search.assignments, model->sessionCount * sizeof(Assignment));
+	long long bestScore = _score(&search);
+	const long long firstScore = bestScore;
+
+	// The moves are the budget of the whole program, so a part of it (e.g., a
+	// component) takes its share by sessions, rounded up.
+	const unsigned long long budget = model->programSessionCount <= model->sessionCount
+		? _moves
+		: (_moves * model->sessionCount + model->programSessionCount - 1) / model->programSessionCount;
+
+	// A geometric cooling, from the score of a preference.
+	double temperature = (double)search.weight;
+	const double cooling = budget == 0 ? 1.0 : pow(FINAL_TEMPERATURE / temperature, 1.0 / (double)budget);
+	unsigned long long accepted = 0;
+	unsigned long long moves = 0;
+	for (unsigned long long iteration = 1; 0 < model->sessionCount && iteration <= budget; ++iteration)
+	{
+		if (iteration % DEADLINE_POLL_MOVES == 0 && isImprovementExpired())
+		{
+			logInformation(_logger, "The time limit expires, so the local search stops after %llu of %llu move(s).", moves, budget);
+			break;
+		}
+		moves = iteration;
+		if (_step(&search, iteration, temperature, bestScore))
+		{
+			accepted += 1;
+			if (bestScore < _score(&search))
+			{
+				bestScore = _score(&search);
+				memcpy(best, search.assignments, model->sessionCount * sizeof(Assignment));
+				notifySchedule(listener, model, best, search.preferenceScore);
+			}
+		}
+		temperature *= cooling;
+	}
+	logDebugging(_logger, "The local search improves the score from %lld to %lld after %llu move(s) (%llu accepted).",
+				 firstScore, bestScore, moves, accepted);
+
+	Optimization *optimization = calloc(1, sizeof(Optimization));
+	optimization->status = SOLVER_SATISFIABLE;
+	optimization->assignments = best;
+	optimization->score = scoreAssignments(model, best, &optimization->satisfied);
+	optimization->preferenceCount = model->softPreferenceCount;
+	optimization->maximumScore = model->maximumScore;
+	optimization->optimal = false;
+	optimization->nodes = moves;
+	free(search.assignments);
+	free(search.professorBusy);
+	free(search.classroomBusy);
+	free(search.courseBusy);
+	free(search.courseDayLoad);
+	free(search.matches);
+	free(search.movedAt);
+	return optimization;
+}
@@ -0,0 +1,42 @@
+#ifndef LOCAL_SEARCH_HEADER
+#define LOCAL_SEARCH_HEADER
+
+#include "../../shared/Environment.h"
+#include "../../shared/Logger.h"
+#include "../../shared/Type.h"
+#include "Deadline.h"
+#include "Model.h"
+#include "Optimizer.h"
+#include "Solver.h"
+#include <math.h>
+
+/** Initialize module's internal state. */
+void initializeLocalSearchModule();
+
+/** Shutdown module's internal state. */
+void shutdownLocalSearchModule();
+
+/**
+ * Improves a feasible schedule with a simulated annealing over moves that
+ * keep every hard constraint: move a session to other placement or
+ * classroom, move a session to satisfy a preference, or swap the times and
+ * classrooms of two sessions with the same length (see "LOCAL_SEARCH_MOVES"
+ * and "SOLVER_SEED"). A session moved recently is tabu, unless the move
+ * improves the best schedule.
+ *
+ * The score rewards the weight of every satisfied soft preference (see
+ * "SOFT_PREFERENCE_WEIGHTS") over any amount of wasted seats (i.e., the
+ * capacity of a classroom above the demand of its course, by slot), and it's
+ * updated incrementally: a move only touches the professors, classrooms, days
+ * and the score table entries of the sessions it moves.
+ *
+ * The budget of moves is for the whole program, so a part of it (see
+ * "extractModel") only takes its share by sessions.
+ *
+ * The result is the best schedule found (never proven optimal), and every
+ * new best schedule goes to the listener. The search stops early if the time
+ * limit expires (see "SOLVER_TIME_LIMIT").
+ */
+Optimization * improveSchedule(const Model * model, const Assignment * seed, const ScheduleListener * listener);
+
+#endif
@@ -0,0 +1,1026 @@
+#include "Model.h"
+
+/* MODULE INTERNAL STATE */
+
+static Logger *_logger = NULL;
+
+// The weights of the soft preferences with only a day, with time, and with
+// classroom.
+static int _dayWeight = 1;
+static int _timedWeight = 1;
+static int _roomWeight = 1;
+
+/**
+ * The nodes of the search that checks if the sessions of a course fit
+ * together, before it gives up (and keeps the split).
+ */
+#define MAXIMUM_SPLIT_NODES 100000
+
+void initializeModelModule()
+{
+	_logger = createLogger("Model");
+	const char *weights = getStringOrDefault("SOFT_PREFERENCE_WEIGHTS", NULL);
+	if (weights == NULL)
+	{
+		return;
+	}
+	int day = 0;
+	int timed = 0;
+	int room = 0;
+	char rest = 0;
+	if (sscanf(weights, "%d,%d,%d%c", &day, &timed, &room, &rest) != 3
+		|| day < 0 || timed < 0 || room < 0 || MAXIMUM_PREFERENCE_WEIGHT < day || MAXIMUM_PREFERENCE_WEIGHT < timed || MAXIMUM_PREFERENCE_WEIGHT < room)
+	{
+		logWarning(_logger, "Invalid soft preference weights: \"%s\" (using %d,%d,%d instead).", weights, _dayWeight, _timedWeight, _roomWeight);
+		return;
+	}
+	_dayWeight = day;
+	_timedWeight = timed;
+	_roomWeight = room;
+}
+
+void shutdownModelModule()
+{
+	if (_logger != NULL)
+	{
+		destroyLogger(_logger);
+	}
+}
+
+/** PRIVATE FUNCTIONS */
+
+/**
+ * A session before its domain is computed: the attributes fixed by a hard
+ * preference (if any).
+ */
+typedef struct
+{
+	unsigned int length;
+	int preference;
+	SymbolId professor;
+	int day;
+	int slot;
+	SymbolId classroom;
+} SessionDraft;
+
+/**
+ * The temporary indexes required to build a model.
+ */
+typedef struct
+{
+	Model *model;
+	unsigned int sessionCapacity;
+	unsigned int placementCapacity;
+	unsigned int roomCapacity;
+
+	// The professors that can teach each course: [qualifiedFirst[c],
+	// qualifiedFirst[c + 1]), in ascending order.
+	unsigned int *qualifiedFirst;
+	SymbolId *qualified;
+
+	// The declared classrooms, by ascending capacity.
+	SymbolId *classroomOrder;
+
+	// The classrooms of the last course, shared by its unpinned sessions.
+	SymbolId roomCourse;
+	unsigned int roomFirst;
+	unsigned int roomCount;
+
+	// The splits of the hours of the courses in classes.
+	PartitionTable *partitions;
+} ModelBuilder;
+
+/**
+ * A classroom and its capacity, to sort the classrooms.
+ */
+typedef struct
+{
+	int capacity;
+	SymbolId classroom;
+} ClassroomCapacity;
+
+static void _indexQualifications(ModelBuilder *builder);
+static int _compareClassroomCapacities(const void *left, const void *right);
+static void _sortClassrooms(ModelBuilder *builder);
+static void _indexEligibility(Model *model);
+static boolean _sameClassroom(const Classroom *left, const Classroom *right);
+static void _indexClassroomClasses(ModelBuilder *builder);
+static boolean _isQualified(const ModelBuilder *builder, const SymbolId professor, const SymbolId course);
+static boolean _toExactSlots(const TimeGrid *grid, const PreferenceDetails *details, unsigned int *firstSlot, unsigned int *slotCount);
+static unsigned int _longestWindow(const ModelBuilder *builder, const SymbolId course);
+static boolean _draftSessions(ModelBuilder *builder, const SymbolId course, const unsigned int attempt, SessionDraft **drafts, unsigned int *draftCount, boolean *untried);
+static boolean _appendSession(ModelBuilder *builder, const SymbolId course, const SessionDraft *draft);
+static boolean _fitsTogether(const Model *model, const unsigned int first, const unsigned int depth, unsigned int *chosen, unsigned long long *nodes);
+static void _indexSoftPreferences(Model *model);
+static void _indexScores(Model *model);
+
+/**
+ * Builds the inverse of the "can teach" relation.
+ */
+static void _indexQualifications(ModelBuilder *builder)
+{
+	const Program *program = builder->model->program;
+	const unsigned int courseCount = builder->model->courseCount;
+	builder->qualifiedFirst = calloc(courseCount + 1, sizeof(unsigned int));
+	for (unsigned int p = 0; p < program->professorCount; ++p)
+	{
+		const Professor *professor = &program->professors[p];
+		for (unsigned int k = 0; professor->declared && k < professor->courseCount; ++k)
+		{
+			builder->qualifiedFirst[professor->courses[k] + 1] += 1;
+		}
+	}
+	for (unsigned int c = 0; c < courseCount; ++c)
+	{
+		builder->qualifiedFirst[c + 1] += builder->qualifiedFirst[c];
+	}
+	unsigned int *cursor = calloc(courseCount + 1, sizeof(unsigned int));
+	memcpy(cursor, builder->qualifiedFirst, (courseCount + 1) * sizeof(unsigned int));
+	builder->qualified = calloc(1 + builder->qualifiedFirst[courseCount], sizeof(SymbolId));
+	for (unsigned int p = 0; p < program->professorCount; ++p)
+	{
+		const Professor *professor = &program->professors[p];
+		for (unsigned int k = 0; professor->declared && k < professor->courseCount; ++k)
+		{
+			builder->qualified[cursor[professor->courses[k]]++] = p;
+		}
+	}
+	free(cursor);
+}
+
+static int _compareClassroomCapacities(const void *left, const void *right)
+{
+	const ClassroomCapacity *a = left;
+	const ClassroomCapacity *b = right;
+	if (a->capacity != b->capacity)
+	{
+		return a->capacity < b->capacity ? -1 : 1;
+	}
+	return a->classroom < b->classroom ? -1 : (a->classroom == b->classroom ? 0 : 1);
+}
+
+/**
+ * Sorts the classrooms by capacity, so the first free classroom of a session
+ * is also the smallest one that fits (i.e., best-fit).
+ */
+static void _sortClassrooms(ModelBuilder *builder)
+{
+	const Program *program = builder->model->program;
+	ClassroomCapacity *capacities = calloc(1 + program->classroomCount, sizeof(ClassroomCapacity));
+	for (unsigned int r = 0; r < program->classroomCount; ++r)
+	{
+		capacities[r].capacity = program->classrooms[r].capacity;
+		capacities[r].classroom = r;
+	}
+	qsort(capacities, program->classroomCount, sizeof(ClassroomCapacity), _compareClassroomCapacities);
+	builder->classroomOrder = calloc(1 + program->classroomCount, sizeof(SymbolId));
+	for (unsigned int r = 0; r < program->classroomCount; ++r)
+	{
+		builder->classroomOrder[r] = capacities[r].classroom;
+	}
+	free(capacities);
+	builder->roomCourse = UNDEFINED_SYMBOL;
+}
+
+static boolean _isQualified(const ModelBuilder *builder, const SymbolId professor, const SymbolId course)
+{
+	for (unsigned int k = builder->qualifiedFirst[course]; k < builder->qualifiedFirst[course + 1]; ++k)
+	{
+		if (builder->qualified[k] == professor)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Builds the eligibility matrix: a classroom can host a course if it's
+ * declared, it has a seat for every student, and it has every feature that
+ * the course requires (i.e., a single AND of their masks).
+ */
+static void _indexEligibility(Model *model)
+{
+	const Program *program = model->program;
+	model->eligibilityWords = BITSET_WORDS(model->classroomCount);
+	model->eligibility = createBitset(1 + model->courseCount * model->eligibilityWords);
+	for (unsigned int c = 0; c < model->courseCount; ++c)
+	{
+		const Course *course = &program->courses[c];
+		BitsetWord *row = model->eligibility + c * model->eligibilityWords;
+		for (unsigned int r = 0; course->declared && r < model->classroomCount; ++r)
+		{
+			const Classroom *classroom = &program->classrooms[r];
+			if (classroom->declared && model->demands[c] <= classroom->capacity
+				&& featureMaskCovers(&classroom->features, &course->requires))
+			{
+				bitsetSet(row, r);
+			}
+		}
+	}
+}
+
+/**
+ * Returns true if two classrooms have the same capacity, building and
+ * features (so they can host the same courses).
+ */
+static boolean _sameClassroom(const Classroom *left, const Classroom *right)
+{
+	if (left->capacity != right->capacity)
+	{
+		return false;
+	}
+	if ((left->building == NULL) != (right->building == NULL)
+		|| (left->building != NULL && strcmp(left->building, right->building) != 0))
+	{
+		return false;
+	}
+	return featureMaskCovers(&left->features, &right->features) && featureMaskCovers(&right->features, &left->features);
+}
+
+/**
+ * Groups the interchangeable classrooms: every declared classroom that no
+ * preference mentions (i.e., with an empty bucket in the program index)
+ * joins the class of the first equivalent one (in the order by capacity, so
+ * it only compares the classrooms of its capacity).
+ */
+static void _indexClassroomClasses(ModelBuilder *builder)
+{
+	Model *model = builder->model;
+	const Program *program = model->program;
+	const EntityBuckets *mentions = &program->index.classroomPreferences;
+	boolean *mentioned = calloc(1 + model->classroomCount, sizeof(boolean));
+	for (unsigned int r = 0; r < model->classroomCount; ++r)
+	{
+		mentioned[r] = mentions->first[r] != mentions->first[r + 1];
+	}
+	model->classroomClasses = calloc(1 + model->classroomCount, sizeof(SymbolId));
+	model->classroomClassCount = 0;
+	unsigned int runFirst = 0;
+	for (unsigned int k = 0; k < model->classroomCount; ++k)
+	{
+		const SymbolId r = builder->classroomOrder[k];
+		const Classroom *classroom = &program->classrooms[r];
+		model->classroomClasses[r] = r;
+		if (0 < k && program->classrooms[builder->classroomOrder[k - 1]].capacity != classroom->capacity)
+		{
+			runFirst = k;
+		}
+		for (unsigned int j = runFirst; classroom->declared && !mentioned[r] && j < k; ++j)
+		{
+			const SymbolId other = builder->classroomOrder[j];
+			if (program->classrooms[other].declared && !mentioned[other] && model->classroomClasses[other] == other
+				&& _sameClassroom(classroom, &program->classrooms[other]))
+			{
+				model->classroomClasses[r] = other;
+				break;
+			}
+		}
+	}
+
+	// The mentioned classrooms are no longer needed, so they mark the classes
+	// already counted.
+	memset(mentioned, 0, (1 + model->classroomCount) * sizeof(boolean));
+	for (unsigned int r = 0; r < model->classroomCount; ++r)
+	{
+		const SymbolId first = model->classroomClasses[r];
+		if (first != (SymbolId)r && !mentioned[first])
+		{
+			mentioned[first] = true;
+			model->classroomClassCount += 1;
+		}
+	}
+	free(mentioned);
+}
+
+/**
+ * Converts the interval of a hard preference to slots. Unlike a professor
+ * availability, it's never rounded nor clipped: it must be inside of the
+ * opening hours, and aligned to the time-grid.
+ */
+static boolean _toExactSlots(const TimeGrid *grid, const PreferenceDetails *details, unsigned int *firstSlot, unsigned int *slotCount)
+{
+	const unsigned int start = 60 * details->startTime.hour + details->startTime.minute;
+	const unsigned int end = 60 * details->endTime.hour + details->endTime.minute;
+	if (start < grid->openMinute || grid->closeMinute < end || end <= start)
+	{
+		return false;
+	}
+	if ((start - grid->openMinute) % grid->granularity != 0 || (end - start) % grid->granularity != 0)
+	{
+		return false;
+	}
+	*firstSlot = (start - grid->openMinute) / grid->granularity;
+	*slotCount = (end - start) / grid->granularity;
+	return *firstSlot + *slotCount <= grid->slotsPerDay;
+}
+
+/**
+ * The longest stretch of available slots in a day of any professor that can
+ * teach a course (i.e., its longest class that fits somewhere).
+ */
+static unsigned int _longestWindow(const ModelBuilder *builder, const SymbolId course)
+{
+	const Model *model = builder->model;
+	const TimeGrid *grid = &model->grid;
+	unsigned int longest = 0;
+	for (unsigned int k = builder->qualifiedFirst[course]; k < builder->qualifiedFirst[course + 1]; ++k)
+	{
+		const BitsetWord *availability = professorAvailability(model->availability, builder->qualified[k]);
+		for (unsigned int day = 0; day < WEEK_DAY_COUNT; ++day)
+		{
+			unsigned int stretch = 0;
+			for (unsigned int slot = 0; slot < grid->slotsPerDay; ++slot)
+			{
+				stretch = bitsetTest(availability, day * grid->slotsPerDay + slot) ? stretch + 1 : 0;
+				longest = longest < stretch ? stretch : longest;
+			}
+		}
+	}
+	return longest;
+}
+
+/**
+ * Splits the hours of a course in sessions. The hard preferences with time
+ * become sessions of their own; the remaining time takes a split of the
+ * partition table: the candidates are the splits (in the order of the table,
+ * i.e., as few sessions as possible, with balanced lengths) whose longest
+ * session fits in the availability of a professor, with a session for every
+ * hard preference without time, and it takes the candidate of the attempt
+ * (or the first split, without candidates). Then, the hard preferences
+ * without time pin the professor (and day) of the longest free sessions.
+ * Sets "untried" to true if a later attempt has another candidate.
+ */
+static boolean _draftSessions(ModelBuilder *builder, const SymbolId course, const unsigned int attempt, SessionDraft **drafts, unsigned int *draftCount, boolean *untried)
+{
+	const Model *model = builder->model;
+	const Program *program = model->program;
+	const Course *subject = &program->courses[course];
+	const TimeGrid *grid = &model->grid;
+	const Configuration *configuration = &program->configuration;
+	const unsigned int g = grid->granularity;
+	const unsigned int minimumLength = configuration->hasClassDuration ? (60 * configuration->classDuration.minHours + g - 1) / g : (60 + g - 1) / g;
+	const unsigned int totalLength = (60 * subject->hours + g - 1) / g;
+	const unsigned int maximumLength = configuration->hasClassDuration ? 60 * configuration->classDuration.maxHours / g : totalLength;
+	boolean succeed = true;
+	*untried = false;
+
+	// The hard preferences of the course, in its bucket of the program index.
+	const EntityBuckets *preferences = &program->index.coursePreferences;
+	unsigned int preferenceCount = 0;
+	for (unsigned int j = preferences->first[course]; j < preferences->first[course + 1]; ++j)
+	{
+		preferenceCount += program->preferences[preferences->items[j]].type == HARD_PREFERENCE ? 1 : 0;
+	}
+	const unsigned int capacity = preferenceCount + WEEK_DAY_COUNT * model->sessionsPerDay + 1;
+	SessionDraft *draft = calloc(capacity, sizeof(SessionDraft));
+	unsigned int count = 0;
+	unsigned int pinnedLength = 0;
+
+	// Sessions with time.
+	for (unsigned int j = preferences->first[course]; j < preferences->first[course + 1]; ++j)
+	{
+		const int k = (int)preferences->items[j];
+		if (program->preferences[k].type != HARD_PREFERENCE)
+		{
+			continue;
+		}
+		const PreferenceDetails *details = &program->preferences[k].details;
+		const char *professorName = program->professors[details->professor].id;
+		if (!_isQualified(builder, details->professor, course))
+		{
+			logError(_logger, "The professor \"%s\" cannot teach \"%s\", but a hard preference requires it.", professorName, subject->id);
+			succeed = false;
+			continue;
+		}
+		if (!details->hasTime)
+		{
+			continue;
+		}
+		unsigned int firstSlot = 0;
+		unsigned int slotCount = 0;
+		if (!_toExactSlots(grid, details, &firstSlot, &slotCount))
+		{
+			logError(_logger, "The hard preference of \"%s\" to teach \"%s\" from %02d:%02d to %02d:%02d is outside of the opening hours, or it's not aligned to slots of %u minutes.",
+					 professorName, subject->id, details->startTime.hour, details->startTime.minute, details->endTime.hour, details->endTime.minute, g);
+			succeed = false;
+			continue;
+		}
+		if (configuration->hasClassDuration && (slotCount < minimumLength || maximumLength < slotCount))
+		{
+			logError(_logger, "The hard preference of \"%s\" to teach \"%s\" lasts %u minute(s), outside of the class duration.",
+					 professorName, subject->id, slotCount * g);
+			succeed = false;
+			continue;
+		}
+		draft[count].length = slotCount;
+		draft[count].preference = k;
+		draft[count].professor = details->professor;
+		draft[count].day = details->hasDay && details->day != DAY_EVERYDAY ? (int)details->day : -1;
+		draft[count].slot = (int)firstSlot;
+		draft[count].classroom = details->classroom;
+		pinnedLength += slotCount;
+		++count;
+	}
+	if (!succeed)
+	{
+		free(draft);
+		return false;
+	}
+	if (totalLength < pinnedLength)
+	{
+		logError(_logger, "The hard preferences of \"%s\" last %u minute(s), but the course has only %d hour(s).", subject->id, pinnedLength * g, subject->hours);
+		free(draft);
+		return false;
+	}
+
+	// Free sessions (longest first).
+	const unsigned int remainingLength = totalLength - pinnedLength;
+	const unsigned int pinnedCount = count;
+	if (0 < remainingLength)
+	{
+		const unsigned int sessions = maximumLength == 0 ? 0 : (remainingLength + maximumLength - 1) / maximumLength;
+		if (sessions == 0 || remainingLength < sessions * minimumLength)
+		{
+			logError(_logger, "The remaining %u minute(s) of \"%s\" cannot be split in classes within the class duration.", remainingLength * g, subject->id);
+			free(draft);
+			return false;
+		}
+		const unsigned int weekCapacity = WEEK_DAY_COUNT * model->sessionsPerDay;
+		const PartitionEntry *entry = findPartitions(builder->partitions, remainingLength, minimumLength, maximumLength, pinnedCount < weekCapacity ? weekCapacity - pinnedCount : 0);
+		if (entry->count == 0)
+		{
+			logError(_logger, "The course \"%s\" requires %u classes, but only %u fit in a week.", subject->id, pinnedCount + sessions, weekCapacity);
+			free(draft);
+			return false;
+		}
+		const unsigned int longest = _longestWindow(builder, course);
+		const unsigned int untimed = preferenceCount - pinnedCount;
+		unsigned int split = entry->count;
+		unsigned int candidates = 0;
+		for (unsigned int k = 0; k < entry->count; ++k)
+		{
+			const unsigned int parts = entry->starts[k + 1] - entry->starts[k];
+			if (entry->parts[entry->starts[k]] <= longest && untimed <= parts)
+			{
+				split = candidates == attempt ? k : split;
+				*untried = *untried || attempt < candidates;
+				++candidates;
+			}
+		}
+		split = split < entry->count ? split : 0;
+		for (unsigned int k = entry->starts[split]; k < entry->starts[split + 1]; ++k)
+		{
+			draft[count].length = entry->parts[k];
+			draft[count].preference = -1;
+			draft[count].professor = UNDEFINED_SYMBOL;
+			draft[count].day = -1;
+			draft[count].slot = -1;
+			draft[count].classroom = UNDEFINED_SYMBOL;
+			++count;
+		}
+	}
+
+	// Hard preferences without time.
+	unsigned int next = pinnedCount;
+	for (unsigned int j = preferences->first[course]; j < preferences->first[course + 1]; ++j)
+	{
+		const int k = (int)preferences->items[j];
+		const PreferenceDetails *details = &program->preferences[k].details;
+		if (program->preferences[k].type != HARD_PREFERENCE || details->hasTime)
+		{
+			continue;
+		}
+		if (count <= next)
+		{
+			logError(_logger, "The course \"%s\" has more hard preferences than classes.", subject->id);
+			free(draft);
+			return false;
+		}
+		draft[next].preference = k;
+		draft[next].professor = details->professor;
+		draft[next].day = details->hasDay && details->day != DAY_EVERYDAY ? (int)details->day : -1;
+		draft[next].classroom = details->classroom;
+		++next;
+	}
+	*drafts = draft;
+	*draftCount = count;
+	return true;
+}
+
+/**
+ * Appends a session to the model, with its domain: every placement of a
+ * qualified professor where the professor is available, and every classroom
+ * that fits the course.
+ */
+static boolean _appendSession(ModelBuilder *builder, const SymbolId course, const SessionDraft *draft)
+{
+	Model *model = builder->model;
+	const Program *program = model->program;
+	const TimeGrid *grid = &model->grid;
+	if (builder->sessionCapacity == model->sessionCount)
+	{
+		builder->sessionCapacity = builder->sessionCapacity < 64 ? 64 : 2 * builder->sessionCapacity;
+		model->sessions = realloc(model->sessions, builder->sessionCapacity * sizeof(Session));
+	}
+	Session *session = &model->sessions[model->sessionCount];
+	session->course = course;
+	session->length = draft->length;
+	session->preference = draft->preference;
+
+	// Classrooms.
+	session->firstRoom = model->roomCount;
+	session->roomCount = 0;
+	const SymbolId pinned = draft->classroom != UNDEFINED_SYMBOL && program->classrooms[draft->classroom].declared ? draft->classroom : UNDEFINED_SYMBOL;
+	if (model->usesClassrooms && pinned == UNDEFINED_SYMBOL && builder->roomCourse == course)
+	{
+		session->firstRoom = builder->roomFirst;
+		session->roomCount = builder->roomCount;
+	}
+	else if (model->usesClassrooms)
+	{
+		const unsigned int candidates = pinned == UNDEFINED_SYMBOL ? model->classroomCount : 1;
+		for (unsigned int k = 0; k < candidates; ++k)
+		{
+			const SymbolId r = pinned == UNDEFINED_SYMBOL ? builder->classroomOrder[k] : pinned;
+			if (!courseFits(model, course, r))
+			{
+				continue;
+			}
+			if (builder->roomCapacity == model->roomCount)
+			{
+				builder->roomCapacity = builder->roomCapacity < 64 ? 64 : 2 * builder->roomCapacity;
+				model->rooms = realloc(model->rooms, builder->roomCapacity * sizeof(SymbolId));
+			}
+			model->rooms[model->roomCount++] = r;
+			++session->roomCount;
+		}
+		if (session->roomCount == 0)
+		{
+			if (pinned == UNDEFINED_SYMBOL)
+			{
+				logError(_logger, "There is no classroom for the %d student(s) of \"%s\" with every required feature.", model->demands[course], program->courses[course].id);
+			}
+			else
+			{
+				logError(_logger, "The classroom \"%s\" cannot host \"%s\", but a hard preference requires it.", program->classrooms[pinned].id, program->courses[course].id);
+			}
+			return false;
+		}
+		if (pinned == UNDEFINED_SYMBOL)
+		{
+			builder->roomCourse = course;
+			builder->roomFirst = session->firstRoom;
+			builder->roomCount = session->roomCount;
+		}
+	}
+
+	// Placements.
+	session->firstPlacement = model->placementCount;
+	session->placementCount = 0;
+	const unsigned int professorFirst = draft->professor == UNDEFINED_SYMBOL ? builder->qualifiedFirst[course] : 0;
+	const unsigned int professorLast = draft->professor == UNDEFINED_SYMBOL ? builder->qualifiedFirst[course + 1] : 1;
+	const unsigned int dayFirst = draft->day < 0 ? 0 : (unsigned int)draft->day;
+	const unsigned int dayLast = draft->day < 0 ? WEEK_DAY_COUNT : (unsigned int)draft->day + 1;
+	const unsigned int slotFirst = draft->slot < 0 ? 0 : (unsigned int)draft->slot;
+	const unsigned int slotLast = draft->slot < 0 ? grid->slotsPerDay + 1 - (draft->length < grid->slotsPerDay ? draft->length : grid->slotsPerDay) : (unsigned int)draft->slot + 1;
+	for (unsigned int k = professorFirst; draft->length <= grid->slotsPerDay && k < professorLast; ++k)
+	{
+		const SymbolId professor = draft->professor == UNDEFINED_SYMBOL ? builder->qualified[k] : draft->professor;
+		const BitsetWord *availability = professorAvailability(model->availability, professor);
+		for (unsigned int day = dayFirst; day < dayLast; ++day)
+		{
+			for (unsigned int slot = slotFirst; slot < slotLast; ++slot)
+			{
+				if (!bitsetAllInRange(availability, day * grid->slotsPerDay + slot, draft->length))
+				{
+					continue;
+				}
+				if (builder->placementCapacity == model->placementCount)
+				{
+					builder->placementCapacity = builder->placementCapacity < 1024 ? 1024 : 2 * builder->placementCapacity;
+					model->placements = realloc(model->placements, builder->placementCapacity * sizeof(Placement));
+				}
+				Placement *placement = &model->placements[model->placementCount++];
+				placement->professor = professor;
+				placement->day = day;
+				placement->slot = slot;
+				++session->placementCount;
+			}
+		}
+	}
+	if (session->placementCount == 0)
+	{
+		if (draft->preference < 0)
+		{
+			logError(_logger, "A class of %u minute(s) of \"%s\" does not fit in the availability of any of its professors.",
+					 draft->length * grid->granularity, program->courses[course].id);
+		}
+		else
+		{
+			logError(_logger, "The hard preference of \"%s\" to teach \"%s\" is outside of the professor availability.",
+					 program->professors[draft->professor].id, program->courses[course].id);
+		}
+		return false;
+	}
+	++model->sessionCount;
+	return true;
+}
+
+/**
+ * Returns true if the sessions of a course, from the depth, have placements
+ * that fit together with the placements already chosen: at most the classes
+ * per day, and never at the same time. It's the schedule of the course on
+ * its own, so it only tells the splits that can never work; if the search
+ * runs out of nodes, it assumes that they fit.
+ */
+static boolean _fitsTogether(const Model *model, const unsigned int first, const unsigned int depth, unsigned int *chosen, unsigned long long *nodes)
+{
+	if (first + depth == model->sessionCount)
+	{
+		return true;
+	}
+	const Session *session = &model->sessions[first + depth];
+	for (unsigned int p = session->firstPlacement; p < session->firstPlacement + session->placementCount; ++p)
+	{
+		*nodes += 1;
+		if (MAXIMUM_SPLIT_NODES < *nodes)
+		{
+			return true;
+		}
+		const Placement *placement = &model->placements[p];
+		unsigned int sameDay = 0;
+		boolean overlaps = false;
+		for (unsigned int k = 0; !overlaps && k < depth; ++k)
+		{
+			const Placement *other = &model->placements[chosen[k]];
+			const unsigned int otherLength = model->sessions[first + k].length;
+			if (other->day == placement->day)
+			{
+				sameDay += 1;
+				overlaps = placement->slot < other->slot + otherLength && other->slot < placement->slot + session->length;
+			}
+		}
+		if (overlaps || model->sessionsPerDay <= sameDay)
+		{
+			continue;
+		}
+		chosen[depth] = p;
+		if (_fitsTogether(model, first, depth + 1, chosen, nodes))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Gathers the soft preferences of every course from its bucket of the
+ * program index (which only has the preferences of declared professors and
+ * courses, since the rest were already reported).
+ */
+static void _indexSoftPreferences(Model *model)
+{
+	const Program *program = model->program;
+	const EntityBuckets *preferences = &program->index.coursePreferences;
+	model->courseFirstPreference = calloc(model->courseCount + 2, sizeof(unsigned int));
+	model->softPreferences = calloc(1 + program->preferenceCount, sizeof(unsigned int));
+	model->softPreferenceCount = 0;
+	for (unsigned int c = 0; c < model->courseCount; ++c)
+	{
+		model->courseFirstPreference[c] = model->softPreferenceCount;
+		for (unsigned int j = preferences->first[c]; j < preferences->first[c + 1]; ++j)
+		{
+			if (program->preferences[preferences->items[j]].type == SOFT_PREFERENCE)
+			{
+				model->softPreferences[model->softPreferenceCount++] = preferences->items[j];
+			}
+		}
+	}
+	model->courseFirstPreference[model->courseCount] = model->softPreferenceCount;
+}
+
+/**
+ * Weighs the soft preferences, and builds the score table (with a counting
+ * sort by placement, as the soft preferences by course). A placement only
+ * checks the preferences of its course, and in ascending order, so the
+ * matches of every placement stay sorted.
+ */
+static void _indexScores(Model *model)
+{
+	const Program *program = model->program;
+	model->preferenceWeights = calloc(1 + model->softPreferenceCount, sizeof(int));
+	model->preferenceClassrooms = calloc(1 + model->softPreferenceCount, sizeof(SymbolId));
+	model->maximumScore = 0;
+	for (unsigned int k = 0; k < model->softPreferenceCount; ++k)
+	{
+		const PreferenceDetails *details = &program->preferences[model->softPreferences[k]].details;
+		const boolean located = details->classroom != UNDEFINED_SYMBOL && program->classrooms[details->classroom].declared;
+		model->preferenceClassrooms[k] = located ? details->classroom : UNDEFINED_SYMBOL;
+		model->preferenceWeights[k] = located ? _roomWeight : (details->hasTime ? _timedWeight : _dayWeight);
+		model->maximumScore += model->preferenceWeights[k];
+	}
+	model->placementFirstMatch = calloc(model->placementCount + 2, sizeof(unsigned int));
+	for (unsigned int pass = 0; pass < 2; ++pass)
+	{
+		for (unsigned int s = 0; s < model->sessionCount; ++s)
+		{
+			const Session *session = &model->sessions[s];
+			for (unsigned int p = session->firstPlacement; p < session->firstPlacement + session->placementCount; ++p)
+			{
+				for (unsigned int k = model->courseFirstPreference[session->course]; k < model->courseFirstPreference[session->course + 1]; ++k)
+				{
+					if (!placementSatisfies(model, model->softPreferences[k], s, &model->placements[p]))
+					{
+						continue;
+					}
+					if (pass == 0)
+					{
+						model->placementFirstMatch[p + 2] += 1;
+					}
+					else
+					{
+						model->placementMatches[model->placementFirstMatch[p + 1]++] = k;
+					}
+				}
+			}
+		}
+		if (pass == 0)
+		{
+			for (unsigned int p = 0; p < model->placementCount; ++p)
+			{
+				model->placementFirstMatch[p + 2] += model->placementFirstMatch[p + 1];
+			}
+			model->matchCount = model->placementFirstMatch[model->placementCount + 1];
+			model->placementMatches = calloc(1 + model->matchCount, sizeof(unsigned int));
+		}
+	}
+}
+
+/** PUBLIC FUNCTIONS */
+
+Model *createModel(const Program *program)
+{
+	logDebugging(_logger, "Building the scheduling model...");
+	Model *model = calloc(1, sizeof(Model));
+	model->program = program;
+	model->availability = createAvailabilityTable(program);
+	model->grid = model->availability->grid;
+	model->professorCount = program->professorCount;
+	model->courseCount = program->courseCount;
+	model->classroomCount = program->classroomCount;
+	model->sessionsPerDay = classesPerDay();
+	model->usesClassrooms = false;
+	for (unsigned int r = 0; r < program->classroomCount; ++r)
+	{
+		model->usesClassrooms = model->usesClassrooms || program->classrooms[r].declared;
+	}
+	model->demands = calloc(1 + model->courseCount, sizeof(int));
+	memcpy(model->demands, program->index.courseStudents, model->courseCount * sizeof(int));
+
+	ModelBuilder builder = {0};
+	builder.model = model;
+	_indexQualifications(&builder);
+	_sortClassrooms(&builder);
+	_indexEligibility(model);
+	_indexClassroomClasses(&builder);
+	builder.partitions = createPartitionTable();
+	model->courseFirstSession = calloc(model->courseCount + 1, sizeof(unsigned int));
+
+	boolean succeed = true;
+	for (SymbolId c = 0; c < (SymbolId)model->courseCount; ++c)
+	{
+		const Course *course = &program->courses[c];
+		model->courseFirstSession[c] = model->sessionCount;
+		if (!course->declared || course->hours <= 0)
+		{
+			continue;
+		}
+		if (builder.qualifiedFirst[c] == builder.qualifiedFirst[c + 1])
+		{
+			if (0 < model->demands[c])
+			{
+				logError(_logger, "The %d student(s) of \"%s\" require it, but no professor can teach it.", model->demands[c], course->id);
+				succeed = false;
+			}
+			else
+			{
+				logWarning(_logger, "The course \"%s\" has no professor that can teach it, so it will not be scheduled.", course->id);
+			}
+			continue;
+		}
+		// A split whose sessions cannot fit together is undone, while the
+		// course has other splits to try.
+		boolean split = false;
+		for (unsigned int attempt = 0; !split; ++attempt)
+		{
+			SessionDraft *drafts = NULL;
+			unsigned int draftCount = 0;
+			boolean untried = false;
+			if (!_draftSessions(&builder, c, attempt, &drafts, &draftCount, &untried))
+			{
+				succeed = false;
+				break;
+			}
+			const unsigned int placementCount = model->placementCount;
+			const unsigned int roomCount = model->roomCount;
+			boolean appended = true;
+			for (unsigned int k = 0; k < draftCount; ++k)
+			{
+				appended = _appendSession(&builder, c, &drafts[k]) && appended;
+			}
+			free(drafts);
+			succeed = appended && succeed;
+			unsigned int *chosen = calloc(1 + model->sessionCount - model->courseFirstSession[c], sizeof(unsigned int));
+			unsigned long long nodes = 0;
+			split = !appended || !untried || _fitsTogether(model, model->courseFirstSession[c], 0, chosen, &nodes);
+			free(chosen);
+			if (!split)
+			{
+				logDebugging(_logger, "The classes of the split %u of \"%s\" cannot fit together, so it tries the next one.", attempt, course->id);
+				model->sessionCount = model->courseFirstSession[c];
+				model->placementCount = placementCount;
+				model->roomCount = roomCount;
+				builder.roomCourse = UNDEFINED_SYMBOL;
+			}
+		}
+	}
+	model->courseFirstSession[model->courseCount] = model->sessionCount;
+	model->programSessionCount = model->sessionCount;
+	_indexSoftPreferences(model);
+	_indexScores(model);
+
+	free(builder.qualifiedFirst);
+	free(builder.qualified);
+	free(builder.classroomOrder);
+	logPartitionTable(builder.partitions, model->grid.granularity);
+	destroyPartitionTable(builder.partitions);
+	if (!succeed)
+	{
+		destroyModel(model);
+		return NULL;
+	}
+	logDebugging(_logger, "The model has %u session(s), with %u placement(s) and %u classroom(s) in their domains.",
+				 model->sessionCount, model->placementCount, model->roomCount);
+	if (0 < model->classroomClassCount)
+	{
+		logDebugging(_logger, "The model has %u class(es) of interchangeable classrooms.", model->classroomClassCount);
+	}
+	logDebugging(_logger, "The score table has %u match(es) of %u soft preference(s), for a maximum score of %d.",
+				 model->matchCount, model->softPreferenceCount, model->maximumScore);
+	return model;
+}
+
+void destroyModel(Model *model)
+{
+	if (model != NULL)
+	{
+		if (!model->borrowsAvailability)
+		{
+			destroyAvailabilityTable(model->availability);
+		}
+		free(model->sessions);
+		free(model->placements);
+		free(model->rooms);
+		free(model->demands);
+		destroyBitset(model->eligibility);
+		free(model->classroomClasses);
+		free(model->courseFirstSession);
+		free(model->courseFirstPreference);
+		free(model->softPreferences);
+		free(model->preferenceWeights);
+		free(model->preferenceClassrooms);
+		free(model->placementFirstMatch);
+		free(model->placementMatches);
+		free(model);
+	}
+}
+
+Model *extractModel(const Model *model, const unsigned int *sessions, const unsigned int sessionCount)
+{
+	Model *part = calloc(1, sizeof(Model));
+	memcpy(part, model, sizeof(Model));
+	part->borrowsAvailability = true;
+	part->sessionCount = sessionCount;
+	part->placementCount = 0;
+	part->roomCount = 0;
+	for (unsigned int k = 0; k < sessionCount; ++k)
+	{
+		part->placementCount += model->sessions[sessions[k]].placementCount;
+		part->roomCount += model->sessions[sessions[k]].roomCount;
+	}
+	part->sessions = calloc(1 + sessionCount, sizeof(Session));
+	part->placements = calloc(1 + part->placementCount, sizeof(Placement));
+	part->rooms = calloc(1 + part->roomCount, sizeof(SymbolId));
+	part->demands = calloc(1 + model->courseCount, sizeof(int));
+	memcpy(part->demands, model->demands, model->courseCount * sizeof(int));
+	part->eligibility = createBitset(1 + model->courseCount * model->eligibilityWords);
+	bitsetCopy(part->eligibility, model->eligibility, model->courseCount * model->eligibilityWords);
+	part->classroomClasses = calloc(1 + model->classroomCount, sizeof(SymbolId));
+	memcpy(part->classroomClasses, model->classroomClasses, model->classroomCount * sizeof(SymbolId));
+	part->courseFirstSession = calloc(model->courseCount + 1, sizeof(unsigned int));
+	part->courseFirstPreference = calloc(model->courseCount + 2, sizeof(unsigned int));
+	part->softPreferences = calloc(1 + model->softPreferenceCount, sizeof(unsigned int));
+	part->softPreferenceCount = 0;
+
+	unsigned int placementCount = 0;
+	unsigned int roomCount = 0;
+	unsigned int k = 0;
+	for (SymbolId c = 0; c < (SymbolId)model->courseCount; ++c)
+	{
+		part->courseFirstSession[c] = k;
+		part->courseFirstPreference[c] = part->softPreferenceCount;
+		const unsigned int first = k;
+		for (; k < sessionCount && model->sessions[sessions[k]].course == c; ++k)
+		{
+			const Session *session = &model->sessions[sessions[k]];
+			Session *copy = &part->sessions[k];
+			*copy = *session;
+			copy->firstPlacement = placementCount;
+			copy->firstRoom = roomCount;
+			memcpy(part->placements + placementCount, model->placements + session->firstPlacement, session->placementCount * sizeof(Placement));
+			memcpy(part->rooms + roomCount, model->rooms + session->firstRoom, session->roomCount * sizeof(SymbolId));
+			placementCount += session->placementCount;
+			roomCount += session->roomCount;
+		}
+		for (unsigned int p = model->courseFirstPreference[c]; first < k && p < model->courseFirstPreference[c + 1]; ++p)
+		{
+			part->softPreferences[part->softPreferenceCount++] = model->softPreferences[p];
+		}
+	}
+	part->courseFirstSession[model->courseCount] = sessionCount;
+	part->courseFirstPreference[model->courseCount] = part->softPreferenceCount;
+	_indexScores(part);
+	return part;
+}
+
+int findPlacement(const Model *model, const Session *session, const SymbolId professor, const unsigned int day, const unsigned int slot)
+{
+	unsigned int low = session->firstPlacement;
+	unsigned int high = session->firstPlacement + session->placementCount;
+	while (low < high)
+	{
+		const unsigned int middle = low + (high - low) / 2;
+		const Placement *placement = &model->placements[middle];
+		if (placement->professor < professor || (placement->professor == professor
+			&& (placement->day < day || (placement->day == day && placement->slot < slot))))
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+	if (low < session->firstPlacement + session->placementCount)
+	{
+		const Placement *placement = &model->placements[low];
+		if (placement->professor == professor && placement->day == day && placement->slot == slot)
+		{
+			return (int)low;
+		}
+	}
+	return -1;
+}
+
+boolean placementSatisfies(const Model *model, const unsigned int preference, const unsigned int session, const Placement *placement)
+{
+	if (model->program->preferences[preference].details.professor != placement->professor)
+	{
+		return false;
+	}
+	const BitsetWord *window = preferenceWindow(model->availability, preference);
+	return bitsetAllInRange(window, placementWeekSlot(model, placement), model->sessions[session].length);
+}
+
+boolean weighsPreferences()
+{
+	return _dayWeight != 1 || _timedWeight != 1 || _roomWeight != 1;
+}
+
+int scoreAssignments(const Model *model, const Assignment *assignments, int *satisfied)
+{
+	boolean *matched = calloc(1 + model->softPreferenceCount, sizeof(boolean));
+	int score = 0;
+	*satisfied = 0;
+	for (unsigned int s = 0; s < model->sessionCount; ++s)
+	{
+		const Assignment *assignment = &assignments[s];
+		if (assignment->placement < 0)
+		{
+			continue;
+		}
+		for (unsigned int m = model->placementFirstMatch[assignment->placement]; m < model->placementFirstMatch[assignment->placement + 1]; ++m)
+		{
+			const unsigned int k = model->placementMatches[m];
+			if (!matched[k] && preferenceHolds(model, k, assignment->classroom))
+			{
+				matched[k] = true;
+				*satisfied += 1;
+				score += model->preferenceWeights[k];
+			}
+		}
+	}
+	free(matched);
+	return score;
+}
@@ -0,0 +1,233 @@
+#ifndef MODEL_HEADER
+#define MODEL_HEADER
+
+#include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
+#include "../../shared/Environment.h"
+#include "../../shared/Logger.h"
+#include "../../shared/Type.h"
+#include "Availability.h"
+#include "Bitset.h"
+#include "Partition.h"
+#include <stdio.h>
+
+/** Initialize module's internal state. */
+void initializeModelModule();
+
+/** Shutdown module's internal state. */
+void shutdownModelModule();
+
+/**
+ * The maximum weight of a kind of soft preference (see
+ * "SOFT_PREFERENCE_WEIGHTS").
+ */
+#define MAXIMUM_PREFERENCE_WEIGHT 1000
+
+/**
+ * A candidate placement of a session: who teaches it, and when it begins.
+ */
+typedef struct {
+	SymbolId professor;
+	unsigned short day;
+	unsigned short slot;
+} Placement;
+
+/**
+ * The value of a session: a placement (as an index of the model placements),
+ * and a classroom (or UNDEFINED_SYMBOL).
+ */
+typedef struct {
+	int placement;
+	SymbolId classroom;
+} Assignment;
+
+/**
+ * A class of a course, with a fixed length. The hours of every course are
+ * split in sessions within the class duration bounds. A session can be pinned
+ * (partially or completely) by a hard preference.
+ *
+ * The domain of a session is the set of placements that satisfy its unary
+ * constraints (qualification, availability and pins), sorted by professor,
+ * day and slot, and the set of classrooms that fit its course (or the single
+ * classroom pinned by its preference), by ascending capacity. The unpinned
+ * sessions of a course share the same classrooms.
+ */
+typedef struct {
+	SymbolId course;
+	unsigned int length;
+
+	// The hard preference that pins the session (or -1).
+	int preference;
+
+	unsigned int firstPlacement;
+	unsigned int placementCount;
+
+	unsigned int firstRoom;
+	unsigned int roomCount;
+} Session;
+
+/**
+ * The read-only scheduling problem of a program: the sessions to place, and
+ * their domains. It only references declared entities.
+ */
+typedef struct {
+	const Program * program;
+	AvailabilityTable * availability;
+	TimeGrid grid;
+
+	// True if the availability table belongs to other model (see
+	// "extractModel").
+	boolean borrowsAvailability;
+
+	unsigned int professorCount;
+	unsigned int courseCount;
+	unsigned int classroomCount;
+
+	// True if the program declares classrooms. Otherwise, the sessions are
+	// scheduled without classroom.
+	boolean usesClassrooms;
+
+	// The maximum amount of sessions of a course in the same day (see
+	// "CLASSES_PER_DAY").
+	unsigned int sessionsPerDay;
+
+	Session * sessions;
+	unsigned int sessionCount;
+
+	// The sessions of the whole program (a part from "extractModel" keeps it,
+	// so it knows its share of the program).
+	unsigned int programSessionCount;
+
+	Placement * placements;
+	unsigned int placementCount;
+
+	SymbolId * rooms;
+	unsigned int roomCount;
+
+	// The students that require each course (indexed by symbol).
+	int * demands;
+
+	// The classrooms that can host each course, as a row of bits (indexed by
+	// classroom) per course: [eligibility + c * eligibilityWords].
+	BitsetWord * eligibility;
+	unsigned int eligibilityWords;
+
+	// The interchangeable classrooms (i.e., with the same capacity, building
+	// and features, and without any preference that mentions them) form a
+	// class, identified by its first classroom: classroomClasses[r] is the
+	// first classroom of the class of "r" (or "r" itself, if it has no
+	// equivalent). The classes with more than one classroom are counted.
+	SymbolId * classroomClasses;
+	unsigned int classroomClassCount;
+
+	// The sessions of each course are contiguous: [courseFirstSession[c],
+	// courseFirstSession[c + 1]).
+	unsigned int * courseFirstSession;
+
+	// The soft preferences of each course (as indexes of the preferences of
+	// the program): [courseFirstPreference[c], courseFirstPreference[c + 1]).
+	unsigned int * courseFirstPreference;
+	unsigned int * softPreferences;
+	unsigned int softPreferenceCount;
+
+	// The weight of each soft preference (by its kind, see
+	// "SOFT_PREFERENCE_WEIGHTS"), and the classroom that it requires (or
+	// UNDEFINED_SYMBOL), both indexed as "softPreferences". The maximum score
+	// is the sum of every weight.
+	int * preferenceWeights;
+	SymbolId * preferenceClassrooms;
+	int maximumScore;
+
+	// The score table: the soft preferences (as indexes of "softPreferences",
+	// in ascending order) that each placement satisfies, regardless of the
+	// classroom: [placementFirstMatch[p], placementFirstMatch[p + 1]) of
+	// "placementMatches". It only stores the matches, so it stays small even
+	// if the campus is large.
+	unsigned int * placementFirstMatch;
+	unsigned int * placementMatches;
+	unsigned int matchCount;
+} Model;
+
+/**
+ * Builds the scheduling model of a program. Returns NULL (after logging the
+ * reason) if the program has a contradiction that makes any schedule
+ * impossible (e.g., a course without classroom that fits it).
+ */
+Model * createModel(const Program * program);
+
+/**
+ * Destroy a model and its resources.
+ */
+void destroyModel(Model * model);
+
+/**
+ * Builds the model of a subset of the sessions of other model (in ascending
+ * order, so the sessions of every course stay contiguous), with the same
+ * program and symbols. It only has the soft preferences of the courses of
+ * those sessions (with its own score table), and it borrows the availability
+ * table of the original model, so it must be destroyed first.
+ */
+Model * extractModel(const Model * model, const unsigned int * sessions, const unsigned int sessionCount);
+
+/**
+ * The placement of a session with the given professor and time (with a
+ * binary search, since they are sorted by professor, day and slot), or -1 if
+ * it's not in its domain.
+ */
+int findPlacement(const Model * model, const Session * session, const SymbolId professor, const unsigned int day, const unsigned int slot);
+
+/**
+ * Returns true if a placement of a session satisfies a preference of its
+ * course, regardless of the classroom: the same professor, and inside its
+ * window.
+ */
+boolean placementSatisfies(const Model * model, const unsigned int preference, const unsigned int session, const Placement * placement);
+
+/**
+ * Returns true if the soft preferences have other weights than the default
+ * ones (i.e., the score differs from the amount of satisfied preferences).
+ */
+boolean weighsPreferences();
+
+/**
+ * The score of an assignment of the sessions (the weights of the soft
+ * preferences that it satisfies), with the score table. The amount of those
+ * preferences goes to "satisfied". An unassigned session satisfies nothing.
+ */
+int scoreAssignments(const Model * model, const Assignment * assignments, int * satisfied);
+
+/**
+ * Returns true if a match of the score table (i.e., a soft preference "k"
+ * that a placement satisfies) also holds in a classroom.
+ */
+static inline boolean preferenceHolds(const Model * model, const unsigned int k, const SymbolId classroom) {
+	return model->preferenceClassrooms[k] == UNDEFINED_SYMBOL || model->preferenceClassrooms[k] == classroom;
+}
+
+/**
+ * Returns true if a classroom can host a course (i.e., it has the seats and
+ * the features).
+ */
+static inline boolean courseFits(const Model * model, const SymbolId course, const SymbolId classroom) {
+	return bitsetTest(model->eligibility + course * model->eligibilityWords, (unsigned int) classroom);
+}
+
+/**
+ * Returns true if a classroom is in the domain of a session: its only
+ * classroom (e.g., if a preference pins it), or else any classroom that can
+ * host its course.
+ */
+static inline boolean sessionFits(const Model * model, const Session * session, const SymbolId classroom) {
+	if (session->roomCount <= 1) {
+		return session->roomCount == 1 && model->rooms[session->firstRoom] == classroom;
+	}
+	return courseFits(model, session->course, classroom);
+}
+
+/**
+ * The week-index of the first slot of a placement.
+ */
+static inline unsigned int placementWeekSlot(const Model * model, const Placement * placement) {
+	return placement->day * model->grid.slotsPerDay + placement->slot;
+}
+
+#endif
@@ -0,0 +1,880 @@
+#include "Optimizer.h"
+
+/* MODULE INTERNAL STATE */
+
+static Logger *_logger = NULL;
+
+void initializeOptimizerModule()
+{
+	_logger = createLogger("Optimizer");
+}
+
+void shutdownOptimizerModule()
+{
+	if (_logger != NULL)
+	{
+		destroyLogger(_logger);
+	}
+}
+
+/** PRIVATE FUNCTIONS */
+
+// The open subtrees below this depth are never shared with other workers.
+#define MAXIMUM_SPLIT_DEPTH 64
+
+// The nodes of the search of a feasible completion before it's abandoned.
+#define MAXIMUM_COMPLETION_NODES 20000
+
+/**
+ * The kinds of decisions on a session (see "_collectDecisions").
+ */
+typedef enum
+{
+	// Assign a placement and a classroom.
+	DECISION_ASSIGN,
+
+	// Restrict the domain to the placements that satisfy a preference.
+	DECISION_CLAIM,
+
+	// Remove the placements that satisfy any open preference.
+	DECISION_DEFER
+} DecisionType;
+
+/**
+ * A decision on a session. The preference is an index of the preferences of
+ * the context (only for claims).
+ */
+typedef struct
+{
+	DecisionType type;
+	unsigned int session;
+	unsigned int placement;
+	SymbolId classroom;
+	unsigned int preference;
+} Decision;
+
+/**
+ * An open subtree: the decisions from the root to reach it.
+ */
+typedef struct
+{
+	Decision *path;
+	unsigned int length;
+} Task;
+
+/**
+ * The tasks of a worker. The owner pushes and pops at the bottom (the deepest
+ * subtrees), and the thieves steal from the top (the shallowest ones).
+ */
+typedef struct
+{
+	Mutex mutex;
+	Task *tasks;
+	unsigned int top;
+	unsigned int bottom;
+	unsigned int capacity;
+} TaskDeque;
+
+typedef struct OptimizerWorker OptimizerWorker;
+
+/**
+ * The state shared by every worker.
+ */
+typedef struct
+{
+	const Model *model;
+
+	OptimizerWorker *workers;
+	unsigned int workerCount;
+
+	// The tasks pushed but not finished yet, and the workers without work.
+	Atomic pending;
+	Atomic hungry;
+
+	// Zero if a feasible completion was abandoned (so the incumbent might not
+	// be optimal).
+	Atomic exhaustive;
+
+	// Non-zero once the time limit expires, so every worker stops.
+	Atomic expired;
+
+	// The value of the incumbent (-1 if there is none), its assignment, and
+	// the listener of its improvements.
+	Atomic best;
+	Mutex incumbentMutex;
+	Assignment *incumbent;
+	const ScheduleListener *listener;
+} OptimizerContext;
+
+/**
+ * A worker, with its own solver and the incremental value of its current
+ * (partial) assignment.
+ */
+struct OptimizerWorker
+{
+	OptimizerContext *context;
+	unsigned int index;
+	Solver *solver;
+	TaskDeque deque;
+	unsigned long long random;
+
+	// Sessions that satisfy each preference, and unassigned sessions of each
+	// course. The score of the satisfied preferences, and the weight of the
+	// ones that no session can satisfy anymore.
+	unsigned int *matches;
+	unsigned int *unassigned;
+	int score;
+	int lost;
+
+	// The alive placements of unassigned sessions that satisfy each
+	// preference (regardless of the classroom), updated from the trail.
+	unsigned int *reachable;
+
+	// The sessions that already claimed a preference (or none), and the
+	// sessions that claimed each preference.
+	boolean *decided;
+	unsigned int *claims;
+
+	// The decisions from the root, and the trail-size before each one.
+	Decision *path;
+	unsigned int *marks;
+	unsigned int depth;
+
+	// A stack with the candidate values of every open node.
+	Decision *values;
+	unsigned int valueCount;
+	unsigned int valueCapacity;
+
+	unsigned long long nodes;
+};
+
+static void _countPlacement(OptimizerWorker *worker, const unsigned int placement, const int delta);
+static void _countSession(OptimizerWorker *worker, const unsigned int session, const int delta);
+static void _countTrail(OptimizerWorker *worker, const unsigned int trailMark, const int delta);
+static int _upperBound(const OptimizerWorker *worker);
+static int _selectSession(const OptimizerWorker *worker, boolean *claimable, boolean *completing);
+static boolean _assign(OptimizerWorker *worker, const Decision decision);
+static void _unassign(OptimizerWorker *worker);
+static boolean _isOpen(const OptimizerWorker *worker, const unsigned int k);
+static boolean _restrict(OptimizerWorker *worker, const Decision decision);
+static void _pushDecision(OptimizerWorker *worker, const DecisionType type, const unsigned int session, const unsigned int placement, const SymbolId classroom, const unsigned int preference);
+static unsigned int _collectDecisions(OptimizerWorker *worker, const unsigned int session, const boolean claimable);
+static void _offerIncumbent(OptimizerWorker *worker, const int score);
+static SolverStatus _complete(OptimizerWorker *worker);
+static void _pushTask(OptimizerWorker *worker, const Decision decision);
+static boolean _popTask(OptimizerWorker *worker, Task *task);
+static boolean _stealTask(OptimizerWorker *worker, Task *task);
+static void _branch(OptimizerWorker *worker);
+static void _runTask(OptimizerWorker *worker, const Task *task);
+static void _work(void *argument);
+static unsigned long long _search(OptimizerContext *context);
+
+/**
+ * Adds a placement to the reachable counts of the preferences that it
+ * satisfies (or removes it, with a negative delta).
+ */
+static void _countPlacement(OptimizerWorker *worker, const unsigned int placement, const int delta)
+{
+	const Model *model = worker->context->model;
+	for (unsigned int m = model->placementFirstMatch[placement]; m < model->placementFirstMatch[placement + 1]; ++m)
+	{
+		worker->reachable[model->placementMatches[m]] += delta;
+	}
+}
+
+/**
+ * Counts the alive placements of a session, when it's unassigned (or stops
+ * counting them, when it's assigned).
+ */
+static void _countSession(OptimizerWorker *worker, const unsigned int session, const int delta)
+{
+	const Session *variable = &worker->context->model->sessions[session];
+	for (unsigned int p = variable->firstPlacement; p < variable->firstPlacement + variable->placementCount; ++p)
+	{
+		if (worker->solver->alive[p])
+		{
+			_countPlacement(worker, p, delta);
+		}
+	}
+}
+
+/**
+ * Counts the placements of unassigned sessions pruned since the mark. A
+ * decision calls it with -1 after it propagates, and its undo with +1 before
+ * it restores them, when the same sessions are unassigned.
+ */
+static void _countTrail(OptimizerWorker *worker, const unsigned int trailMark, const int delta)
+{
+	const Solver *solver = worker->solver;
+	for (unsigned int t = trailMark; t < solver->trailSize; ++t)
+	{
+		const unsigned int placement = solver->trail[t];
+		if (solver->assignments[solver->placementSession[placement]].placement == -1)
+		{
+			_countPlacement(worker, placement, delta);
+		}
+	}
+}
+
+/**
+ * The score of the satisfied preferences, plus the weights of the
+ * unsatisfied ones that an unassigned session can still reach (ignoring the
+ * classrooms, so it's optimistic).
+ */
+static int _upperBound(const OptimizerWorker *worker)
+{
+	const Model *model = worker->context->model;
+	int bound = worker->score;
+	for (unsigned int c = 0; c < model->courseCount; ++c)
+	{
+		for (unsigned int k = model->courseFirstPreference[c]; worker->unassigned[c] != 0 && k < model->courseFirstPreference[c + 1]; ++k)
+		{
+			if (worker->matches[k] == 0 && model->preferenceWeights[k] != 0 && worker->reachable[k] != 0)
+			{
+				bound += model->preferenceWeights[k];
+			}
+		}
+	}
+	return bound;
+}
+
+/**
+ * Returns true if a preference is neither satisfied, nor claimed (nor
+ * without weight, so it cannot change the objective).
+ */
+static boolean _isOpen(const OptimizerWorker *worker, const unsigned int k)
+{
+	return worker->matches[k] == 0 && worker->claims[k] == 0 && worker->context->model->preferenceWeights[k] != 0;
+}
+
+/**
+ * Selects the undecided session with the smallest domain among the courses
+ * with open preferences, so the bound tightens near the root. A forced
+ * session (i.e., with a single value) always goes first, as the solver would
+ * select it. Then, the decided sessions are assigned (since their classrooms
+ * can still satisfy their claims), and the rest of the search only needs a
+ * feasible completion.
+ */
+static int _selectSession(const OptimizerWorker *worker, boolean *claimable, boolean *completing)
+{
+	const OptimizerContext *context = worker->context;
+	const Model *model = context->model;
+	const Solver *solver = worker->solver;
+	int selected = -1;
+	for (unsigned int c = 0; c < model->courseCount; ++c)
+	{
+		boolean open = false;
+		for (unsigned int k = model->courseFirstPreference[c]; !open && k < model->courseFirstPreference[c + 1]; ++k)
+		{
+			open = _isOpen(worker, k);
+		}
+		for (unsigned int s = model->courseFirstSession[c]; open && s < model->courseFirstSession[c + 1]; ++s)
+		{
+			if (solver->assignments[s].placement == -1 && !worker->decided[s]
+				&& (selected == -1 || solver->aliveCount[s] < solver->aliveCount[selected]))
+			{
+				selected = s;
+			}
+		}
+	}
+	const int fallback = selectSession(solver);
+	*claimable = selected != -1 && 1 < solver->aliveCount[fallback];
+	*completing = false;
+	if (selected != -1)
+	{
+		return *claimable ? selected : fallback;
+	}
+	for (unsigned int s = 0; s < model->sessionCount; ++s)
+	{
+		if (solver->assignments[s].placement == -1 && worker->decided[s]
+			&& (selected == -1 || solver->aliveCount[s] < solver->aliveCount[selected]))
+		{
+			selected = s;
+		}
+	}
+	*completing = selected == -1;
+	return *completing ? fallback : selected;
+}
+
+/**
+ * Removes the placements of a session that don't satisfy its claimed
+ * preference, or the ones that satisfy any open preference if it defers.
+ */
+static boolean _restrict(OptimizerWorker *worker, const Decision decision)
+{
+	const OptimizerContext *context = worker->context;
+	const Model *model = context->model;
+	const Session *session = &model->sessions[decision.session];
+	boolean consistent = true;
+	for (unsigned int p = session->firstPlacement; consistent && p < session->firstPlacement + session->placementCount; ++p)
+	{
+		boolean keep = true;
+		if (decision.type == DECISION_CLAIM)
+		{
+			keep = placementSatisfies(context->model, model->softPreferences[decision.preference], decision.session, &model->placements[p]);
+		}
+		for (unsigned int m = model->placementFirstMatch[p]; decision.type == DECISION_DEFER && m < model->placementFirstMatch[p + 1]; ++m)
+		{
+			keep = keep && !_isOpen(worker, model->placementMatches[m]);
+		}
+		if (!keep)
+		{
+			consistent = removePlacement(worker->solver, p);
+		}
+	}
+	return consistent;
+}
+
+/**
+ * Takes a decision. An assignment updates the satisfied and lost
+ * preferences.
+ */
+static boolean _assign(OptimizerWorker *worker, const Decision decision)
+{
+	const OptimizerContext *context = worker->context;
+	const Model *model = context->model;
+	worker->path[worker->depth] = decision;
+	worker->marks[worker->depth] = worker->solver->trailSize;
+	worker->depth += 1;
+	if (decision.type != DECISION_ASSIGN)
+	{
+		const boolean consistent = _restrict(worker, decision);
+		_countTrail(worker, worker->marks[worker->depth - 1], -1);
+		worker->decided[decision.session] = true;
+		if (decision.type == DECISION_CLAIM)
+		{
+			worker->claims[decision.preference] += 1;
+		}
+		return consistent;
+	}
+	const SymbolId course = model->sessions[decision.session].course;
+	_countSession(worker, decision.session, -1);
+	const boolean consistent = assignSession(worker->solver, decision.session, decision.placement, decision.classroom);
+	_countTrail(worker, worker->marks[worker->depth - 1], -1);
+	for (unsigned int m = model->placementFirstMatch[decision.placement]; m < model->placementFirstMatch[decision.placement + 1]; ++m)
+	{
+		const unsigned int k = model->placementMatches[m];
+		if (preferenceHolds(model, k, decision.classroom) && worker->matches[k]++ == 0)
+		{
+			worker->score += model->preferenceWeights[k];
+		}
+	}
+	if (--worker->unassigned[course] == 0)
+	{
+		for (unsigned int k = model->courseFirstPreference[course]; k < model->courseFirstPreference[course + 1]; ++k)
+		{
+			worker->lost += worker->matches[k] == 0 ? model->preferenceWeights[k] : 0;
+		}
+	}
+	return consistent;
+}
+
+/**
+ * Undoes the last decision.
+ */
+static void _unassign(OptimizerWorker *worker)
+{
+	const OptimizerContext *context = worker->context;
+	const Model *model = context->model;
+	worker->depth -= 1;
+	const Decision decision = worker->path[worker->depth];
+	_countTrail(worker, worker->marks[worker->depth], 1);
+	if (decision.type != DECISION_ASSIGN)
+	{
+		restorePlacements(worker->solver, worker->marks[worker->depth]);
+		worker->decided[decision.session] = false;
+		if (decision.type == DECISION_CLAIM)
+		{
+			worker->claims[decision.preference] -= 1;
+		}
+		return;
+	}
+	const SymbolId course = model->sessions[decision.session].course;
+	if (worker->unassigned[course]++ == 0)
+	{
+		for (unsigned int k = model->courseFirstPreference[course]; k < model->courseFirstPreference[course + 1]; ++k)
+		{
+			worker->lost -= worker->matches[k] == 0 ? model->preferenceWeights[k] : 0;
+		}
+	}
+	for (unsigned int m = model->placementFirstMatch[decision.placement]; m < model->placementFirstMatch[decision.placement + 1]; ++m)
+	{
+		const unsigned int k = model->placementMatches[m];
+		if (preferenceHolds(model, k, decision.classroom) && --worker->matches[k] == 0)
+		{
+			worker->score -= model->preferenceWeights[k];
+		}
+	}
+	unassignSession(worker->solver, decision.session, worker->marks[worker->depth]);
+	_countSession(worker, decision.session, 1);
+}
+
+static void _pushDecision(OptimizerWorker *worker, const DecisionType type, const unsigned int session, const unsigned int placement, const SymbolId classroom, const unsigned int preference)
+{
+	if (worker->valueCount == worker->valueCapacity)
+	{
+		worker->valueCapacity = worker->valueCapacity < 1024 ? 1024 : 2 * worker->valueCapacity;
+		worker->values = realloc(worker->values, worker->valueCapacity * sizeof(Decision));
+	}
+	Decision *value = &worker->values[worker->valueCount++];
+	value->type = type;
+	value->session = session;
+	value->placement = placement;
+	value->classroom = classroom;
+	value->preference = preference;
+}
+
+/**
+ * Pushes the decisions on a session. A claimable session either claims an
+ * open preference that it can still satisfy, or it defers (so its placements
+ * are branched only if they can change the objective, and the rest is left
+ * for the feasible completion).
+ *
+ * Otherwise, it pushes the values of the session: first, the ones that
+ * satisfy a preference not satisfied yet (so good incumbents appear early),
+ * and then the rest. The room matching chooses the classroom of every
+ * placement, but it's also tried pinned to the classroom of a soft
+ * preference (if it fits).
+ */
+static unsigned int _collectDecisions(OptimizerWorker *worker, const unsigned int session, const boolean claimable)
+{
+	const OptimizerContext *context = worker->context;
+	const Model *model = context->model;
+	const Solver *solver = worker->solver;
+	const Session *variable = &model->sessions[session];
+	const SymbolId only = model->usesClassrooms && variable->roomCount == 1 ? model->rooms[variable->firstRoom] : UNDEFINED_SYMBOL;
+	const unsigned int first = worker->valueCount;
+	if (claimable)
+	{
+		for (unsigned int k = model->courseFirstPreference[variable->course]; k < model->courseFirstPreference[variable->course + 1]; ++k)
+		{
+			for (unsigned int p = variable->firstPlacement; _isOpen(worker, k) && p < variable->firstPlacement + variable->placementCount; ++p)
+			{
+				if (solver->alive[p] && placementSatisfies(context->model, model->softPreferences[k], session, &model->placements[p]))
+				{
+					_pushDecision(worker, DECISION_CLAIM, session, 0, UNDEFINED_SYMBOL, k);
+					break;
+				}
+			}
+		}
+		_pushDecision(worker, DECISION_DEFER, session, 0, UNDEFINED_SYMBOL, 0);
+		return worker->valueCount - first;
+	}
+	for (unsigned int pass = 0; pass < 2; ++pass)
+	{
+		for (unsigned int p = variable->firstPlacement; p < variable->firstPlacement + variable->placementCount; ++p)
+		{
+			if (!solver->alive[p])
+			{
+				continue;
+			}
+			boolean promising = false;
+			for (unsigned int m = model->placementFirstMatch[p]; m < model->placementFirstMatch[p + 1]; ++m)
+			{
+				const unsigned int k = model->placementMatches[m];
+				if (worker->matches[k] != 0)
+				{
+					continue;
+				}
+				const SymbolId preferred = model->preferenceClassrooms[k];
+				if (preferenceHolds(model, k, only))
+				{
+					promising = true;
+				}
+				else if (pass == 0 && sessionFits(model, variable, preferred))
+				{
+					_pushDecision(worker, DECISION_ASSIGN, session, p, preferred, 0);
+				}
+			}
+			if (promising == (pass == 0))
+			{
+				_pushDecision(worker, DECISION_ASSIGN, session, p, only, 0);
+			}
+		}
+	}
+	return worker->valueCount - first;
+}
+
+/**
+ * Replaces the incumbent if the current (complete) assignment, with the
+ * given score, is better.
+ */
+static void _offerIncumbent(OptimizerWorker *worker, const int score)
+{
+	OptimizerContext *context = worker->context;
+	if (score <= atomicLoad(&context->best))
+	{
+		return;
+	}
+	lockMutex(&context->incumbentMutex);
+	if (atomicLoad(&context->best) < score)
+	{
+		memcpy(context->incumbent, worker->solver->assignments, context->model->sessionCount * sizeof(Assignment));
+		atomicStore(&context->best, score);
+		logDebugging(_logger, "The worker %u improves the incumbent: a score of %d of %d.", worker->index, score, context->model->maximumScore);
+		notifySchedule(context->listener, context->model, context->incumbent, score);
+	}
+	unlockMutex(&context->incumbentMutex);
+}
+
+/**
+ * Completes the current assignment with the search of the solver (which
+ * backjumps and learns nogoods), offers it, and undoes it. A completion that
+ * runs out of nodes is abandoned as a whole, so the incumbent might not be
+ * optimal.
+ */
+static SolverStatus _complete(OptimizerWorker *worker)
+{
+	OptimizerContext *context = worker->context;
+	Solver *solver = worker->solver;
+	const unsigned int depth = solver->assignedCount;
+	const unsigned int trailMark = solver->trailSize;
+	const SolverStatus status = completeAssignment(solver, MAXIMUM_COMPLETION_NODES);
+	if (status == SOLVER_SATISFIABLE)
+	{
+		int satisfied = 0;
+		_offerIncumbent(worker, scoreAssignments(context->model, solver->assignments, &satisfied));
+		unassignFrom(solver, depth, trailMark);
+	}
+	// A completion is worth many nodes, so it polls the time limit (and the
+	// budget of the improvement) on its own.
+	if (status == SOLVER_TIMEOUT || isImprovementExpired())
+	{
+		atomicStore(&context->expired, 1);
+	}
+	return status;
+}
+
+/**
+ * Shares an open subtree: the current path, followed by a decision.
+ */
+static void _pushTask(OptimizerWorker *worker, const Decision decision)
+{
+	Task task;
+	task.length = worker->depth + 1;
+	task.path = malloc(task.length * sizeof(Decision));
+	memcpy(task.path, worker->path, worker->depth * sizeof(Decision));
+	task.path[worker->depth] = decision;
+	atomicAdd(&worker->context->pending, 1);
+	TaskDeque *deque = &worker->deque;
+	lockMutex(&deque->mutex);
+	if (deque->bottom == deque->capacity)
+	{
+		deque->capacity = deque->capacity < 64 ? 64 : 2 * deque->capacity;
+		deque->tasks = realloc(deque->tasks, deque->capacity * sizeof(Task));
+	}
+	deque->tasks[deque->bottom++] = task;
+	unlockMutex(&deque->mutex);
+}
+
+static boolean _popTask(OptimizerWorker *worker, Task *task)
+{
+	TaskDeque *deque = &worker->deque;
+	boolean found = false;
+	lockMutex(&deque->mutex);
+	if (deque->top < deque->bottom)
+	{
+		*task = deque->tasks[--deque->bottom];
+		found = true;
+	}
+	if (deque->top == deque->bottom)
+	{
+		deque->top = deque->bottom = 0;
+	}
+	unlockMutex(&deque->mutex);
+	return found;
+}
+
+static boolean _stealTask(OptimizerWorker *worker, Task *task)
+{
+	OptimizerContext *context = worker->context;
+	worker->random = 6364136223846793005ULL * worker->random + 1442695040888963407ULL;
+	const unsigned int offset = (unsigned int)(worker->random >> 33);
+	for (unsigned int k = 0; k < context->workerCount; ++k)
+	{
+		OptimizerWorker *victim = &context->workers[(offset + k) % context->workerCount];
+		if (victim == worker)
+		{
+			continue;
+		}
+		TaskDeque *deque = &victim->deque;
+		boolean found = false;
+		lockMutex(&deque->mutex);
+		if (deque->top < deque->bottom)
+		{
+			*task = deque->tasks[deque->top++];
+			found = true;
+		}
+		unlockMutex(&deque->mutex);
+		if (found)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * The depth-first branch-and-bound. If other workers are hungry, the
+ * remaining values of a shallow node are shared instead of explored. Once no
+ * decision can change the objective, the node is completed by the solver.
+ */
+static void _branch(OptimizerWorker *worker)
+{
+	OptimizerContext *context = worker->context;
+	if (_upperBound(worker) <= atomicLoad(&context->best) || atomicLoad(&context->expired) != 0)
+	{
+		return;
+	}
+	boolean claimable = false;
+	boolean completing = false;
+	const int session = _selectSession(worker, &claimable, &completing);
+	if (session == -1)
+	{
+		_offerIncumbent(worker, worker->score);
+		return;
+	}
+	worker->nodes += 1;
+	if (worker->nodes % DEADLINE_POLL_NODES == 0 && isImprovementExpired())
+	{
+		atomicStore(&context->expired, 1);
+		return;
+	}
+	if (completing)
+	{
+		if (_complete(worker) == SOLVER_CANCELLED)
+		{
+			atomicStore(&context->exhaustive, 0);
+		}
+		return;
+	}
+	if (claimable && _complete(worker) == SOLVER_UNSATISFIABLE)
+	{
+		return;
+	}
+	const unsigned int first = worker->valueCount;
+	unsigned int count = _collectDecisions(worker, session, claimable);
+	for (unsigned int k = 0; k < count; ++k)
+	{
+		if (context->model->maximumScore - worker->lost <= atomicLoad(&context->best) || atomicLoad(&context->expired) != 0)
+		{
+			break;
+		}
+		if (k + 1 < count && worker->depth < MAXIMUM_SPLIT_DEPTH && 0 < atomicLoad(&context->hungry))
+		{
+			for (unsigned int shared = count - 1; k < shared; --shared)
+			{
+				_pushTask(worker, worker->values[first + shared]);
+			}
+			count = k + 1;
+		}
+		if (_assign(worker, worker->values[first + k]))
+		{
+			_branch(worker);
+		}
+		_unassign(worker);
+	}
+	worker->valueCount = first;
+}
+
+/**
+ * Replays the path of a task from the root, and explores its subtree.
+ */
+static void _runTask(OptimizerWorker *worker, const Task *task)
+{
+	boolean consistent = true;
+	for (unsigned int k = 0; consistent && k < task->length; ++k)
+	{
+		consistent = _assign(worker, task->path[k]);
+	}
+	if (consistent)
+	{
+		_branch(worker);
+	}
+	while (0 < worker->depth)
+	{
+		_unassign(worker);
+	}
+}
+
+/**
+ * The loop of a worker: run its own tasks, steal the tasks of others, and
+ * finish when there are no pending tasks left.
+ */
+static void _work(void *argument)
+{
+	OptimizerWorker *worker = argument;
+	OptimizerContext *context = worker->context;
+	boolean hungry = false;
+	while (true)
+	{
+		Task task;
+		if (_popTask(worker, &task) || _stealTask(worker, &task))
+		{
+			if (hungry)
+			{
+				atomicAdd(&context->hungry, -1);
+				hungry = false;
+			}
+			_runTask(worker, &task);
+			free(task.path);
+			atomicAdd(&context->pending, -1);
+			continue;
+		}
+		if (atomicLoad(&context->pending) == 0)
+		{
+			break;
+		}
+		if (!hungry)
+		{
+			atomicAdd(&context->hungry, 1);
+			hungry = true;
+		}
+		yieldThread();
+	}
+	if (hungry)
+	{
+		atomicAdd(&context->hungry, -1);
+	}
+}
+
+/**
+ * Explores the whole tree with one worker per thread (see "workerCount"), and
+ * returns the amount of nodes explored.
+ */
+static unsigned long long _search(OptimizerContext *context)
+{
+	const Model *model = context->model;
+	context->workers = calloc(context->workerCount, sizeof(OptimizerWorker));
+	logDebugging(_logger, "Optimizing %u soft preference(s) with %u worker(s)...", context->model->softPreferenceCount, context->workerCount);
+
+	const SolverOptions options = defaultSolverOptions();
+	for (unsigned int k = 0; k < context->workerCount; ++k)
+	{
+		OptimizerWorker *worker = &context->workers[k];
+		worker->context = context;
+		worker->index = k;
+		worker->random = k + 1;
+		worker->solver = createSolver(model, &options);
+		worker->matches = calloc(1 + context->model->softPreferenceCount, sizeof(unsigned int));
+		worker->unassigned = calloc(1 + model->courseCount, sizeof(unsigned int));
+		// A session can take two decisions: a claim (or deferral), and a value.
+		worker->path = malloc((1 + 2 * model->sessionCount) * sizeof(Decision));
+		worker->marks = malloc((1 + 2 * model->sessionCount) * sizeof(unsigned int));
+		worker->decided = calloc(1 + model->sessionCount, sizeof(boolean));
+		worker->claims = calloc(1 + context->model->softPreferenceCount, sizeof(unsigned int));
+		worker->reachable = calloc(1 + model->softPreferenceCount, sizeof(unsigned int));
+		for (unsigned int p = 0; p < model->placementCount; ++p)
+		{
+			_countPlacement(worker, p, 1);
+		}
+		for (unsigned int c = 0; c < model->courseCount; ++c)
+		{
+			worker->unassigned[c] = model->courseFirstSession[c + 1] - model->courseFirstSession[c];
+			if (worker->unassigned[c] == 0)
+			{
+				// The preferences of unscheduled courses are lost from the start.
+				for (unsigned int k = model->courseFirstPreference[c]; k < model->courseFirstPreference[c + 1]; ++k)
+				{
+					worker->lost += model->preferenceWeights[k];
+				}
+			}
+		}
+		createMutex(&worker->deque.mutex);
+	}
+
+	// The root task: an empty path.
+	Task root;
+	root.length = 0;
+	root.path = NULL;
+	atomicAdd(&context->pending, 1);
+	context->workers[0].deque.tasks = malloc(64 * sizeof(Task));
+	context->workers[0].deque.capacity = 64;
+	context->workers[0].deque.tasks[context->workers[0].deque.bottom++] = root;
+
+	// The workers that cannot be started own no tasks, so they are harmless.
+	Thread *threads = calloc(context->workerCount, sizeof(Thread));
+	boolean *started = calloc(context->workerCount, sizeof(boolean));
+	for (unsigned int k = 1; k < context->workerCount; ++k)
+	{
+		started[k] = createThread(&threads[k], _work, &context->workers[k]);
+		if (!started[k])
+		{
+			logWarning(_logger, "The worker %u could not be started.", k);
+		}
+	}
+	_work(&context->workers[0]);
+	for (unsigned int k = 1; k < context->workerCount; ++k)
+	{
+		if (started[k])
+		{
+			joinThread(&threads[k]);
+		}
+	}
+
+	unsigned long long nodes = 0;
+	for (unsigned int k = 0; k < context->workerCount; ++k)
+	{
+		OptimizerWorker *worker = &context->workers[k];
+		nodes += worker->nodes + worker->solver->nodes;
+		destroySolver(worker->solver);
+		free(worker->matches);
+		free(worker->unassigned);
+		free(worker->path);
+		free(worker->marks);
+		free(worker->decided);
+		free(worker->claims);
+		free(worker->reachable);
+		free(worker->values);
+		free(worker->deque.tasks);
+		destroyMutex(&worker->deque.mutex);
+	}
+	free(context->workers);
+	free(threads);
+	free(started);
+	return nodes;
+}
+
+/** PUBLIC FUNCTIONS */
+
+Optimization *optimize(const Model *model, const Assignment *seed, const unsigned int threadCount, const ScheduleListener *listener)
+{
+	OptimizerContext context;
+	memset(&context, 0, sizeof(OptimizerContext));
+	context.model = model;
+	context.workerCount = threadCount < 1 ? 1 : threadCount;
+	context.best = -1;
+	context.exhaustive = 1;
+	context.listener = listener;
+	createMutex(&context.incumbentMutex);
+
+	Optimization *optimization = calloc(1, sizeof(Optimization));
+	optimization->status = SOLVER_SATISFIABLE;
+	optimization->preferenceCount = model->softPreferenceCount;
+	optimization->maximumScore = model->maximumScore;
+	context.incumbent = calloc(1 + model->sessionCount, sizeof(Assignment));
+	memcpy(context.incumbent, seed, model->sessionCount * sizeof(Assignment));
+	context.best = scoreAssignments(model, context.incumbent, &optimization->satisfied);
+	logDebugging(_logger, "The first schedule satisfies %d of %u soft preference(s), with a score of %ld.", optimization->satisfied, model->softPreferenceCount, context.best);
+	notifySchedule(listener, model, context.incumbent, (int)context.best);
+	optimization->nodes = _search(&context);
+	optimization->score = scoreAssignments(model, context.incumbent, &optimization->satisfied);
+	optimization->optimal = atomicLoad(&context.exhaustive) != 0 && atomicLoad(&context.expired) == 0;
+	if (atomicLoad(&context.expired) != 0)
+	{
+		logInformation(_logger, "The time limit expires, so the optimization stops with %d of %u soft preference(s).", optimization->satisfied, model->softPreferenceCount);
+	}
+	optimization->assignments = context.incumbent;
+	logDebugging(_logger, "The optimization is done after %llu node(s).", optimization->nodes);
+	destroyMutex(&context.incumbentMutex);
+	return optimization;
+}
+
+void destroyOptimization(Optimization *optimization)
+{
+	if (optimization != NULL)
+	{
+		free(optimization->assignments);
+		free(optimization);
+	}
+}
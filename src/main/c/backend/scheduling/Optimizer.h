@@ -0,0 +1,81 @@
+#ifndef OPTIMIZER_HEADER
+#define OPTIMIZER_HEADER
+
+#include "../../shared/Environment.h"
+#include "../../shared/Logger.h"
+#include "../../shared/Thread.h"
+#include "../../shared/Type.h"
+#include "Deadline.h"
+#include "Model.h"
+#include "Solver.h"
+
+/** Initialize module's internal state. */
+void initializeOptimizerModule();
+
+/** Shutdown module's internal state. */
+void shutdownOptimizerModule();
+
+/**
+ * The best schedule found by the optimizer, as an assignment of every session
+ * of the model (NULL if there is no schedule at all), with the amount of soft
+ * preferences that it satisfies and its score (the sum of their weights; see
+ * "SOFT_PREFERENCE_WEIGHTS").
+ */
+typedef struct {
+	SolverStatus status;
+	Assignment * assignments;
+	int satisfied;
+	unsigned int preferenceCount;
+	int score;
+	int maximumScore;
+	boolean optimal;
+	unsigned long long nodes;
+} Optimization;
+
+/**
+ * Receives every strictly better schedule of a model as soon as it's found
+ * (e.g., to stream it), with its score (see "scoreAssignments"). It
+ * may be called from any thread, but never concurrently for the same search.
+ */
+typedef struct {
+	void (* function)(const Model * model, const Assignment * assignments, const int score, void * argument);
+	void * argument;
+} ScheduleListener;
+
+/**
+ * Notifies a listener (if it's not NULL).
+ */
+static inline void notifySchedule(const ScheduleListener * listener, const Model * model, const Assignment * assignments, const int score) {
+	if (listener != NULL) {
+		listener->function(model, assignments, score, listener->argument);
+	}
+}
+
+/**
+ * Searches the schedule with the best score of its soft preferences (by
+ * default, the one that satisfies the most of them), subject to every hard
+ * constraint, with a parallel branch-and-bound (one worker per thread, with
+ * at most "threadCount" threads).
+ *
+ * The first incumbent is a feasible assignment of every session (e.g., the
+ * schedule of the portfolio, improved by the local search), so the bound
+ * prunes from the start. The upper bound of a node is the score of the soft
+ * preferences already satisfied, plus the weights of the ones that an
+ * unassigned session can still reach (every score comes from the score table
+ * of the model). The workers share the incumbent atomically, and they
+ * balance the work by stealing the shallowest open subtrees of each other.
+ * Every claim is probed with a bounded search of the solver, which completes
+ * the node (as a new incumbent) or proves that it has no completion. Every
+ * new incumbent (including the first one) goes to the listener.
+ *
+ * If the time limit expires (see "SOLVER_TIME_LIMIT"), the workers stop and
+ * the incumbent is returned, without proving its optimality.
+ */
+Optimization * optimize(const Model * model, const Assignment * seed, const unsigned int threadCount, const ScheduleListener * listener);
+
+/**
+ * Destroy an optimization and its resources.
+ */
+void destroyOptimization(Optimization * optimization);
+
+#endif
@@ -0,0 +1,191 @@
+#include "Partition.h"
+
+/* MODULE INTERNAL STATE */
+
+static Logger *_logger = NULL;
+static unsigned int _classesPerDay = 1;
+
+void initializePartitionModule()
+{
+	_logger = createLogger("Partition");
+	const int classes = getIntegerOrDefault("CLASSES_PER_DAY", (int)_classesPerDay);
+	if (classes < 1 || 255 < classes)
+	{
+		logWarning(_logger, "Invalid amount of classes per day: %d (using %u instead).", classes, _classesPerDay);
+	}
+	else
+	{
+		_classesPerDay = (unsigned int)classes;
+	}
+}
+
+void shutdownPartitionModule()
+{
+	if (_logger != NULL)
+	{
+		destroyLogger(_logger);
+	}
+}
+
+/** PRIVATE FUNCTIONS */
+
+static void _store(PartitionEntry *entry, const unsigned int *parts, const unsigned int size);
+static void _enumerate(PartitionEntry *entry, unsigned int *prefix, const unsigned int size, const unsigned int remaining, const unsigned int partsLeft, const unsigned int upper);
+static unsigned long long _count(const unsigned int length, const unsigned int minimum, const unsigned int maximum, const unsigned int fewest, const unsigned int most);
+static PartitionEntry *_createEntry(const unsigned int length, const unsigned int minimum, const unsigned int maximum, const unsigned int maximumParts);
+
+static void _store(PartitionEntry *entry, const unsigned int *parts, const unsigned int size)
+{
+	if (entry->partCapacity < entry->partCount + size)
+	{
+		while (entry->partCapacity < entry->partCount + size)
+		{
+			entry->partCapacity = entry->partCapacity < 64 ? 64 : 2 * entry->partCapacity;
+		}
+		entry->parts = realloc(entry->parts, entry->partCapacity * sizeof(unsigned int));
+	}
+	memcpy(entry->parts + entry->partCount, parts, size * sizeof(unsigned int));
+	entry->partCount += size;
+	entry->count += 1;
+	entry->starts[entry->count] = entry->partCount;
+}
+
+/**
+ * Stores the partitions of the remaining length in exactly "partsLeft"
+ * classes of at most "upper" slots, after the prefix (in lexicographic
+ * order). A class is never shorter than the remaining length over the
+ * classes left, so every branch reaches at least one partition.
+ */
+static void _enumerate(PartitionEntry *entry, unsigned int *prefix, const unsigned int size, const unsigned int remaining, const unsigned int partsLeft, const unsigned int upper)
+{
+	if (partsLeft == 0)
+	{
+		_store(entry, prefix, size);
+		return;
+	}
+	const unsigned int balanced = (remaining + partsLeft - 1) / partsLeft;
+	const unsigned int lowest = balanced < entry->minimum ? entry->minimum : balanced;
+	const unsigned int rest = (partsLeft - 1) * entry->minimum;
+	const unsigned int highest = remaining < rest ? 0 : (upper < remaining - rest ? upper : remaining - rest);
+	for (unsigned int part = lowest; part <= highest && entry->count < MAXIMUM_PARTITIONS; ++part)
+	{
+		prefix[size] = part;
+		_enumerate(entry, prefix, size + 1, remaining - part, partsLeft - 1, part);
+	}
+}
+
+/**
+ * Counts the partitions of a length in [fewest, most] classes of [minimum,
+ * maximum] slots, where "ways[k][n]" is the amount of multisets of k classes
+ * (of the lengths considered so far) that last n slots.
+ */
+static unsigned long long _count(const unsigned int length, const unsigned int minimum, const unsigned int maximum, const unsigned int fewest, const unsigned int most)
+{
+	unsigned long long *ways = calloc((most + 1) * (length + 1), sizeof(unsigned long long));
+	ways[0] = 1;
+	for (unsigned int part = minimum; part <= maximum && part <= length; ++part)
+	{
+		for (unsigned int k = 1; k <= most; ++k)
+		{
+			for (unsigned int n = part; n <= length; ++n)
+			{
+				ways[k * (length + 1) + n] += ways[(k - 1) * (length + 1) + n - part];
+			}
+		}
+	}
+	unsigned long long total = 0;
+	for (unsigned int k = fewest; k <= most; ++k)
+	{
+		total += ways[k * (length + 1) + length];
+	}
+	free(ways);
+	return total;
+}
+
+static PartitionEntry *_createEntry(const unsigned int length, const unsigned int minimum, const unsigned int maximum, const unsigned int maximumParts)
+{
+	PartitionEntry *entry = calloc(1, sizeof(PartitionEntry));
+	entry->length = length;
+	entry->minimum = minimum == 0 ? 1 : minimum;
+	entry->maximum = maximum;
+	entry->maximumParts = maximumParts;
+	entry->starts = calloc(MAXIMUM_PARTITIONS + 1, sizeof(unsigned int));
+	if (length == 0 || maximum < entry->minimum)
+	{
+		return entry;
+	}
+	const unsigned int fewest = (length + maximum - 1) / maximum;
+	const unsigned int most = length / entry->minimum < maximumParts ? length / entry->minimum : maximumParts;
+	if (most < fewest)
+	{
+		return entry;
+	}
+	unsigned int *prefix = calloc(most + 1, sizeof(unsigned int));
+	for (unsigned int k = fewest; k <= most && entry->count < MAXIMUM_PARTITIONS; ++k)
+	{
+		_enumerate(entry, prefix, 0, length, k, maximum);
+	}
+	free(prefix);
+	entry->total = _count(length, entry->minimum, maximum, fewest, most);
+	return entry;
+}
+
+/** PUBLIC FUNCTIONS */
+
+unsigned int classesPerDay()
+{
+	return _classesPerDay;
+}
+
+PartitionTable *createPartitionTable()
+{
+	return calloc(1, sizeof(PartitionTable));
+}
+
+void destroyPartitionTable(PartitionTable *table)
+{
+	if (table != NULL)
+	{
+		for (unsigned int k = 0; k < table->count; ++k)
+		{
+			free(table->entries[k]->parts);
+			free(table->entries[k]->starts);
+			free(table->entries[k]);
+		}
+		free(table->entries);
+		free(table);
+	}
+}
+
+const PartitionEntry *findPartitions(PartitionTable *table, const unsigned int length, const unsigned int minimum, const unsigned int maximum, const unsigned int maximumParts)
+{
+	table->lookups += 1;
+	for (unsigned int k = 0; k < table->count; ++k)
+	{
+		const PartitionEntry *entry = table->entries[k];
+		if (entry->length == length && entry->minimum == (minimum == 0 ? 1 : minimum) && entry->maximum == maximum && entry->maximumParts == maximumParts)
+		{
+			return entry;
+		}
+	}
+	if (table->count == table->capacity)
+	{
+		table->capacity = table->capacity < 16 ? 16 : 2 * table->capacity;
+		table->entries = realloc(table->entries, table->capacity * sizeof(PartitionEntry *));
+	}
+	table->entries[table->count] = _createEntry(length, minimum, maximum, maximumParts);
+	return table->entries[table->count++];
+}
+
+void logPartitionTable(const PartitionTable *table, const unsigned int granularity)
+{
+	unsigned long long total = 0;
+	for (unsigned int k = 0; k < table->count; ++k)
+	{
+		const PartitionEntry *entry = table->entries[k];
+		total += entry->total;
+		logDebugging(_logger, "%u minute(s) in at most %u class(es) of %u to %u minute(s): %llu split(s).",
+					 entry->length * granularity, entry->maximumParts, entry->minimum * granularity, entry->maximum * granularity, entry->total);
+	}
+	logDebugging(_logger, "The partition table has %u entr(ies) with %llu split(s), for %llu lookup(s).", table->count, total, table->lookups);
+}
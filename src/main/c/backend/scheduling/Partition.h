@@ -0,0 +1,89 @@
+#ifndef PARTITION_HEADER
+#define PARTITION_HEADER
+
+#include "../../shared/Environment.h"
+#include "../../shared/Logger.h"
+#include "../../shared/Type.h"
+#include <stdlib.h>
+#include <string.h>
+
+/** Initialize module's internal state. */
+void initializePartitionModule();
+
+/** Shutdown module's internal state. */
+void shutdownPartitionModule();
+
+/**
+ * The maximum amount of partitions that an entry of the table stores (the
+ * remaining ones are only counted).
+ */
+#define MAXIMUM_PARTITIONS 256
+
+/**
+ * The ways to split the hours of a course (as a length in slots) in classes
+ * within the class duration, with at most "maximumParts" classes. Every
+ * partition is a non-increasing sequence of lengths, and they are sorted by
+ * amount of classes, and then by their longest classes (in lexicographic
+ * order), so the first one is the most balanced split in the fewest classes.
+ *
+ * The partition k is [parts + starts[k], parts + starts[k + 1]).
+ */
+typedef struct {
+	unsigned int length;
+	unsigned int minimum;
+	unsigned int maximum;
+	unsigned int maximumParts;
+
+	unsigned int * parts;
+	unsigned int partCount;
+	unsigned int partCapacity;
+	unsigned int * starts;
+	unsigned int count;
+
+	// The amount of partitions, including the ones that are not stored.
+	unsigned long long total;
+} PartitionEntry;
+
+/**
+ * The partitions of every distinct combination of length, class duration and
+ * maximum amount of classes that was looked up, computed only once.
+ */
+typedef struct {
+	PartitionEntry ** entries;
+	unsigned int count;
+	unsigned int capacity;
+
+	unsigned long long lookups;
+} PartitionTable;
+
+/**
+ * The maximum amount of classes of a course in the same day (see
+ * "CLASSES_PER_DAY").
+ */
+unsigned int classesPerDay();
+
+/**
+ * Creates an empty table.
+ */
+PartitionTable * createPartitionTable();
+
+/**
+ * Destroy a table and its entries.
+ */
+void destroyPartitionTable(PartitionTable * table);
+
+/**
+ * The partitions of a length in classes of [minimum, maximum] slots, with at
+ * most "maximumParts" classes (an entry without partitions if there is no
+ * such split). The entry is computed on the first lookup, and it belongs to
+ * the table.
+ */
+const PartitionEntry * findPartitions(PartitionTable * table, const unsigned int length, const unsigned int minimum, const unsigned int maximum, const unsigned int maximumParts);
+
+/**
+ * Logs the size of a table (its entries, and the partitions of each one), at
+ * debugging level.
+ */
+void logPartitionTable(const PartitionTable * table, const unsigned int granularity);
+
+#endif
@@ -0,0 +1,142 @@
+#include "Portfolio.h"
+
+/* MODULE INTERNAL STATE */
+
+static Logger *_logger = NULL;
+static unsigned long long _seed = 1;
+
+void initializePortfolioModule()
+{
+	_logger = createLogger("Portfolio");
+	_seed = (unsigned long long)getIntegerOrDefault("SOLVER_SEED", (int)_seed);
+}
+
+void shutdownPortfolioModule()
+{
+	if (_logger != NULL)
+	{
+		destroyLogger(_logger);
+	}
+}
+
+/** PRIVATE FUNCTIONS */
+
+/**
+ * A search of the portfolio, and its result.
+ */
+typedef struct
+{
+	const Model *model;
+	unsigned int index;
+	SolverOptions options;
+	Solver *solver;
+	SolverStatus status;
+	Atomic *winner;
+	Atomic *cancelled;
+} PortfolioWorker;
+
+/**
+ * The strategies of the portfolio. The first one is the same of a sequential
+ * search, so a single thread behaves exactly like the plain solver.
+ */
+static const VariableOrdering _variableOrderings[] = {
+	VARIABLE_MINIMUM_DOMAIN,
+	VARIABLE_MINIMUM_DOMAIN_RANDOM_TIES,
+	VARIABLE_DOMAIN_OVER_DEGREE,
+	VARIABLE_MINIMUM_DOMAIN,
+	VARIABLE_DOMAIN_OVER_DEGREE,
+	VARIABLE_MINIMUM_DOMAIN_RANDOM_TIES};
+
+static const ValueOrdering _valueOrderings[] = {
+	VALUE_IN_ORDER,
+	VALUE_RANDOM_ROTATION,
+	VALUE_IN_ORDER,
+	VALUE_REVERSE_ORDER,
+	VALUE_RANDOM_ROTATION,
+	VALUE_IN_ORDER};
+
+#define STRATEGY_COUNT (sizeof(_valueOrderings) / sizeof(ValueOrdering))
+
+static void _work(void *argument);
+
+/**
+ * Runs a search. The first search that finishes (with or without a schedule,
+ * since the search is complete) becomes the winner, and cancels the others.
+ */
+static void _work(void *argument)
+{
+	PortfolioWorker *worker = argument;
+	worker->solver = createSolver(worker->model, &worker->options);
+	worker->status = solve(worker->solver);
+	if (worker->status != SOLVER_CANCELLED && atomicCompareAndSwap(worker->winner, -1, worker->index))
+	{
+		atomicStore(worker->cancelled, 1);
+	}
+}
+
+/** PUBLIC FUNCTIONS */
+
+Solver *solvePortfolio(const Model *model, const unsigned int threadCount, SolverStatus *status)
+{
+	const unsigned int workerCount = threadCount < 1 ? 1 : threadCount;
+	Atomic winner = -1;
+	Atomic cancelled = 0;
+	PortfolioWorker *workers = calloc(workerCount, sizeof(PortfolioWorker));
+	Thread *threads = calloc(workerCount, sizeof(Thread));
+	unsigned int startedCount = 0;
+	for (unsigned int k = 0; k < workerCount; ++k)
+	{
+		PortfolioWorker *worker = &workers[k];
+		worker->model = model;
+		worker->index = k;
+		worker->options = defaultSolverOptions();
+		worker->options.variableOrdering = _variableOrderings[k % STRATEGY_COUNT];
+		worker->options.valueOrdering = _valueOrderings[k % STRATEGY_COUNT];
+		worker->options.seed = _seed + k;
+		worker->options.cancelled = &cancelled;
+		worker->winner = &winner;
+		worker->cancelled = &cancelled;
+		worker->status = SOLVER_CANCELLED;
+	}
+	if (1 < workerCount)
+	{
+		logDebugging(_logger, "Running a portfolio of %u searches...", workerCount);
+		while (startedCount < workerCount && createThread(&threads[startedCount], _work, &workers[startedCount]))
+		{
+			++startedCount;
+		}
+		if (startedCount < workerCount)
+		{
+			logWarning(_logger, "Only %u of %u searches could be started.", startedCount, workerCount);
+		}
+		for (unsigned int k = 0; k < startedCount; ++k)
+		{
+			joinThread(&threads[k]);
+		}
+	}
+	if (startedCount == 0)
+	{
+		_work(&workers[0]);
+		startedCount = 1;
+	}
+
+	const long index = atomicLoad(&winner);
+	Solver *solver = NULL;
+	*status = SOLVER_CANCELLED;
+	for (unsigned int k = 0; k < startedCount; ++k)
+	{
+		if ((long)k == index)
+		{
+			solver = workers[k].solver;
+			*status = workers[k].status;
+			logDebugging(_logger, "The search %u wins after %llu node(s).", k, solver->nodes);
+		}
+		else
+		{
+			destroySolver(workers[k].solver);
+		}
+	}
+	free(threads);
+	free(workers);
+	return solver;
+}
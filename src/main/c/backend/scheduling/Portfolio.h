@@ -0,0 +1,27 @@
+#ifndef PORTFOLIO_HEADER
+#define PORTFOLIO_HEADER
+
+#include "../../shared/Environment.h"
+#include "../../shared/Logger.h"
+#include "../../shared/Thread.h"
+#include "../../shared/Type.h"
+#include "Model.h"
+#include "Solver.h"
+
+/** Initialize module's internal state. */
+void initializePortfolioModule();
+
+/** Shutdown module's internal state. */
+void shutdownPortfolioModule();
+
+/**
+ * Runs independent searches over the same model, one per thread (at most
+ * "threadCount", e.g., "solverThreads"), each one with a different strategy
+ * and seed (see "SOLVER_SEED"). The first search that finishes wins, and the
+ * others are cancelled.
+ *
+ * Returns the winning solver (to be destroyed by the caller), and its status.
+ */
+Solver * solvePortfolio(const Model * model, const unsigned int threadCount, SolverStatus * status);
+
+#endif
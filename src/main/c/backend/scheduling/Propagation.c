@@ -0,0 +1,374 @@
+#include "Propagation.h"
+
+/* MODULE INTERNAL STATE */
+
+static Logger *_logger = NULL;
+
+void initializePropagationModule()
+{
+	_logger = createLogger("Propagation");
+}
+
+void shutdownPropagationModule()
+{
+	if (_logger != NULL)
+	{
+		destroyLogger(_logger);
+	}
+}
+
+/** PRIVATE FUNCTIONS */
+
+/**
+ * The state of the propagation: the placements still alive, the sessions
+ * related by professor or pinned classroom, and a queue of the sessions
+ * whose domains changed.
+ */
+typedef struct
+{
+	Model *model;
+	unsigned char *alive;
+	unsigned int *aliveCount;
+
+	// The sessions with a placement of each professor: [professorFirst[p],
+	// professorFirst[p + 1]).
+	unsigned int *professorFirst;
+	unsigned int *professorSessions;
+
+	// The sessions with a single possible classroom, by classroom.
+	unsigned int *classroomFirst;
+	unsigned int *classroomSessions;
+
+	unsigned int *queue;
+	unsigned int head;
+	unsigned int size;
+	boolean *queued;
+
+	unsigned long long revisions;
+} Propagator;
+
+static boolean _isSingleRoom(const Model *model, const Session *session);
+static void _indexSessions(Propagator *propagator);
+static boolean _conflicts(const Model *model, const unsigned int session, const unsigned int placement, const unsigned int other, const unsigned int otherPlacement);
+static int _singleProfessor(const Propagator *propagator, const unsigned int session);
+static boolean _revise(Propagator *propagator, const unsigned int session, const unsigned int other);
+static void _enqueue(Propagator *propagator, const unsigned int session);
+static boolean _reviseNeighbors(Propagator *propagator, const unsigned int other, int *wipedOut);
+static void _compact(Propagator *propagator);
+static unsigned int _smallestDomain(const Model *model);
+
+static boolean _isSingleRoom(const Model *model, const Session *session)
+{
+	return model->usesClassrooms && session->roomCount == 1;
+}
+
+/**
+ * Builds the CSR indexes of the sessions by professor (with any placement of
+ * that professor), and by single classroom.
+ */
+static void _indexSessions(Propagator *propagator)
+{
+	const Model *model = propagator->model;
+	propagator->professorFirst = calloc(model->professorCount + 2, sizeof(unsigned int));
+	propagator->classroomFirst = calloc(model->classroomCount + 2, sizeof(unsigned int));
+	for (unsigned int pass = 0; pass < 2; ++pass)
+	{
+		for (unsigned int s = 0; s < model->sessionCount; ++s)
+		{
+			const Session *session = &model->sessions[s];
+			for (unsigned int p = session->firstPlacement; p < session->firstPlacement + session->placementCount; ++p)
+			{
+				const SymbolId professor = model->placements[p].professor;
+				if (p != session->firstPlacement && model->placements[p - 1].professor == professor)
+				{
+					continue;
+				}
+				if (pass == 0)
+				{
+					propagator->professorFirst[professor + 2] += 1;
+				}
+				else
+				{
+					propagator->professorSessions[propagator->professorFirst[professor + 1]++] = s;
+				}
+			}
+			if (_isSingleRoom(model, session))
+			{
+				const SymbolId classroom = model->rooms[session->firstRoom];
+				if (pass == 0)
+				{
+					propagator->classroomFirst[classroom + 2] += 1;
+				}
+				else
+				{
+					propagator->classroomSessions[propagator->classroomFirst[classroom + 1]++] = s;
+				}
+			}
+		}
+		if (pass == 0)
+		{
+			for (unsigned int p = 0; p < model->professorCount; ++p)
+			{
+				propagator->professorFirst[p + 2] += propagator->professorFirst[p + 1];
+			}
+			for (unsigned int r = 0; r < model->classroomCount; ++r)
+			{
+				propagator->classroomFirst[r + 2] += propagator->classroomFirst[r + 1];
+			}
+			propagator->professorSessions = calloc(1 + propagator->professorFirst[model->professorCount + 1], sizeof(unsigned int));
+			propagator->classroomSessions = calloc(1 + propagator->classroomFirst[model->classroomCount + 1], sizeof(unsigned int));
+		}
+	}
+}
+
+/**
+ * Returns true if two placements of different sessions cannot be part of the
+ * same schedule.
+ */
+static boolean _conflicts(const Model *model, const unsigned int session, const unsigned int placement, const unsigned int other, const unsigned int otherPlacement)
+{
+	const Session *first = &model->sessions[session];
+	const Session *second = &model->sessions[other];
+	const Placement *firstValue = &model->placements[placement];
+	const Placement *secondValue = &model->placements[otherPlacement];
+	if (firstValue->day != secondValue->day)
+	{
+		return false;
+	}
+	if (first->course == second->course && model->sessionsPerDay == 1)
+	{
+		return true;
+	}
+	if (secondValue->slot + second->length <= firstValue->slot || firstValue->slot + first->length <= secondValue->slot)
+	{
+		return false;
+	}
+	if (first->course == second->course || firstValue->professor == secondValue->professor)
+	{
+		return true;
+	}
+	return _isSingleRoom(model, first) && _isSingleRoom(model, second) && model->rooms[first->firstRoom] == model->rooms[second->firstRoom];
+}
+
+/**
+ * The only professor of the domain of a session, or -1 if it has more than
+ * one.
+ */
+static int _singleProfessor(const Propagator *propagator, const unsigned int session)
+{
+	const Model *model = propagator->model;
+	const Session *variable = &model->sessions[session];
+	int professor = -1;
+	for (unsigned int p = variable->firstPlacement; p < variable->firstPlacement + variable->placementCount; ++p)
+	{
+		if (!propagator->alive[p])
+		{
+			continue;
+		}
+		if (professor != -1 && professor != (int)model->placements[p].professor)
+		{
+			return -1;
+		}
+		professor = (int)model->placements[p].professor;
+	}
+	return professor;
+}
+
+/**
+ * Removes the placements of a session without a compatible placement in
+ * other session. Returns true if any placement is removed.
+ */
+static boolean _revise(Propagator *propagator, const unsigned int session, const unsigned int other)
+{
+	const Model *model = propagator->model;
+	const Session *variable = &model->sessions[session];
+	const Session *otherVariable = &model->sessions[other];
+	boolean changed = false;
+	propagator->revisions += 1;
+	for (unsigned int p = variable->firstPlacement; p < variable->firstPlacement + variable->placementCount; ++p)
+	{
+		if (!propagator->alive[p])
+		{
+			continue;
+		}
+		boolean supported = false;
+		for (unsigned int q = otherVariable->firstPlacement; !supported && q < otherVariable->firstPlacement + otherVariable->placementCount; ++q)
+		{
+			supported = propagator->alive[q] && !_conflicts(model, session, p, other, q);
+		}
+		if (!supported)
+		{
+			propagator->alive[p] = 0;
+			propagator->aliveCount[session] -= 1;
+			changed = true;
+		}
+	}
+	return changed;
+}
+
+static void _enqueue(Propagator *propagator, const unsigned int session)
+{
+	if (!propagator->queued[session])
+	{
+		const unsigned int sessionCount = propagator->model->sessionCount;
+		propagator->queue[(propagator->head + propagator->size) % sessionCount] = session;
+		propagator->size += 1;
+		propagator->queued[session] = true;
+	}
+}
+
+/**
+ * Revises every session that can lose support in other session: the ones of
+ * its course, the ones with its single classroom, and (if it has a single
+ * professor) the ones of its professor. Other pairs always have support,
+ * since a different professor never conflicts. Returns false if a domain is
+ * wiped-out.
+ */
+static boolean _reviseNeighbors(Propagator *propagator, const unsigned int other, int *wipedOut)
+{
+	const Model *model = propagator->model;
+	const Session *variable = &model->sessions[other];
+	const int professor = _singleProfessor(propagator, other);
+	for (unsigned int group = 0; group < 3; ++group)
+	{
+		// The sessions of the course are contiguous, so they have no list.
+		const unsigned int *sessions = NULL;
+		unsigned int count = 0;
+		if (group == 0)
+		{
+			count = model->courseFirstSession[variable->course + 1] - model->courseFirstSession[variable->course];
+		}
+		else if (group == 1 && _isSingleRoom(model, variable))
+		{
+			const SymbolId classroom = model->rooms[variable->firstRoom];
+			sessions = propagator->classroomSessions + propagator->classroomFirst[classroom];
+			count = propagator->classroomFirst[classroom + 1] - propagator->classroomFirst[classroom];
+		}
+		else if (group == 2 && professor != -1)
+		{
+			sessions = propagator->professorSessions + propagator->professorFirst[professor];
+			count = propagator->professorFirst[professor + 1] - propagator->professorFirst[professor];
+		}
+		for (unsigned int k = 0; k < count; ++k)
+		{
+			const unsigned int session = sessions == NULL ? model->courseFirstSession[variable->course] + k : sessions[k];
+			if (session == other || !_revise(propagator, session, other))
+			{
+				continue;
+			}
+			if (propagator->aliveCount[session] == 0)
+			{
+				*wipedOut = (int)session;
+				return false;
+			}
+			_enqueue(propagator, session);
+		}
+	}
+	return true;
+}
+
+/**
+ * Removes the dead placements from the model (and their rows of the score
+ * table), keeping the placements of every session contiguous and sorted.
+ * Nothing is written ahead of what is read, so it works in place.
+ */
+static void _compact(Propagator *propagator)
+{
+	Model *model = propagator->model;
+	unsigned int write = 0;
+	unsigned int matchWrite = 0;
+	for (unsigned int s = 0; s < model->sessionCount; ++s)
+	{
+		Session *session = &model->sessions[s];
+		const unsigned int first = session->firstPlacement;
+		session->firstPlacement = write;
+		for (unsigned int p = first; p < first + session->placementCount; ++p)
+		{
+			const unsigned int firstMatch = model->placementFirstMatch[p];
+			const unsigned int lastMatch = model->placementFirstMatch[p + 1];
+			if (propagator->alive[p])
+			{
+				model->placements[write] = model->placements[p];
+				model->placementFirstMatch[write++] = matchWrite;
+				for (unsigned int m = firstMatch; m < lastMatch; ++m)
+				{
+					model->placementMatches[matchWrite++] = model->placementMatches[m];
+				}
+			}
+		}
+		session->placementCount = write - session->firstPlacement;
+	}
+	model->placementCount = write;
+	model->placementFirstMatch[write] = matchWrite;
+	model->matchCount = matchWrite;
+}
+
+static unsigned int _smallestDomain(const Model *model)
+{
+	unsigned int smallest = 0;
+	for (unsigned int s = 0; s < model->sessionCount; ++s)
+	{
+		if (s == 0 || model->sessions[s].placementCount < smallest)
+		{
+			smallest = model->sessions[s].placementCount;
+		}
+	}
+	return smallest;
+}
+
+/** PUBLIC FUNCTIONS */
+
+boolean propagateModel(Model *model, PropagationReport *report)
+{
+	Propagator propagator;
+	memset(&propagator, 0, sizeof(Propagator));
+	propagator.model = model;
+	propagator.alive = malloc(1 + model->placementCount);
+	memset(propagator.alive, 1, 1 + model->placementCount);
+	propagator.aliveCount = calloc(1 + model->sessionCount, sizeof(unsigned int));
+	propagator.queue = calloc(1 + model->sessionCount, sizeof(unsigned int));
+	propagator.queued = calloc(1 + model->sessionCount, sizeof(boolean));
+	_indexSessions(&propagator);
+	memset(report, 0, sizeof(PropagationReport));
+	report->initialPlacements = model->placementCount;
+	report->smallestInitialDomain = _smallestDomain(model);
+	for (unsigned int s = 0; s < model->sessionCount; ++s)
+	{
+		propagator.aliveCount[s] = model->sessions[s].placementCount;
+		_enqueue(&propagator, s);
+	}
+
+	int wipedOut = -1;
+	boolean consistent = true;
+	while (consistent && 0 < propagator.size)
+	{
+		const unsigned int session = propagator.queue[propagator.head];
+		propagator.head = (propagator.head + 1) % model->sessionCount;
+		propagator.size -= 1;
+		propagator.queued[session] = false;
+		consistent = _reviseNeighbors(&propagator, session, &wipedOut);
+	}
+	if (consistent)
+	{
+		_compact(&propagator);
+	}
+	else
+	{
+		const Course *course = &model->program->courses[model->sessions[wipedOut].course];
+		logError(_logger, "A class of the course \"%s\" has no time left that is compatible with the rest of the classes.", course->id);
+	}
+	report->finalPlacements = model->placementCount;
+	report->smallestFinalDomain = _smallestDomain(model);
+	report->revisions = propagator.revisions;
+	logDebugging(_logger, "The propagation prunes the placements from %u to %u after %llu revision(s) (the smallest domain, from %u to %u).",
+				 report->initialPlacements, report->finalPlacements, report->revisions, report->smallestInitialDomain, report->smallestFinalDomain);
+	free(propagator.alive);
+	free(propagator.aliveCount);
+	free(propagator.queue);
+	free(propagator.queued);
+	free(propagator.professorFirst);
+	free(propagator.professorSessions);
+	free(propagator.classroomFirst);
+	free(propagator.classroomSessions);
+	return consistent;
+}
@@ -0,0 +1,39 @@
+#ifndef PROPAGATION_HEADER
+#define PROPAGATION_HEADER
+
+#include "../../shared/Logger.h"
+#include "../../shared/Type.h"
+#include "Model.h"
+
+/** Initialize module's internal state. */
+void initializePropagationModule();
+
+/** Shutdown module's internal state. */
+void shutdownPropagationModule();
+
+/**
+ * The sizes of the domains of a model, before and after the propagation.
+ */
+typedef struct {
+	unsigned int initialPlacements;
+	unsigned int finalPlacements;
+	unsigned int smallestInitialDomain;
+	unsigned int smallestFinalDomain;
+	unsigned long long revisions;
+} PropagationReport;
+
+/**
+ * Prunes the placements of the model that cannot be part of any schedule,
+ * until a fixpoint (i.e., arc-consistency over every pair of sessions that
+ * share a professor, a course or a pinned classroom). A placement of a
+ * session is pruned if every placement of other session conflicts with it
+ * (the same professor with overlapping time, the same course on the same
+ * day, or the same single classroom with overlapping time).
+ *
+ * The unary constraints (qualification, availability, classrooms and pins)
+ * are already applied by the model. Returns false (after logging the reason)
+ * if the domain of any session becomes empty.
+ */
+boolean propagateModel(Model * model, PropagationReport * report);
+
+#endif
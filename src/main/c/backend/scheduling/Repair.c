@@ -0,0 +1,352 @@
+#include "Repair.h"
+
+/* MODULE INTERNAL STATE */
+
+static Logger *_logger = NULL;
+static const char *_path = NULL;
+
+void initializeRepairModule()
+{
+	_logger = createLogger("Repair");
+	_path = getStringOrDefault("PREVIOUS_SCHEDULE", NULL);
+	if (_path != NULL && _path[0] == '\0')
+	{
+		_path = NULL;
+	}
+}
+
+void shutdownRepairModule()
+{
+	if (_logger != NULL)
+	{
+		destroyLogger(_logger);
+	}
+}
+
+/** PRIVATE FUNCTIONS */
+
+/**
+ * The classes kept from the previous schedule: the placement (as an index of
+ * the model placements) and the classroom of each session, or -1 and
+ * UNDEFINED_SYMBOL if it's free.
+ */
+typedef struct
+{
+	const Model *model;
+	int *placements;
+	SymbolId *classrooms;
+	unsigned int keptCount;
+} RepairPlan;
+
+static SymbolId _declared(const Model *model, const SymbolKind kind, const SymbolId id);
+static boolean _parseClass(const Model *model, const SymbolTable *symbolTable, char *line, PreviousClass *previous);
+static boolean _readPreviousSchedule(const Model *model, const SymbolTable *symbolTable, PreviousClass **classes, unsigned int *classCount, unsigned int *lineCount);
+static void _keepClasses(RepairPlan *plan, const PreviousClass *classes, const unsigned int classCount);
+static Optimization *_solveNeighborhood(const RepairPlan *plan, ComponentSolver solver, const ScheduleListener *listener, void *argument);
+static unsigned int _widen(RepairPlan *plan, const boolean everything);
+
+/**
+ * The symbol of an entity if it's declared, or UNDEFINED_SYMBOL if it's
+ * unknown, or not declared anymore.
+ */
+static SymbolId _declared(const Model *model, const SymbolKind kind, const SymbolId id)
+{
+	if (id == UNDEFINED_SYMBOL)
+	{
+		return UNDEFINED_SYMBOL;
+	}
+	switch (kind)
+	{
+	case SYMBOL_PROFESSOR:
+		return model->program->professors[id].declared ? id : UNDEFINED_SYMBOL;
+	case SYMBOL_COURSE:
+		return model->program->courses[id].declared ? id : UNDEFINED_SYMBOL;
+	case SYMBOL_CLASSROOM:
+		return model->program->classrooms[id].declared ? id : UNDEFINED_SYMBOL;
+	default:
+		return UNDEFINED_SYMBOL;
+	}
+}
+
+/**
+ * Parses a "teaches" line of a schedule (as written by the generator), in
+ * terms of the current program and its time-grid. Returns false if it's not
+ * such a line, or if its professor or course are not declared anymore, or
+ * if its time is not aligned to the time-grid. An unknown classroom is
+ * ignored (so the class keeps its time).
+ */
+static boolean _parseClass(const Model *model, const SymbolTable *symbolTable, char *line, PreviousClass *previous)
+{
+	ScheduledSession session;
+	boolean hasClassroom = false;
+	if (!parseScheduledSession(symbolTable, line, &session, &hasClassroom))
+	{
+		return false;
+	}
+	const TimeGrid *grid = &model->grid;
+	const unsigned int start = (unsigned int)timeToMinutes(session.start);
+	const unsigned int end = (unsigned int)timeToMinutes(session.end);
+	if (start < grid->openMinute || grid->closeMinute < end || end <= start
+		|| (start - grid->openMinute) % grid->granularity != 0 || (end - start) % grid->granularity != 0)
+	{
+		return false;
+	}
+	previous->day = session.day;
+	previous->professor = _declared(model, SYMBOL_PROFESSOR, session.professor);
+	previous->course = _declared(model, SYMBOL_COURSE, session.course);
+	previous->classroom = _declared(model, SYMBOL_CLASSROOM, session.classroom);
+	previous->slot = (start - grid->openMinute) / grid->granularity;
+	previous->length = (end - start) / grid->granularity;
+	return previous->professor != UNDEFINED_SYMBOL && previous->course != UNDEFINED_SYMBOL;
+}
+
+/**
+ * Reads the classes of the previous schedule that still refer to the current
+ * program, and counts every "teaches" line. Returns false (after logging the
+ * reason) if the file cannot be read.
+ */
+static boolean _readPreviousSchedule(const Model *model, const SymbolTable *symbolTable, PreviousClass **classes, unsigned int *classCount, unsigned int *lineCount)
+{
+	FILE *file = fopen(_path, "r");
+	if (file == NULL)
+	{
+		logWarning(_logger, "Cannot read the previous schedule \"%s\" (solving from scratch instead).", _path);
+		return false;
+	}
+	unsigned int capacity = 0;
+	char *line = NULL;
+	size_t size = 0;
+	*classes = NULL;
+	*classCount = 0;
+	*lineCount = 0;
+	while (getline(&line, &size, file) != -1)
+	{
+		if (strstr(line, " teaches ") == NULL)
+		{
+			continue;
+		}
+		*lineCount += 1;
+		PreviousClass previous;
+		if (!_parseClass(model, symbolTable, line, &previous))
+		{
+			continue;
+		}
+		if (*classCount == capacity)
+		{
+			capacity = capacity < 64 ? 64 : 2 * capacity;
+			*classes = realloc(*classes, capacity * sizeof(PreviousClass));
+		}
+		(*classes)[(*classCount)++] = previous;
+	}
+	free(line);
+	fclose(file);
+	return true;
+}
+
+/**
+ * Keeps every previous class that still fits the model, in order: it takes
+ * the unmatched session of its course with its length and the smallest
+ * domain that contains its placement, if its professor and its course are
+ * still free, and the day of its course is not full. Its classroom is kept if
+ * it's still in the domain of the session, and free.
+ */
+static void _keepClasses(RepairPlan *plan, const PreviousClass *classes, const unsigned int classCount)
+{
+	const Model *model = plan->model;
+	const TimeGrid *grid = &model->grid;
+	BitsetWord *professorBusy = createBitset(1 + model->professorCount * grid->wordCount);
+	BitsetWord *classroomBusy = createBitset(1 + model->classroomCount * grid->wordCount);
+	BitsetWord *courseBusy = createBitset(1 + model->courseCount * grid->wordCount);
+	unsigned int *courseDays = calloc(1 + model->courseCount * WEEK_DAY_COUNT, sizeof(unsigned int));
+	for (unsigned int k = 0; k < classCount; ++k)
+	{
+		const PreviousClass *previous = &classes[k];
+		int session = -1;
+		int placement = -1;
+		for (unsigned int s = model->courseFirstSession[previous->course]; s < model->courseFirstSession[previous->course + 1]; ++s)
+		{
+			const Session *variable = &model->sessions[s];
+			if (plan->placements[s] != -1 || variable->length != previous->length
+				|| (session != -1 && model->sessions[session].placementCount <= variable->placementCount))
+			{
+				continue;
+			}
+			const int p = findPlacement(model, variable, previous->professor, previous->day, previous->slot);
+			if (p != -1)
+			{
+				session = (int)s;
+				placement = p;
+			}
+		}
+		const unsigned int weekSlot = previous->day * grid->slotsPerDay + previous->slot;
+		if (session == -1
+			|| model->sessionsPerDay <= courseDays[previous->course * WEEK_DAY_COUNT + previous->day]
+			|| bitsetAnyInRange(professorBusy + previous->professor * grid->wordCount, weekSlot, previous->length)
+			|| bitsetAnyInRange(courseBusy + previous->course * grid->wordCount, weekSlot, previous->length))
+		{
+			continue;
+		}
+		plan->placements[session] = placement;
+		plan->keptCount += 1;
+		courseDays[previous->course * WEEK_DAY_COUNT + previous->day] += 1;
+		bitsetSetRange(professorBusy + previous->professor * grid->wordCount, weekSlot, previous->length);
+		bitsetSetRange(courseBusy + previous->course * grid->wordCount, weekSlot, previous->length);
+		if (model->usesClassrooms && previous->classroom != UNDEFINED_SYMBOL
+			&& sessionFits(model, &model->sessions[session], previous->classroom)
+			&& !bitsetAnyInRange(classroomBusy + previous->classroom * grid->wordCount, weekSlot, previous->length))
+		{
+			plan->classrooms[session] = previous->classroom;
+			bitsetSetRange(classroomBusy + previous->classroom * grid->wordCount, weekSlot, previous->length);
+		}
+	}
+	destroyBitset(professorBusy);
+	destroyBitset(classroomBusy);
+	destroyBitset(courseBusy);
+	free(courseDays);
+}
+
+/**
+ * Solves the free sessions of the plan, with the kept ones reduced to their
+ * single placement (and classroom, if it has one). The result is translated
+ * back to the placements of the whole model.
+ */
+static Optimization *_solveNeighborhood(const RepairPlan *plan, ComponentSolver solver, const ScheduleListener *listener, void *argument)
+{
+	const Model *model = plan->model;
+	unsigned int *sessions = calloc(1 + model->sessionCount, sizeof(unsigned int));
+	for (unsigned int s = 0; s < model->sessionCount; ++s)
+	{
+		sessions[s] = s;
+	}
+	Model *part = extractModel(model, sessions, model->sessionCount);
+	for (unsigned int s = 0; s < model->sessionCount; ++s)
+	{
+		Session *session = &part->sessions[s];
+		if (plan->placements[s] == -1)
+		{
+			continue;
+		}
+		session->firstPlacement += plan->placements[s] - model->sessions[s].firstPlacement;
+		session->placementCount = 1;
+		for (unsigned int k = 0; plan->classrooms[s] != UNDEFINED_SYMBOL && k < session->roomCount; ++k)
+		{
+			if (part->rooms[session->firstRoom + k] == plan->classrooms[s])
+			{
+				session->firstRoom += k;
+				session->roomCount = 1;
+				break;
+			}
+		}
+	}
+	Optimization *optimization = solveComponents(part, solver, listener, argument);
+	for (unsigned int s = 0; optimization->status == SOLVER_SATISFIABLE && s < model->sessionCount; ++s)
+	{
+		Assignment *assignment = &optimization->assignments[s];
+		const Placement *placement = &part->placements[assignment->placement];
+		assignment->placement = findPlacement(model, &model->sessions[s], placement->professor, placement->day, placement->slot);
+	}
+	destroyModel(part);
+	free(sessions);
+	return optimization;
+}
+
+/**
+ * Frees the kept sessions that share a course, a professor or a classroom
+ * with the domain of a free session (or every kept session), and returns
+ * how many. A kept session without classroom counts as free for the
+ * classrooms.
+ */
+static unsigned int _widen(RepairPlan *plan, const boolean everything)
+{
+	const Model *model = plan->model;
+	boolean *courses = calloc(1 + model->courseCount, sizeof(boolean));
+	boolean *professors = calloc(1 + model->professorCount, sizeof(boolean));
+	boolean *classrooms = calloc(1 + model->classroomCount, sizeof(boolean));
+	for (unsigned int s = 0; s < model->sessionCount; ++s)
+	{
+		const Session *session = &model->sessions[s];
+		for (unsigned int p = session->firstPlacement; plan->placements[s] == -1 && p < session->firstPlacement + session->placementCount; ++p)
+		{
+			professors[model->placements[p].professor] = true;
+		}
+		for (unsigned int r = session->firstRoom; plan->classrooms[s] == UNDEFINED_SYMBOL && r < session->firstRoom + session->roomCount; ++r)
+		{
+			classrooms[model->rooms[r]] = true;
+		}
+		courses[session->course] = courses[session->course] || plan->placements[s] == -1;
+	}
+	unsigned int freedCount = 0;
+	for (unsigned int s = 0; s < model->sessionCount; ++s)
+	{
+		if (plan->placements[s] == -1)
+		{
+			continue;
+		}
+		const SymbolId classroom = plan->classrooms[s];
+		if (everything || courses[model->sessions[s].course] || professors[model->placements[plan->placements[s]].professor]
+			|| (classroom != UNDEFINED_SYMBOL && classrooms[classroom]))
+		{
+			plan->placements[s] = -1;
+			plan->classrooms[s] = UNDEFINED_SYMBOL;
+			++freedCount;
+		}
+	}
+	plan->keptCount -= freedCount;
+	free(courses);
+	free(professors);
+	free(classrooms);
+	return freedCount;
+}
+
+/** PUBLIC FUNCTIONS */
+
+boolean hasPreviousSchedule()
+{
+	return _path != NULL;
+}
+
+Optimization *repairSchedule(const Model *model, const SymbolTable *symbolTable, ComponentSolver solver, const ScheduleListener *listener, void *argument)
+{
+	PreviousClass *classes = NULL;
+	unsigned int classCount = 0;
+	unsigned int lineCount = 0;
+	if (!_readPreviousSchedule(model, symbolTable, &classes, &classCount, &lineCount))
+	{
+		return NULL;
+	}
+	RepairPlan plan = {
+		.model = model,
+		.placements = malloc((1 + model->sessionCount) * sizeof(int)),
+		.classrooms = malloc((1 + model->sessionCount) * sizeof(SymbolId)),
+		.keptCount = 0};
+	for (unsigned int s = 0; s < model->sessionCount; ++s)
+	{
+		plan.placements[s] = -1;
+		plan.classrooms[s] = UNDEFINED_SYMBOL;
+	}
+	_keepClasses(&plan, classes, classCount);
+	free(classes);
+	logInformation(_logger, "The previous schedule has %u class(es), and %u of them are still valid (so %u of %u session(s) are solved again).",
+				   lineCount, plan.keptCount, model->sessionCount - plan.keptCount, model->sessionCount);
+
+	Optimization *optimization = NULL;
+	for (unsigned int round = 0; true; ++round)
+	{
+		optimization = _solveNeighborhood(&plan, solver, listener, argument);
+		if (optimization->status == SOLVER_SATISFIABLE || optimization->status == SOLVER_CANCELLED || optimization->status == SOLVER_TIMEOUT || plan.keptCount == 0)
+		{
+			break;
+		}
+		destroyOptimization(optimization);
+		unsigned int freedCount = _widen(&plan, MAXIMUM_REPAIR_ROUNDS <= round);
+		if (freedCount == 0)
+		{
+			freedCount = _widen(&plan, true);
+		}
+		logInformation(_logger, "There is no schedule with the kept classes, so %u more session(s) are solved again.", freedCount);
+	}
+	optimization->optimal = optimization->optimal && plan.keptCount == 0;
+	free(plan.placements);
+	free(plan.classrooms);
+	return optimization;
+}
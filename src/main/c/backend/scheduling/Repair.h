@@ -0,0 +1,71 @@
+#ifndef REPAIR_HEADER
+#define REPAIR_HEADER
+
+#include "../../shared/Environment.h"
+#include "../../shared/Logger.h"
+#include "../../shared/SymbolTable.h"
+#include "../../shared/Type.h"
+#include "Bitset.h"
+#include "Decomposition.h"
+#include "Model.h"
+#include "Optimizer.h"
+#include "Propagation.h"
+#include "Schedule.h"
+#include <stdio.h>
+
+/** Initialize module's internal state. */
+void initializeRepairModule();
+
+/** Shutdown module's internal state. */
+void shutdownRepairModule();
+
+/**
+ * The maximum amount of times that the repair widens its neighborhood,
+ * before it solves the whole model from scratch.
+ */
+#define MAXIMUM_REPAIR_ROUNDS 3
+
+/**
+ * A class of a previous schedule (i.e., one of its "teaches" lines), in
+ * terms of the current program.
+ */
+typedef struct {
+	SymbolId professor;
+	SymbolId course;
+	SymbolId classroom;
+	unsigned int day;
+	unsigned int slot;
+	unsigned int length;
+} PreviousClass;
+
+/**
+ * Returns true if there is a previous schedule to repair (see
+ * "PREVIOUS_SCHEDULE").
+ */
+boolean hasPreviousSchedule();
+
+/**
+ * Solves a model by repairing the previous schedule, instead of solving it
+ * from scratch. The previous schedule is an output of the compiler for an
+ * earlier version of the program, and every class of it that is still valid
+ * (i.e., its professor, course, time and classroom are in the domain of an
+ * unmatched session of the current model, without overlapping the classes
+ * already kept) keeps its placement, and its classroom if possible. A class
+ * whose classroom became invalid keeps its time, but takes any other
+ * classroom.
+ *
+ * Only the remaining sessions (i.e., the ones affected by the changes of the
+ * program) are solved, with the solver and the listener. If there is no
+ * schedule with the kept classes, the neighborhood widens: every kept class
+ * that shares a course, a professor or a classroom with the domain of a free
+ * session is freed too, up to "MAXIMUM_REPAIR_ROUNDS" times; then, the whole
+ * model is solved. Every round stops as soon as the time limit expires. The
+ * result is never optimal when some class is kept, since the kept classes are
+ * not optimized.
+ *
+ * Returns NULL (after logging the reason) if the previous schedule cannot be
+ * read.
+ */
+Optimization * repairSchedule(const Model * model, const SymbolTable * symbolTable, ComponentSolver solver, const ScheduleListener * listener, void * argument);
+
+#endif
@@ -0,0 +1,207 @@
+#include "RoomMatching.h"
+
+/** PRIVATE FUNCTIONS */
+
+static void _move(RoomMatching *matching, const unsigned int session, const SymbolId classroom);
+static void _undo(RoomMatching *matching, const unsigned int moveMark);
+static boolean _isFree(const RoomMatching *matching, const SymbolId classroom, const unsigned int session);
+static boolean _augment(RoomMatching *matching, const unsigned int session);
+
+/**
+ * Moves a session to a classroom (or out of the matching, if it's
+ * UNDEFINED_SYMBOL), and records its previous classroom.
+ */
+static void _move(RoomMatching *matching, const unsigned int session, const SymbolId classroom)
+{
+	const Model *model = matching->model;
+	const unsigned int length = model->sessions[session].length;
+	const unsigned int weekSlot = matching->weekSlots[session];
+	const SymbolId previous = matching->assignments[session].classroom;
+	if (matching->moveCount == matching->moveCapacity)
+	{
+		matching->moveCapacity = matching->moveCapacity < 64 ? 64 : 2 * matching->moveCapacity;
+		matching->moves = realloc(matching->moves, matching->moveCapacity * sizeof(RoomMove));
+	}
+	matching->moves[matching->moveCount].session = session;
+	matching->moves[matching->moveCount].classroom = previous;
+	matching->moveCount += 1;
+	if (previous != UNDEFINED_SYMBOL)
+	{
+		int *occupants = matching->occupants + previous * model->grid.slotCount + weekSlot;
+		for (unsigned int k = 0; k < length; ++k)
+		{
+			occupants[k] = -1;
+		}
+	}
+	if (classroom != UNDEFINED_SYMBOL)
+	{
+		int *occupants = matching->occupants + classroom * model->grid.slotCount + weekSlot;
+		for (unsigned int k = 0; k < length; ++k)
+		{
+			occupants[k] = (int)session;
+		}
+	}
+	matching->assignments[session].classroom = classroom;
+}
+
+/**
+ * Undoes every move since the mark, in reverse order.
+ */
+static void _undo(RoomMatching *matching, const unsigned int moveMark)
+{
+	while (moveMark < matching->moveCount)
+	{
+		const RoomMove move = matching->moves[matching->moveCount - 1];
+		_move(matching, move.session, move.classroom);
+		matching->moveCount -= 2;
+	}
+}
+
+/**
+ * Returns true if a classroom has no session during the time of other
+ * session.
+ */
+static boolean _isFree(const RoomMatching *matching, const SymbolId classroom, const unsigned int session)
+{
+	const int *occupants = matching->occupants + classroom * matching->model->grid.slotCount + matching->weekSlots[session];
+	for (unsigned int t = 0; t < matching->model->sessions[session].length; ++t)
+	{
+		if (occupants[t] != -1)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Finds a classroom for an unmatched session: a free classroom, or else one
+ * whose occupants (during its time) can all be moved to other classrooms,
+ * with the same search. The classrooms are tried by ascending capacity (i.e.,
+ * best-fit first). Returns false (undoing its moves) if there is none.
+ */
+static boolean _augment(RoomMatching *matching, const unsigned int session)
+{
+	const Model *model = matching->model;
+	const Session *variable = &model->sessions[session];
+	const SymbolId pin = matching->pins[session];
+	for (unsigned int k = 0; k < variable->roomCount; ++k)
+	{
+		const SymbolId classroom = model->rooms[variable->firstRoom + k];
+		if ((pin == UNDEFINED_SYMBOL || classroom == pin) && _isFree(matching, classroom, session))
+		{
+			_move(matching, session, classroom);
+			return true;
+		}
+	}
+	for (unsigned int k = 0; 0 < matching->budget && k < variable->roomCount; ++k)
+	{
+		const SymbolId classroom = model->rooms[variable->firstRoom + k];
+		if ((pin != UNDEFINED_SYMBOL && classroom != pin) || matching->visited[classroom])
+		{
+			continue;
+		}
+		matching->budget -= 1;
+
+		// Takes the classroom, and then moves its previous occupants.
+		const unsigned int moveMark = matching->moveCount;
+		const int *occupants = matching->occupants + classroom * model->grid.slotCount + matching->weekSlots[session];
+		boolean movable = true;
+		for (unsigned int t = 0; movable && t < variable->length; ++t)
+		{
+			const int occupant = occupants[t];
+			if (occupant != -1 && fixedClassroom(matching, (unsigned int)occupant) != UNDEFINED_SYMBOL)
+			{
+				movable = false;
+			}
+			else if (occupant != -1)
+			{
+				_move(matching, (unsigned int)occupant, UNDEFINED_SYMBOL);
+			}
+		}
+		const unsigned int displacedCount = matching->moveCount - moveMark;
+		if (movable)
+		{
+			_move(matching, session, classroom);
+		}
+		matching->visited[classroom] = true;
+		for (unsigned int d = 0; movable && d < displacedCount; ++d)
+		{
+			movable = _augment(matching, matching->moves[moveMark + d].session);
+		}
+		matching->visited[classroom] = false;
+		if (movable)
+		{
+			return true;
+		}
+		_undo(matching, moveMark);
+	}
+	return false;
+}
+
+/** PUBLIC FUNCTIONS */
+
+RoomMatching *createRoomMatching(const Model *model, Assignment *assignments)
+{
+	RoomMatching *matching = calloc(1, sizeof(RoomMatching));
+	matching->model = model;
+	matching->assignments = assignments;
+	matching->occupants = malloc((1 + model->classroomCount * model->grid.slotCount) * sizeof(int));
+	memset(matching->occupants, -1, (1 + model->classroomCount * model->grid.slotCount) * sizeof(int));
+	matching->weekSlots = calloc(1 + model->sessionCount, sizeof(unsigned int));
+	matching->pins = malloc((1 + model->sessionCount) * sizeof(SymbolId));
+	for (unsigned int s = 0; s < model->sessionCount; ++s)
+	{
+		matching->pins[s] = UNDEFINED_SYMBOL;
+	}
+	matching->visited = calloc(1 + model->classroomCount, sizeof(boolean));
+	return matching;
+}
+
+void destroyRoomMatching(RoomMatching *matching)
+{
+	if (matching != NULL)
+	{
+		free(matching->occupants);
+		free(matching->weekSlots);
+		free(matching->pins);
+		free(matching->visited);
+		free(matching->moves);
+		free(matching);
+	}
+}
+
+boolean matchSession(RoomMatching *matching, const unsigned int session, const unsigned int weekSlot, const SymbolId classroom)
+{
+	matching->weekSlots[session] = weekSlot;
+	matching->pins[session] = classroom;
+	matching->moveCount = 0;
+	matching->augmentations += 1;
+	matching->budget = MAXIMUM_ROOM_VISITS;
+	if (_augment(matching, session))
+	{
+		return true;
+	}
+	matching->pins[session] = UNDEFINED_SYMBOL;
+	return false;
+}
+
+void unmatchSession(RoomMatching *matching, const unsigned int session)
+{
+	if (matching->assignments[session].classroom != UNDEFINED_SYMBOL)
+	{
+		_move(matching, session, UNDEFINED_SYMBOL);
+	}
+	matching->pins[session] = UNDEFINED_SYMBOL;
+	matching->moveCount = 0;
+}
+
+SymbolId fixedClassroom(const RoomMatching *matching, const unsigned int session)
+{
+	const Session *variable = &matching->model->sessions[session];
+	if (matching->pins[session] != UNDEFINED_SYMBOL)
+	{
+		return matching->pins[session];
+	}
+	return variable->roomCount == 1 ? matching->model->rooms[variable->firstRoom] : UNDEFINED_SYMBOL;
+}
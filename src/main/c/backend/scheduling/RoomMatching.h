@@ -0,0 +1,91 @@
+#ifndef ROOM_MATCHING_HEADER
+#define ROOM_MATCHING_HEADER
+
+#include "../../shared/Type.h"
+#include "Model.h"
+
+/**
+ * The maximum amount of classrooms that a single augmenting search visits.
+ */
+#define MAXIMUM_ROOM_VISITS 256
+
+/**
+ * The previous classroom of a session, to undo an augmenting path.
+ */
+typedef struct {
+	unsigned int session;
+	SymbolId classroom;
+} RoomMove;
+
+/**
+ * A matching between the placed sessions and the classrooms that fit them,
+ * where the sessions with overlapping time get different classrooms. It's
+ * updated incrementally: a new session takes a free classroom, or else it
+ * finds one with an augmenting path (i.e., moving the sessions that occupy
+ * a classroom to other classrooms of their own, recursively). A classroom
+ * appears at most once in a path, and a search visits a bounded amount of
+ * classrooms (see "MAXIMUM_ROOM_VISITS"), since the sessions of different
+ * lengths make the exact problem hard.
+ *
+ * A session can be pinned to a classroom (e.g., to satisfy a preference), so
+ * it's never moved. The classroom of every session is also written to its
+ * assignment (so the moves are visible to the owner of the assignments).
+ */
+typedef struct {
+	const Model * model;
+	Assignment * assignments;
+
+	// The session in each slot of each classroom (or -1): [classroom *
+	// slotCount + weekSlot].
+	int * occupants;
+
+	// The first week-slot of each matched session, and its pinned classroom
+	// (or UNDEFINED_SYMBOL).
+	unsigned int * weekSlots;
+	SymbolId * pins;
+
+	// The classrooms in the current augmenting path, and the visits left.
+	boolean * visited;
+	unsigned int budget;
+
+	// The moves of the current augmenting path.
+	RoomMove * moves;
+	unsigned int moveCount;
+	unsigned int moveCapacity;
+
+	unsigned long long augmentations;
+} RoomMatching;
+
+/**
+ * Creates an empty matching for the sessions of a model, that writes the
+ * classroom of every session to its assignment. The model and the
+ * assignments must outlive the matching.
+ */
+RoomMatching * createRoomMatching(const Model * model, Assignment * assignments);
+
+/**
+ * Destroy a matching and its resources.
+ */
+void destroyRoomMatching(RoomMatching * matching);
+
+/**
+ * Adds a session that begins in a week-slot to the matching, in any of its
+ * classrooms, or only in the pinned one (if it's not UNDEFINED_SYMBOL). It
+ * may move other sessions that are not pinned. Returns false (and leaves
+ * the matching unchanged) if there is no such matching.
+ */
+boolean matchSession(RoomMatching * matching, const unsigned int session, const unsigned int weekSlot, const SymbolId classroom);
+
+/**
+ * Removes a session from the matching (if it's matched). The other sessions
+ * keep their classrooms.
+ */
+void unmatchSession(RoomMatching * matching, const unsigned int session);
+
+/**
+ * The classroom that a matched session can never leave: the pinned one, or
+ * its only classroom (or UNDEFINED_SYMBOL if it can be moved).
+ */
+SymbolId fixedClassroom(const RoomMatching * matching, const unsigned int session);
+
+#endif
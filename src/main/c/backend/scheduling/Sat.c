@@ -0,0 +1,773 @@
+#include "Sat.h"
+
+/**
+ * The conflicts of the first restart (multiplied by the Luby sequence), the
+ * decay of the activities, and the learnt clauses before the first reduction.
+ */
+#define RESTART_UNIT 100
+#define VARIABLE_DECAY 0.95
+#define CLAUSE_DECAY 0.999
+#define MINIMUM_LEARNT_LIMIT 2000
+
+// The conflicts between two polls of the time limit.
+#define DEADLINE_POLL_CONFLICTS 256
+
+/** PRIVATE FUNCTIONS */
+
+static int _valueOf(const SatSolver *solver, const SatLiteral literal);
+static void _watch(SatSolver *solver, const SatLiteral literal, const unsigned int clause, const SatLiteral blocker);
+static unsigned int _store(SatSolver *solver, const SatLiteral *literals, const unsigned int size, const boolean learnt);
+static void _enqueue(SatSolver *solver, const SatLiteral literal, const int reason);
+static int _propagate(SatSolver *solver);
+static void _heapUp(SatSolver *solver, unsigned int index);
+static void _heapDown(SatSolver *solver, unsigned int index);
+static void _heapInsert(SatSolver *solver, const unsigned int variable);
+static unsigned int _heapPop(SatSolver *solver);
+static void _bumpVariable(SatSolver *solver, const unsigned int variable);
+static void _bumpClause(SatSolver *solver, const unsigned int clause);
+static boolean _isRedundant(const SatSolver *solver, const SatLiteral literal);
+static unsigned int _analyze(SatSolver *solver, const int conflict, unsigned int *backtrackLevel, unsigned int *lbd);
+static void _backtrack(SatSolver *solver, const unsigned int level);
+static int _compareLearnt(const void *left, const void *right);
+static void _reduce(SatSolver *solver);
+static unsigned long long _luby(unsigned long long index);
+static boolean _complete(SatSolver *solver);
+
+/**
+ * The value of a literal: -1 if it's unassigned, 1 if it's true, or 0 if
+ * it's false.
+ */
+static int _valueOf(const SatSolver *solver, const SatLiteral literal)
+{
+	const signed char value = solver->values[literal >> 1];
+	return value < 0 ? -1 : (value ^ (int)(literal & 1));
+}
+
+static void _watch(SatSolver *solver, const SatLiteral literal, const unsigned int clause, const SatLiteral blocker)
+{
+	SatWatchList *list = &solver->watches[literal];
+	if (list->count == list->capacity)
+	{
+		list->capacity = list->capacity < 4 ? 4 : 2 * list->capacity;
+		list->items = realloc(list->items, list->capacity * sizeof(SatWatch));
+	}
+	list->items[list->count].clause = clause;
+	list->items[list->count].blocker = blocker;
+	list->count += 1;
+}
+
+/**
+ * Stores a clause of at least 2 literals (reusing the slot of a deleted one,
+ * if any), and watches its first two literals.
+ */
+static unsigned int _store(SatSolver *solver, const SatLiteral *literals, const unsigned int size, const boolean learnt)
+{
+	unsigned int index;
+	if (0 < solver->freeCount)
+	{
+		solver->freeCount -= 1;
+		index = solver->freeClauses[solver->freeCount];
+	}
+	else
+	{
+		if (solver->clauseCount == solver->clauseCapacity)
+		{
+			solver->clauseCapacity = solver->clauseCapacity < 64 ? 64 : 2 * solver->clauseCapacity;
+			solver->clauses = realloc(solver->clauses, solver->clauseCapacity * sizeof(SatClause));
+			solver->freeClauses = realloc(solver->freeClauses, solver->clauseCapacity * sizeof(unsigned int));
+		}
+		index = solver->clauseCount;
+		solver->clauseCount += 1;
+	}
+	SatClause *clause = &solver->clauses[index];
+	clause->literals = malloc(size * sizeof(SatLiteral));
+	memcpy(clause->literals, literals, size * sizeof(SatLiteral));
+	clause->size = size;
+	clause->lbd = 0;
+	clause->activity = 0.0;
+	clause->learnt = learnt;
+	if (learnt)
+	{
+		solver->learntCount += 1;
+	}
+	_watch(solver, literals[0], index, literals[1]);
+	_watch(solver, literals[1], index, literals[0]);
+	return index;
+}
+
+static void _enqueue(SatSolver *solver, const SatLiteral literal, const int reason)
+{
+	const unsigned int variable = literal >> 1;
+	solver->values[variable] = (literal & 1) ? 0 : 1;
+	solver->levels[variable] = solver->level;
+	solver->reasons[variable] = reason;
+	solver->trail[solver->trailSize] = literal;
+	solver->trailSize += 1;
+}
+
+/**
+ * Propagates every assigned literal that was not propagated yet. Returns the
+ * falsified clause, or -1 if there is no conflict.
+ */
+static int _propagate(SatSolver *solver)
+{
+	int conflict = -1;
+	while (conflict < 0 && solver->propagated < solver->trailSize)
+	{
+		const SatLiteral falsified = solver->trail[solver->propagated] ^ 1;
+		solver->propagated += 1;
+		solver->propagations += 1;
+		SatWatchList *list = &solver->watches[falsified];
+		unsigned int i = 0;
+		unsigned int j = 0;
+		while (i < list->count)
+		{
+			const SatWatch watch = list->items[i];
+			i += 1;
+			if (_valueOf(solver, watch.blocker) == 1)
+			{
+				list->items[j++] = watch;
+				continue;
+			}
+			SatLiteral *literals = solver->clauses[watch.clause].literals;
+			const unsigned int size = solver->clauses[watch.clause].size;
+			if (literals[0] == falsified)
+			{
+				literals[0] = literals[1];
+				literals[1] = falsified;
+			}
+			const SatLiteral first = literals[0];
+			if (first != watch.blocker && _valueOf(solver, first) == 1)
+			{
+				list->items[j].clause = watch.clause;
+				list->items[j].blocker = first;
+				j += 1;
+				continue;
+			}
+			boolean moved = false;
+			for (unsigned int k = 2; k < size; ++k)
+			{
+				if (_valueOf(solver, literals[k]) != 0)
+				{
+					literals[1] = literals[k];
+					literals[k] = falsified;
+					_watch(solver, literals[1], watch.clause, first);
+					list = &solver->watches[falsified];
+					moved = true;
+					break;
+				}
+			}
+			if (moved)
+			{
+				continue;
+			}
+			list->items[j].clause = watch.clause;
+			list->items[j].blocker = first;
+			j += 1;
+			if (_valueOf(solver, first) == 0)
+			{
+				conflict = (int)watch.clause;
+				while (i < list->count)
+				{
+					list->items[j++] = list->items[i++];
+				}
+			}
+			else
+			{
+				_enqueue(solver, first, (int)watch.clause);
+			}
+		}
+		list->count = j;
+	}
+	return conflict;
+}
+
+static void _heapUp(SatSolver *solver, unsigned int index)
+{
+	const unsigned int variable = solver->heap[index];
+	while (0 < index)
+	{
+		const unsigned int parent = (index - 1) / 2;
+		if (solver->activities[solver->heap[parent]] >= solver->activities[variable])
+		{
+			break;
+		}
+		solver->heap[index] = solver->heap[parent];
+		solver->heapIndex[solver->heap[index]] = (int)index;
+		index = parent;
+	}
+	solver->heap[index] = variable;
+	solver->heapIndex[variable] = (int)index;
+}
+
+static void _heapDown(SatSolver *solver, unsigned int index)
+{
+	const unsigned int variable = solver->heap[index];
+	while (true)
+	{
+		unsigned int child = 2 * index + 1;
+		if (solver->heapSize <= child)
+		{
+			break;
+		}
+		if (child + 1 < solver->heapSize && solver->activities[solver->heap[child]] < solver->activities[solver->heap[child + 1]])
+		{
+			child += 1;
+		}
+		if (solver->activities[solver->heap[child]] <= solver->activities[variable])
+		{
+			break;
+		}
+		solver->heap[index] = solver->heap[child];
+		solver->heapIndex[solver->heap[index]] = (int)index;
+		index = child;
+	}
+	solver->heap[index] = variable;
+	solver->heapIndex[variable] = (int)index;
+}
+
+static void _heapInsert(SatSolver *solver, const unsigned int variable)
+{
+	if (solver->heapIndex[variable] < 0)
+	{
+		solver->heap[solver->heapSize] = variable;
+		solver->heapSize += 1;
+		_heapUp(solver, solver->heapSize - 1);
+	}
+}
+
+static unsigned int _heapPop(SatSolver *solver)
+{
+	const unsigned int variable = solver->heap[0];
+	solver->heapIndex[variable] = -1;
+	solver->heapSize -= 1;
+	if (0 < solver->heapSize)
+	{
+		solver->heap[0] = solver->heap[solver->heapSize];
+		_heapDown(solver, 0);
+	}
+	return variable;
+}
+
+static void _bumpVariable(SatSolver *solver, const unsigned int variable)
+{
+	solver->activities[variable] += solver->variableIncrement;
+	if (1e100 < solver->activities[variable])
+	{
+		for (unsigned int v = 0; v < solver->variableCount; ++v)
+		{
+			solver->activities[v] *= 1e-100;
+		}
+		solver->variableIncrement *= 1e-100;
+	}
+	if (0 <= solver->heapIndex[variable])
+	{
+		_heapUp(solver, (unsigned int)solver->heapIndex[variable]);
+	}
+}
+
+static void _bumpClause(SatSolver *solver, const unsigned int clause)
+{
+	solver->clauses[clause].activity += solver->clauseIncrement;
+	if (1e20 < solver->clauses[clause].activity)
+	{
+		for (unsigned int c = 0; c < solver->clauseCount; ++c)
+		{
+			solver->clauses[c].activity *= 1e-20;
+		}
+		solver->clauseIncrement *= 1e-20;
+	}
+}
+
+/**
+ * Returns true if a literal of a learnt clause is implied by the other ones
+ * (i.e., every other literal of its reason is in the clause, or is fixed at
+ * the root).
+ */
+static boolean _isRedundant(const SatSolver *solver, const SatLiteral literal)
+{
+	const int reason = solver->reasons[literal >> 1];
+	if (reason < 0)
+	{
+		return false;
+	}
+	const SatClause *clause = &solver->clauses[reason];
+	for (unsigned int k = 1; k < clause->size; ++k)
+	{
+		const unsigned int variable = clause->literals[k] >> 1;
+		if (!solver->seen[variable] && 0 < solver->levels[variable])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Learns a clause from a conflict, with the first unique implication point:
+ * the literals of the conflict are resolved with their reasons (backwards in
+ * the trail) until only one of them is from the current level. The learnt
+ * clause is left in "solver->learnt" (with the asserting literal first, and a
+ * literal of the backtrack level second). Returns its size.
+ */
+static unsigned int _analyze(SatSolver *solver, const int conflict, unsigned int *backtrackLevel, unsigned int *lbd)
+{
+	unsigned int size = 1;
+	unsigned int clearedCount = 0;
+	unsigned int pending = 0;
+	unsigned int index = solver->trailSize;
+	SatLiteral implied = 0;
+	boolean first = true;
+	int reason = conflict;
+	do
+	{
+		SatClause *clause = &solver->clauses[reason];
+		if (clause->learnt)
+		{
+			_bumpClause(solver, (unsigned int)reason);
+		}
+		for (unsigned int k = first ? 0 : 1; k < clause->size; ++k)
+		{
+			const SatLiteral literal = clause->literals[k];
+			const unsigned int variable = literal >> 1;
+			if (!solver->seen[variable] && 0 < solver->levels[variable])
+			{
+				solver->seen[variable] = 1;
+				solver->cleared[clearedCount++] = variable;
+				_bumpVariable(solver, variable);
+				if (solver->levels[variable] == solver->level)
+				{
+					pending += 1;
+				}
+				else
+				{
+					solver->learnt[size++] = literal;
+				}
+			}
+		}
+		do
+		{
+			index -= 1;
+		}
+		while (!solver->seen[solver->trail[index] >> 1]);
+		implied = solver->trail[index];
+		reason = solver->reasons[implied >> 1];
+		solver->seen[implied >> 1] = 0;
+		pending -= 1;
+		first = false;
+	}
+	while (0 < pending);
+	solver->learnt[0] = implied ^ 1;
+
+	// Removes the literals implied by the other ones.
+	unsigned int kept = 1;
+	for (unsigned int k = 1; k < size; ++k)
+	{
+		if (!_isRedundant(solver, solver->learnt[k]))
+		{
+			solver->learnt[kept++] = solver->learnt[k];
+		}
+	}
+	size = kept;
+	for (unsigned int k = 0; k < clearedCount; ++k)
+	{
+		solver->seen[solver->cleared[k]] = 0;
+	}
+
+	// The backtrack level is the highest one after the asserting literal's.
+	*backtrackLevel = 0;
+	for (unsigned int k = 1; k < size; ++k)
+	{
+		const unsigned int level = solver->levels[solver->learnt[k] >> 1];
+		if (*backtrackLevel < level)
+		{
+			*backtrackLevel = level;
+			const SatLiteral swap = solver->learnt[1];
+			solver->learnt[1] = solver->learnt[k];
+			solver->learnt[k] = swap;
+		}
+	}
+
+	// The amount of different decision levels (the seen marks are reused).
+	*lbd = 0;
+	for (unsigned int k = 0; k < size; ++k)
+	{
+		const unsigned int level = solver->levels[solver->learnt[k] >> 1];
+		if (!solver->seen[level])
+		{
+			solver->seen[level] = 1;
+			*lbd += 1;
+		}
+	}
+	for (unsigned int k = 0; k < size; ++k)
+	{
+		solver->seen[solver->levels[solver->learnt[k] >> 1]] = 0;
+	}
+	return size;
+}
+
+/**
+ * Unassigns every literal above a decision level, saving its phase (only the
+ * decision variables return to the heap).
+ */
+static void _backtrack(SatSolver *solver, const unsigned int level)
+{
+	if (level < solver->level)
+	{
+		const unsigned int start = solver->levelStarts[level];
+		for (unsigned int k = solver->trailSize; start < k; --k)
+		{
+			const unsigned int variable = solver->trail[k - 1] >> 1;
+			solver->phases[variable] = (unsigned char)solver->values[variable];
+			solver->values[variable] = -1;
+			solver->reasons[variable] = -1;
+			if (variable < solver->decisionCount)
+			{
+				_heapInsert(solver, variable);
+			}
+		}
+		solver->trailSize = start;
+		solver->propagated = start;
+		solver->level = level;
+	}
+}
+
+/**
+ * Sorts the learnt clauses by descending LBD, and then by ascending activity
+ * (i.e., the worst ones first).
+ */
+static int _compareLearnt(const void *left, const void *right)
+{
+	const SatClause *a = *(const SatClause *const *)left;
+	const SatClause *b = *(const SatClause *const *)right;
+	if (a->lbd != b->lbd)
+	{
+		return a->lbd < b->lbd ? 1 : -1;
+	}
+	if (a->activity != b->activity)
+	{
+		return a->activity < b->activity ? -1 : 1;
+	}
+	return 0;
+}
+
+/**
+ * Deletes the worst half of the learnt clauses, except the ones with at most
+ * 2 decision levels (the "glue" clauses), and the reasons of the current
+ * assignment.
+ */
+static void _reduce(SatSolver *solver)
+{
+	SatClause **candidates = malloc((1 + solver->learntCount) * sizeof(SatClause *));
+	unsigned int candidateCount = 0;
+	for (unsigned int c = 0; c < solver->clauseCount; ++c)
+	{
+		SatClause *clause = &solver->clauses[c];
+		if (clause->learnt && 2 < clause->lbd)
+		{
+			const unsigned int variable = clause->literals[0] >> 1;
+			if (solver->reasons[variable] != (int)c || solver->values[variable] < 0)
+			{
+				candidates[candidateCount++] = clause;
+			}
+		}
+	}
+	qsort(candidates, candidateCount, sizeof(SatClause *), _compareLearnt);
+	unsigned char *deleted = calloc(1 + solver->clauseCount, sizeof(unsigned char));
+	for (unsigned int k = 0; k < candidateCount / 2; ++k)
+	{
+		SatClause *clause = candidates[k];
+		const unsigned int index = (unsigned int)(clause - solver->clauses);
+		free(clause->literals);
+		clause->literals = NULL;
+		clause->size = 0;
+		clause->learnt = false;
+		deleted[index] = 1;
+		solver->freeClauses[solver->freeCount++] = index;
+		solver->learntCount -= 1;
+	}
+	for (unsigned int l = 0; l < 2 * solver->variableCount; ++l)
+	{
+		SatWatchList *list = &solver->watches[l];
+		unsigned int j = 0;
+		for (unsigned int i = 0; i < list->count; ++i)
+		{
+			if (!deleted[list->items[i].clause])
+			{
+				list->items[j++] = list->items[i];
+			}
+		}
+		list->count = j;
+	}
+	free(deleted);
+	free(candidates);
+}
+
+/**
+ * The Luby sequence (1, 1, 2, 1, 1, 2, 4, 1, ...), from index 0.
+ */
+static unsigned long long _luby(unsigned long long index)
+{
+	unsigned long long size = 1;
+	unsigned long long power = 1;
+	while (size < index + 1)
+	{
+		power *= 2;
+		size = 2 * size + 1;
+	}
+	while (size - 1 != index)
+	{
+		size = (size - 1) / 2;
+		power /= 2;
+		index %= size;
+	}
+	return power;
+}
+
+/**
+ * Assigns every unassigned variable its phase, once the decision variables
+ * are assigned. Returns false (and restores the heap of every variable, so
+ * the search decides them all) if an original clause becomes false.
+ */
+static boolean _complete(SatSolver *solver)
+{
+	for (unsigned int c = 0; c < solver->clauseCount; ++c)
+	{
+		const SatClause *clause = &solver->clauses[c];
+		if (clause->learnt || clause->literals == NULL)
+		{
+			continue;
+		}
+		boolean satisfied = false;
+		for (unsigned int k = 0; !satisfied && k < clause->size; ++k)
+		{
+			const SatLiteral literal = clause->literals[k];
+			const int value = _valueOf(solver, literal);
+			satisfied = value == 1 || (value < 0 && solver->phases[literal >> 1] == ((literal & 1) ^ 1));
+		}
+		if (!satisfied)
+		{
+			solver->decisionCount = solver->variableCount;
+			for (unsigned int v = 0; v < solver->variableCount; ++v)
+			{
+				if (solver->values[v] < 0)
+				{
+					_heapInsert(solver, v);
+				}
+			}
+			return false;
+		}
+	}
+	for (unsigned int v = 0; v < solver->variableCount; ++v)
+	{
+		if (solver->values[v] < 0)
+		{
+			solver->values[v] = (signed char)solver->phases[v];
+		}
+	}
+	return true;
+}
+
+/** PUBLIC FUNCTIONS */
+
+SatSolver *createSatSolver(const unsigned int variableCount)
+{
+	SatSolver *solver = calloc(1, sizeof(SatSolver));
+	solver->variableCount = variableCount;
+	solver->watches = calloc(1 + 2 * variableCount, sizeof(SatWatchList));
+	solver->values = malloc((1 + variableCount) * sizeof(signed char));
+	memset(solver->values, -1, (1 + variableCount) * sizeof(signed char));
+	solver->levels = calloc(1 + variableCount, sizeof(unsigned int));
+	solver->reasons = malloc((1 + variableCount) * sizeof(int));
+	solver->trail = malloc((1 + variableCount) * sizeof(SatLiteral));
+	solver->levelStarts = calloc(1 + variableCount, sizeof(unsigned int));
+	solver->activities = calloc(1 + variableCount, sizeof(double));
+	solver->variableIncrement = 1.0;
+	solver->clauseIncrement = 1.0;
+	solver->heap = malloc((1 + variableCount) * sizeof(unsigned int));
+	solver->heapIndex = malloc((1 + variableCount) * sizeof(int));
+	solver->phases = calloc(1 + variableCount, sizeof(unsigned char));
+	solver->seen = calloc(1 + variableCount, sizeof(unsigned char));
+	solver->learnt = malloc((1 + variableCount) * sizeof(SatLiteral));
+	solver->cleared = malloc((1 + variableCount) * sizeof(unsigned int));
+	for (unsigned int v = 0; v < variableCount; ++v)
+	{
+		solver->reasons[v] = -1;
+		solver->heap[v] = v;
+		solver->heapIndex[v] = (int)v;
+	}
+	solver->heapSize = variableCount;
+	solver->decisionCount = variableCount;
+	return solver;
+}
+
+void destroySatSolver(SatSolver *solver)
+{
+	if (solver != NULL)
+	{
+		for (unsigned int c = 0; c < solver->clauseCount; ++c)
+		{
+			free(solver->clauses[c].literals);
+		}
+		for (unsigned int l = 0; l < 2 * solver->variableCount; ++l)
+		{
+			free(solver->watches[l].items);
+		}
+		free(solver->clauses);
+		free(solver->freeClauses);
+		free(solver->watches);
+		free(solver->values);
+		free(solver->levels);
+		free(solver->reasons);
+		free(solver->trail);
+		free(solver->levelStarts);
+		free(solver->activities);
+		free(solver->heap);
+		free(solver->heapIndex);
+		free(solver->phases);
+		free(solver->seen);
+		free(solver->learnt);
+		free(solver->cleared);
+		free(solver);
+	}
+}
+
+boolean addSatClause(SatSolver *solver, const SatLiteral *literals, const unsigned int size)
+{
+	if (solver->inconsistent)
+	{
+		return false;
+	}
+
+	// Keeps the literals that are not false at the root, once each (the seen
+	// mark of a variable is 1 + the sign of its literal in the clause).
+	SatLiteral *clause = solver->learnt;
+	unsigned int kept = 0;
+	boolean satisfied = false;
+	for (unsigned int k = 0; !satisfied && k < size; ++k)
+	{
+		const SatLiteral literal = literals[k];
+		const unsigned int variable = literal >> 1;
+		const unsigned char mark = (unsigned char)(1 + (literal & 1));
+		const int value = _valueOf(solver, literal);
+		if (value == 1 || (solver->seen[variable] != 0 && solver->seen[variable] != mark))
+		{
+			satisfied = true;
+		}
+		else if (value < 0 && solver->seen[variable] == 0)
+		{
+			solver->seen[variable] = mark;
+			clause[kept++] = literal;
+		}
+	}
+	for (unsigned int k = 0; k < kept; ++k)
+	{
+		solver->seen[clause[k] >> 1] = 0;
+	}
+	if (satisfied)
+	{
+		return true;
+	}
+	if (kept == 0)
+	{
+		solver->inconsistent = true;
+		return false;
+	}
+	if (kept == 1)
+	{
+		_enqueue(solver, clause[0], -1);
+		if (0 <= _propagate(solver))
+		{
+			solver->inconsistent = true;
+			return false;
+		}
+		return true;
+	}
+	_store(solver, clause, kept, false);
+	return true;
+}
+
+SolverStatus solveSat(SatSolver *solver)
+{
+	if (solver->inconsistent || 0 <= _propagate(solver))
+	{
+		solver->inconsistent = true;
+		return SOLVER_UNSATISFIABLE;
+	}
+	double learntLimit = solver->clauseCount / 3.0;
+	if (learntLimit < MINIMUM_LEARNT_LIMIT)
+	{
+		learntLimit = MINIMUM_LEARNT_LIMIT;
+	}
+	unsigned long long restartLimit = RESTART_UNIT * _luby(0);
+	unsigned long long restartConflicts = 0;
+	while (true)
+	{
+		const int conflict = _propagate(solver);
+		if (0 <= conflict)
+		{
+			solver->conflicts += 1;
+			restartConflicts += 1;
+			if (solver->level == 0)
+			{
+				solver->inconsistent = true;
+				return SOLVER_UNSATISFIABLE;
+			}
+			if (solver->conflicts % DEADLINE_POLL_CONFLICTS == 0 && isDeadlineExpired())
+			{
+				return SOLVER_TIMEOUT;
+			}
+			unsigned int backtrackLevel;
+			unsigned int lbd;
+			const unsigned int size = _analyze(solver, conflict, &backtrackLevel, &lbd);
+			_backtrack(solver, backtrackLevel);
+			if (size == 1)
+			{
+				_enqueue(solver, solver->learnt[0], -1);
+			}
+			else
+			{
+				const unsigned int clause = _store(solver, solver->learnt, size, true);
+				solver->clauses[clause].lbd = lbd;
+				_bumpClause(solver, clause);
+				_enqueue(solver, solver->learnt[0], (int)clause);
+			}
+			solver->variableIncrement /= VARIABLE_DECAY;
+			solver->clauseIncrement /= CLAUSE_DECAY;
+			continue;
+		}
+		if (restartLimit <= restartConflicts)
+		{
+			_backtrack(solver, 0);
+			solver->restarts += 1;
+			restartConflicts = 0;
+			restartLimit = RESTART_UNIT * _luby(solver->restarts);
+		}
+		if (learntLimit <= solver->learntCount)
+		{
+			_reduce(solver);
+			learntLimit *= 1.1;
+		}
+		unsigned int variable = solver->variableCount;
+		while (0 < solver->heapSize && variable == solver->variableCount)
+		{
+			const unsigned int candidate = _heapPop(solver);
+			if (solver->values[candidate] < 0 && candidate < solver->decisionCount)
+			{
+				variable = candidate;
+			}
+		}
+		if (variable == solver->variableCount && (solver->decisionCount == solver->variableCount || _complete(solver)))
+		{
+			return SOLVER_SATISFIABLE;
+		}
+		if (variable == solver->variableCount)
+		{
+			continue;
+		}
+		solver->decisions += 1;
+		solver->levelStarts[solver->level] = solver->trailSize;
+		solver->level += 1;
+		_enqueue(solver, solver->phases[variable] ? satPositive(variable) : satNegative(variable), -1);
+	}
+}
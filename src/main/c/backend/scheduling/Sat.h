@@ -0,0 +1,163 @@
+#ifndef SAT_HEADER
+#define SAT_HEADER
+
+#include "../../shared/Type.h"
+#include "Solver.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * A literal of the solver: "2 * variable" if it's positive, or
+ * "2 * variable + 1" if it's negated.
+ */
+typedef unsigned int SatLiteral;
+
+/**
+ * A clause (original or learnt). Its first two literals are the watched ones,
+ * and the first one is the implied literal when the clause is a reason.
+ */
+typedef struct {
+	SatLiteral * literals;
+	unsigned int size;
+	unsigned int lbd;
+	double activity;
+	boolean learnt;
+} SatClause;
+
+/**
+ * A clause that watches a literal, and other literal of it (the blocker): if
+ * the blocker is true, the clause is satisfied without visiting it.
+ */
+typedef struct {
+	unsigned int clause;
+	SatLiteral blocker;
+} SatWatch;
+
+typedef struct {
+	SatWatch * items;
+	unsigned int count;
+	unsigned int capacity;
+} SatWatchList;
+
+/**
+ * A CDCL solver (conflict-driven clause learning) over a fixed set of
+ * variables: unit propagation with two watched literals per clause, learnt
+ * clauses from the first unique implication point of every conflict (with
+ * their redundant literals removed), VSIDS decisions (a heap of variables by
+ * activity) with phase saving, restarts by the Luby sequence, and a periodic
+ * reduction of the learnt clauses (keeping the ones with few decision levels,
+ * and the active ones).
+ */
+typedef struct {
+	unsigned int variableCount;
+
+	SatClause * clauses;
+	unsigned int clauseCount;
+	unsigned int clauseCapacity;
+	unsigned int * freeClauses;
+	unsigned int freeCount;
+	unsigned int learntCount;
+
+	// The clauses that watch each literal.
+	SatWatchList * watches;
+
+	// The value of each variable (-1 if unassigned, 0 or 1), its decision
+	// level, and the clause that implied it (or -1).
+	signed char * values;
+	unsigned int * levels;
+	int * reasons;
+
+	// The assigned literals in order, the first one of each decision level,
+	// and the first one not propagated yet.
+	SatLiteral * trail;
+	unsigned int trailSize;
+	unsigned int * levelStarts;
+	unsigned int level;
+	unsigned int propagated;
+
+	// The activity of each variable, in a max-heap of the unassigned ones
+	// (heapIndex is -1 outside of the heap).
+	double * activities;
+	double variableIncrement;
+	double clauseIncrement;
+	unsigned int * heap;
+	unsigned int heapSize;
+	int * heapIndex;
+
+	// The last value of each variable, and the marks of the conflict analysis.
+	unsigned char * phases;
+	unsigned char * seen;
+	SatLiteral * learnt;
+	unsigned int * cleared;
+
+	// The variables that the search decides: [0, decisionCount).
+	unsigned int decisionCount;
+
+	// True if a clause is falsified at the root (so it's unsatisfiable).
+	boolean inconsistent;
+
+	unsigned long long conflicts;
+	unsigned long long decisions;
+	unsigned long long propagations;
+	unsigned long long restarts;
+} SatSolver;
+
+/**
+ * Creates a solver without clauses, over the variables [0, variableCount).
+ */
+SatSolver * createSatSolver(const unsigned int variableCount);
+
+/**
+ * Destroy a solver and its resources.
+ */
+void destroySatSolver(SatSolver * solver);
+
+/**
+ * Adds a clause (before solving). Duplicated literals are removed, and a
+ * tautology is ignored. Returns false if the solver became inconsistent.
+ */
+boolean addSatClause(SatSolver * solver, const SatLiteral * literals, const unsigned int size);
+
+/**
+ * Sets the value that the search tries first for a variable (false by
+ * default), until it learns a better one.
+ */
+static inline void setSatPhase(SatSolver * solver, const unsigned int variable, const boolean value) {
+	solver->phases[variable] = value ? 1 : 0;
+}
+
+/**
+ * Limits the decisions of the search to the variables [0, count) (e.g., the
+ * ones that an encoding defines the other ones from). Once they are assigned
+ * without conflict, every other unassigned variable takes its phase; if that
+ * falsifies an original clause, the search goes on deciding every variable.
+ */
+static inline void setSatDecisionCount(SatSolver * solver, const unsigned int count) {
+	solver->decisionCount = count < solver->variableCount ? count : solver->variableCount;
+}
+
+/**
+ * Searches an assignment that satisfies every clause. It's complete, so
+ * SOLVER_UNSATISFIABLE proves that there is none. It stops with
+ * SOLVER_TIMEOUT if the time limit expires first (see "SOLVER_TIME_LIMIT").
+ */
+SolverStatus solveSat(SatSolver * solver);
+
+/**
+ * The value of a variable, after a satisfiable search.
+ */
+static inline boolean satValue(const SatSolver * solver, const unsigned int variable) {
+	return solver->values[variable] == 1 ? true : false;
+}
+
+/** The positive literal of a variable. */
+static inline SatLiteral satPositive(const unsigned int variable) {
+	return 2 * variable;
+}
+
+/** The negated literal of a variable. */
+static inline SatLiteral satNegative(const unsigned int variable) {
+	return 2 * variable + 1;
+}
+
+#endif
@@ -0,0 +1,587 @@
+#include "SatEncoding.h"
+
+/* MODULE INTERNAL STATE */
+
+/**
+ * A literal that belongs to the group of an "at most" constraint (e.g., the
+ * group of a professor and a week-slot).
+ */
+typedef struct
+{
+	unsigned int group;
+	SatLiteral literal;
+} GroupMember;
+
+/**
+ * The members of the groups of a kind of constraint, in any order.
+ */
+typedef struct
+{
+	GroupMember *members;
+	unsigned int count;
+	unsigned int capacity;
+} GroupList;
+
+static Logger *_logger = NULL;
+
+void initializeSatEncodingModule()
+{
+	_logger = createLogger("SatEncoding");
+}
+
+void shutdownSatEncodingModule()
+{
+	if (_logger != NULL)
+	{
+		destroyLogger(_logger);
+	}
+}
+
+/** PRIVATE FUNCTIONS */
+
+static unsigned int _newVariable(CnfFormula *formula);
+static void _addClause(CnfFormula *formula, const SatLiteral *literals, const unsigned int size);
+static void _addBinary(CnfFormula *formula, const SatLiteral first, const SatLiteral second);
+static void _atMost(CnfFormula *formula, const SatLiteral *literals, const unsigned int size, const unsigned int bound);
+static void _exactlyOne(CnfFormula *formula, const unsigned int firstVariable, const unsigned int size);
+static void _addMember(GroupList *list, const unsigned int group, const SatLiteral literal);
+static void _atMostPerGroup(CnfFormula *formula, const GroupList *list, const unsigned int groupCount, const unsigned int bound);
+static unsigned int _breakClassroomSymmetry(CnfFormula *formula, const Model *model);
+static void _writeLiteral(FILE *file, const SatLiteral literal);
+
+static unsigned int _newVariable(CnfFormula *formula)
+{
+	formula->variableCount += 1;
+	return formula->variableCount - 1;
+}
+
+static void _addClause(CnfFormula *formula, const SatLiteral *literals, const unsigned int size)
+{
+	if (formula->literalCapacity < formula->literalCount + size)
+	{
+		while (formula->literalCapacity < formula->literalCount + size)
+		{
+			formula->literalCapacity = formula->literalCapacity < 1024 ? 1024 : 2 * formula->literalCapacity;
+		}
+		formula->literals = realloc(formula->literals, formula->literalCapacity * sizeof(SatLiteral));
+	}
+	if (formula->clauseCount == formula->clauseCapacity)
+	{
+		formula->clauseCapacity = formula->clauseCapacity < 256 ? 256 : 2 * formula->clauseCapacity;
+		formula->clauseEnds = realloc(formula->clauseEnds, formula->clauseCapacity * sizeof(unsigned int));
+	}
+	memcpy(formula->literals + formula->literalCount, literals, size * sizeof(SatLiteral));
+	formula->literalCount += size;
+	formula->clauseEnds[formula->clauseCount] = formula->literalCount;
+	formula->clauseCount += 1;
+}
+
+static void _addBinary(CnfFormula *formula, const SatLiteral first, const SatLiteral second)
+{
+	const SatLiteral literals[2] = {first, second};
+	_addClause(formula, literals, 2);
+}
+
+/**
+ * At most "bound" of the literals are true. A small group with a bound of 1
+ * has a clause per pair; otherwise, it's a sequential counter (Sinz): the
+ * register "counts[j]" after the literal i means "at least j + 1 of the
+ * literals up to i are true", so only the registers with j <= i exist.
+ */
+static void _atMost(CnfFormula *formula, const SatLiteral *literals, const unsigned int size, const unsigned int bound)
+{
+	if (size <= bound)
+	{
+		return;
+	}
+	if (bound == 0)
+	{
+		for (unsigned int i = 0; i < size; ++i)
+		{
+			const SatLiteral negation = literals[i] ^ 1;
+			_addClause(formula, &negation, 1);
+		}
+		return;
+	}
+	if (bound == 1 && size <= MAXIMUM_PAIRWISE_GROUP)
+	{
+		for (unsigned int i = 0; i < size; ++i)
+		{
+			for (unsigned int j = i + 1; j < size; ++j)
+			{
+				_addBinary(formula, literals[i] ^ 1, literals[j] ^ 1);
+			}
+		}
+		return;
+	}
+	int *previous = malloc(bound * sizeof(int));
+	int *current = malloc(bound * sizeof(int));
+	for (unsigned int j = 0; j < bound; ++j)
+	{
+		previous[j] = -1;
+	}
+	for (unsigned int i = 0; i < size; ++i)
+	{
+		const SatLiteral negation = literals[i] ^ 1;
+		if (0 <= previous[bound - 1])
+		{
+			_addBinary(formula, negation, satNegative((unsigned int)previous[bound - 1]));
+		}
+		if (i + 1 == size)
+		{
+			break;
+		}
+		for (unsigned int j = 0; j < bound; ++j)
+		{
+			current[j] = j <= i ? (int)_newVariable(formula) : -1;
+			if (current[j] < 0)
+			{
+				continue;
+			}
+			const SatLiteral counter = satPositive((unsigned int)current[j]);
+			if (j == 0)
+			{
+				_addBinary(formula, negation, counter);
+			}
+			else if (0 <= previous[j - 1])
+			{
+				const SatLiteral carry[3] = {negation, satNegative((unsigned int)previous[j - 1]), counter};
+				_addClause(formula, carry, 3);
+			}
+			if (0 <= previous[j])
+			{
+				_addBinary(formula, satNegative((unsigned int)previous[j]), counter);
+			}
+		}
+		int *swap = previous;
+		previous = current;
+		current = swap;
+	}
+	free(previous);
+	free(current);
+}
+
+/**
+ * Exactly one of the consecutive variables is true.
+ */
+static void _exactlyOne(CnfFormula *formula, const unsigned int firstVariable, const unsigned int size)
+{
+	SatLiteral *literals = calloc(1 + size, sizeof(SatLiteral));
+	for (unsigned int k = 0; k < size; ++k)
+	{
+		literals[k] = satPositive(firstVariable + k);
+	}
+	_addClause(formula, literals, size);
+	_atMost(formula, literals, size, 1);
+	free(literals);
+}
+
+static void _addMember(GroupList *list, const unsigned int group, const SatLiteral literal)
+{
+	if (list->count == list->capacity)
+	{
+		list->capacity = list->capacity < 256 ? 256 : 2 * list->capacity;
+		list->members = realloc(list->members, list->capacity * sizeof(GroupMember));
+	}
+	list->members[list->count].group = group;
+	list->members[list->count].literal = literal;
+	list->count += 1;
+}
+
+/**
+ * At most "bound" literals of each group are true. The members are sorted by
+ * group with a counting sort, so each group is contiguous.
+ */
+static void _atMostPerGroup(CnfFormula *formula, const GroupList *list, const unsigned int groupCount, const unsigned int bound)
+{
+	unsigned int *starts = calloc(2 + groupCount, sizeof(unsigned int));
+	for (unsigned int m = 0; m < list->count; ++m)
+	{
+		starts[list->members[m].group + 2] += 1;
+	}
+	for (unsigned int g = 0; g < groupCount; ++g)
+	{
+		starts[g + 2] += starts[g + 1];
+	}
+	SatLiteral *literals = malloc((1 + list->count) * sizeof(SatLiteral));
+	for (unsigned int m = 0; m < list->count; ++m)
+	{
+		literals[starts[list->members[m].group + 1]++] = list->members[m].literal;
+	}
+	for (unsigned int g = 0; g < groupCount; ++g)
+	{
+		_atMost(formula, literals + starts[g], starts[g + 1] - starts[g], bound);
+	}
+	free(literals);
+	free(starts);
+}
+
+/**
+ * Breaks the symmetry of the interchangeable classrooms (see
+ * "classroomClasses"): the classrooms of a class can be permuted in any
+ * schedule, so only the ones where each classroom of a class is first used
+ * after the previous one (by ascending symbol, in order of session) remain,
+ * i.e., a value precedence. The variable "used[j]" after a session means
+ * that the j-th classroom of the class hosts that session or an earlier one.
+ *
+ * A class is ignored if some session has only some of its classrooms (e.g.,
+ * a kept session of a repair, pinned to its previous classroom), since they
+ * are not interchangeable for it. Returns the amount of classes broken.
+ */
+static unsigned int _breakClassroomSymmetry(CnfFormula *formula, const Model *model)
+{
+	const unsigned int classroomCount = model->classroomCount;
+
+	// The classrooms of each class, by ascending symbol: [starts[first],
+	// starts[first + 1]), where "first" is the first classroom of the class.
+	unsigned int *starts = calloc(2 + classroomCount, sizeof(unsigned int));
+	for (unsigned int r = 0; r < classroomCount; ++r)
+	{
+		starts[model->classroomClasses[r] + 2] += 1;
+	}
+	for (unsigned int r = 0; r < classroomCount; ++r)
+	{
+		starts[r + 2] += starts[r + 1];
+	}
+	SymbolId *members = calloc(1 + classroomCount, sizeof(SymbolId));
+	for (unsigned int r = 0; r < classroomCount; ++r)
+	{
+		members[starts[model->classroomClasses[r] + 1]++] = r;
+	}
+
+	// Discards the classes that some session splits.
+	unsigned int *present = calloc(1 + classroomCount, sizeof(unsigned int));
+	boolean *split = calloc(1 + classroomCount, sizeof(boolean));
+	for (unsigned int s = 0; s < model->sessionCount; ++s)
+	{
+		const Session *session = &model->sessions[s];
+		for (unsigned int k = session->firstRoom; k < session->firstRoom + session->roomCount; ++k)
+		{
+			present[model->classroomClasses[model->rooms[k]]] += 1;
+		}
+		for (unsigned int k = session->firstRoom; k < session->firstRoom + session->roomCount; ++k)
+		{
+			const SymbolId first = model->classroomClasses[model->rooms[k]];
+			split[first] = split[first] || present[first] != starts[first + 1] - starts[first];
+		}
+		for (unsigned int k = session->firstRoom; k < session->firstRoom + session->roomCount; ++k)
+		{
+			present[model->classroomClasses[model->rooms[k]]] = 0;
+		}
+	}
+
+	// The last "used" variable of each classroom (or -1, before its first
+	// session), and the position of each classroom in the current session.
+	int *used = malloc((1 + classroomCount) * sizeof(int));
+	int *positions = malloc((1 + classroomCount) * sizeof(int));
+	memset(used, -1, (1 + classroomCount) * sizeof(int));
+	memset(positions, -1, (1 + classroomCount) * sizeof(int));
+	for (unsigned int s = 0; s < model->sessionCount; ++s)
+	{
+		const Session *session = &model->sessions[s];
+		for (unsigned int k = 0; k < session->roomCount; ++k)
+		{
+			positions[model->rooms[session->firstRoom + k]] = (int)k;
+		}
+		for (unsigned int k = 0; k < session->roomCount; ++k)
+		{
+			const SymbolId first = model->classroomClasses[model->rooms[session->firstRoom + k]];
+			const unsigned int size = starts[first + 1] - starts[first];
+			if (first != model->rooms[session->firstRoom + k] || size < 2 || split[first])
+			{
+				continue;
+			}
+			const int *last = used + starts[first];
+			for (unsigned int j = 1; j < size; ++j)
+			{
+				// The j-th classroom requires the previous one already used.
+				const SatLiteral room = satNegative(formula->roomVariables[s] + (unsigned int)positions[members[starts[first] + j]]);
+				if (last[j - 1] < 0)
+				{
+					_addClause(formula, &room, 1);
+				}
+				else
+				{
+					_addBinary(formula, room, satPositive((unsigned int)last[j - 1]));
+				}
+			}
+			for (unsigned int j = 0; j + 1 < size; ++j)
+			{
+				const unsigned int room = formula->roomVariables[s] + (unsigned int)positions[members[starts[first] + j]];
+				const unsigned int current = _newVariable(formula);
+				_addBinary(formula, satNegative(room), satPositive(current));
+				if (last[j] < 0)
+				{
+					_addBinary(formula, satNegative(current), satPositive(room));
+				}
+				else
+				{
+					const SatLiteral clause[3] = {satNegative(current), satPositive((unsigned int)last[j]), satPositive(room)};
+					_addBinary(formula, satNegative((unsigned int)last[j]), satPositive(current));
+					_addClause(formula, clause, 3);
+				}
+				used[starts[first] + j] = (int)current;
+			}
+		}
+		for (unsigned int k = 0; k < session->roomCount; ++k)
+		{
+			positions[model->rooms[session->firstRoom + k]] = -1;
+		}
+	}
+
+	unsigned int broken = 0;
+	for (unsigned int r = 0; r < classroomCount; ++r)
+	{
+		if (model->classroomClasses[r] == (SymbolId)r && 1 < starts[r + 1] - starts[r] && !split[r] && 0 <= used[starts[r]])
+		{
+			broken += 1;
+		}
+	}
+	free(starts);
+	free(members);
+	free(present);
+	free(split);
+	free(used);
+	free(positions);
+	return broken;
+}
+
+/**
+ * Writes a literal in DIMACS (the variable v is "v + 1", and its negation is
+ * "-(v + 1)").
+ */
+static void _writeLiteral(FILE *file, const SatLiteral literal)
+{
+	fprintf(file, "%s%u ", (literal & 1) ? "-" : "", (literal >> 1) + 1);
+}
+
+/** PUBLIC FUNCTIONS */
+
+CnfFormula *encodeModel(const Model *model)
+{
+	const unsigned int slotCount = model->grid.slotCount;
+	CnfFormula *formula = calloc(1, sizeof(CnfFormula));
+	formula->variableCount = model->placementCount;
+	formula->roomVariables = calloc(1 + model->sessionCount, sizeof(unsigned int));
+	for (unsigned int s = 0; s < model->sessionCount; ++s)
+	{
+		formula->roomVariables[s] = formula->variableCount;
+		if (model->usesClassrooms)
+		{
+			formula->variableCount += model->sessions[s].roomCount;
+		}
+	}
+	formula->valueCount = formula->variableCount;
+
+	// Every session takes exactly one placement and one classroom.
+	for (unsigned int s = 0; s < model->sessionCount; ++s)
+	{
+		const Session *session = &model->sessions[s];
+		_exactlyOne(formula, session->firstPlacement, session->placementCount);
+		if (model->usesClassrooms)
+		{
+			_exactlyOne(formula, formula->roomVariables[s], session->roomCount);
+		}
+	}
+
+	// The professors, and the courses (by day, and by week-slot if a course
+	// has more than one session a day).
+	GroupList professors = {NULL, 0, 0};
+	GroupList courses = {NULL, 0, 0};
+	GroupList courseSlots = {NULL, 0, 0};
+	for (unsigned int s = 0; s < model->sessionCount; ++s)
+	{
+		const Session *session = &model->sessions[s];
+		for (unsigned int p = session->firstPlacement; p < session->firstPlacement + session->placementCount; ++p)
+		{
+			const Placement *placement = &model->placements[p];
+			const unsigned int weekSlot = placementWeekSlot(model, placement);
+			for (unsigned int t = 0; t < session->length; ++t)
+			{
+				_addMember(&professors, placement->professor * slotCount + weekSlot + t, satPositive(p));
+			}
+			_addMember(&courses, session->course * WEEK_DAY_COUNT + placement->day, satPositive(p));
+			for (unsigned int t = 0; 1 < model->sessionsPerDay && t < session->length; ++t)
+			{
+				_addMember(&courseSlots, session->course * slotCount + weekSlot + t, satPositive(p));
+			}
+		}
+	}
+	_atMostPerGroup(formula, &professors, model->professorCount * slotCount, 1);
+	_atMostPerGroup(formula, &courses, model->courseCount * WEEK_DAY_COUNT, model->sessionsPerDay);
+	_atMostPerGroup(formula, &courseSlots, model->courseCount * slotCount, 1);
+	free(professors.members);
+	free(courses.members);
+	free(courseSlots.members);
+
+	// The classrooms: "occupies[w]" means that the session occupies the
+	// week-slot w, and it occupies its classroom too (if it has more than
+	// one, through a variable per classroom and week-slot).
+	if (model->usesClassrooms)
+	{
+		GroupList classrooms = {NULL, 0, 0};
+		int *occupies = malloc((1 + slotCount) * sizeof(int));
+		unsigned int *slots = malloc((1 + slotCount) * sizeof(unsigned int));
+		for (unsigned int s = 0; s < model->sessionCount; ++s)
+		{
+			const Session *session = &model->sessions[s];
+			unsigned int slotTotal = 0;
+			memset(occupies, -1, (1 + slotCount) * sizeof(int));
+			for (unsigned int p = session->firstPlacement; p < session->firstPlacement + session->placementCount; ++p)
+			{
+				const unsigned int weekSlot = placementWeekSlot(model, &model->placements[p]);
+				for (unsigned int t = 0; t < session->length; ++t)
+				{
+					if (occupies[weekSlot + t] < 0)
+					{
+						occupies[weekSlot + t] = (int)_newVariable(formula);
+						slots[slotTotal++] = weekSlot + t;
+					}
+					_addBinary(formula, satNegative(p), satPositive((unsigned int)occupies[weekSlot + t]));
+				}
+			}
+			for (unsigned int k = 0; k < session->roomCount; ++k)
+			{
+				const SymbolId classroom = model->rooms[session->firstRoom + k];
+				for (unsigned int w = 0; w < slotTotal; ++w)
+				{
+					const SatLiteral occupation = satPositive((unsigned int)occupies[slots[w]]);
+					if (session->roomCount == 1)
+					{
+						_addMember(&classrooms, classroom * slotCount + slots[w], occupation);
+						continue;
+					}
+					const unsigned int hosts = _newVariable(formula);
+					const SatLiteral clause[3] = {satNegative(formula->roomVariables[s] + k), occupation ^ 1, satPositive(hosts)};
+					_addClause(formula, clause, 3);
+					_addMember(&classrooms, classroom * slotCount + slots[w], satPositive(hosts));
+				}
+			}
+		}
+		_atMostPerGroup(formula, &classrooms, model->classroomCount * slotCount, 1);
+		free(classrooms.members);
+		free(occupies);
+		free(slots);
+		if (0 < model->classroomClassCount)
+		{
+			const unsigned int broken = _breakClassroomSymmetry(formula, model);
+			logDebugging(_logger, "The symmetry of %u of %u class(es) of interchangeable classrooms is broken.", broken, model->classroomClassCount);
+		}
+	}
+	return formula;
+}
+
+void destroyCnfFormula(CnfFormula *formula)
+{
+	if (formula != NULL)
+	{
+		free(formula->roomVariables);
+		free(formula->literals);
+		free(formula->clauseEnds);
+		free(formula);
+	}
+}
+
+boolean exportDimacs(const Model *model, const char *path)
+{
+	FILE *file = fopen(path, "w");
+	if (file == NULL)
+	{
+		logWarning(_logger, "Cannot write the DIMACS encoding \"%s\".", path);
+		return false;
+	}
+	CnfFormula *formula = encodeModel(model);
+	const Program *program = model->program;
+	fprintf(file, "c Encoding of %u session(s) with %u placement(s).\n", model->sessionCount, model->placementCount);
+	for (unsigned int s = 0; s < model->sessionCount; ++s)
+	{
+		const Session *session = &model->sessions[s];
+		for (unsigned int p = session->firstPlacement; p < session->firstPlacement + session->placementCount; ++p)
+		{
+			const Placement *placement = &model->placements[p];
+			fprintf(file, "c placement %u session %u %s %s day %u slot %u\n", p + 1, s, program->courses[session->course].id,
+					program->professors[placement->professor].id, placement->day, placement->slot);
+		}
+		for (unsigned int k = 0; model->usesClassrooms && k < session->roomCount; ++k)
+		{
+			fprintf(file, "c classroom %u session %u %s\n", formula->roomVariables[s] + k + 1, s,
+					program->classrooms[model->rooms[session->firstRoom + k]].id);
+		}
+	}
+	fprintf(file, "p cnf %u %u\n", formula->variableCount, formula->clauseCount);
+	unsigned int start = 0;
+	for (unsigned int c = 0; c < formula->clauseCount; ++c)
+	{
+		for (unsigned int k = start; k < formula->clauseEnds[c]; ++k)
+		{
+			_writeLiteral(file, formula->literals[k]);
+		}
+		fprintf(file, "0\n");
+		start = formula->clauseEnds[c];
+	}
+	const boolean written = ferror(file) == 0;
+	fclose(file);
+	if (written)
+	{
+		logInformation(_logger, "Writes the DIMACS encoding \"%s\": %u variable(s) and %u clause(s).", path, formula->variableCount, formula->clauseCount);
+	}
+	else
+	{
+		logWarning(_logger, "Cannot write the DIMACS encoding \"%s\".", path);
+	}
+	destroyCnfFormula(formula);
+	return written;
+}
+
+Optimization *satisfyModel(const Model *model, const ScheduleListener *listener)
+{
+	CnfFormula *formula = encodeModel(model);
+	SatSolver *solver = createSatSolver(formula->variableCount);
+	for (unsigned int v = 0; v < formula->valueCount; ++v)
+	{
+		setSatPhase(solver, v, true);
+	}
+	setSatDecisionCount(solver, formula->valueCount);
+	unsigned int start = 0;
+	for (unsigned int c = 0; c < formula->clauseCount; ++c)
+	{
+		addSatClause(solver, formula->literals + start, formula->clauseEnds[c] - start);
+		start = formula->clauseEnds[c];
+	}
+	logDebugging(_logger, "Solving %u session(s) with %u variable(s) and %u clause(s)...", model->sessionCount, formula->variableCount, formula->clauseCount);
+	Optimization *optimization = calloc(1, sizeof(Optimization));
+	optimization->status = solveSat(solver);
+	optimization->preferenceCount = model->softPreferenceCount;
+	optimization->maximumScore = model->maximumScore;
+	optimization->nodes = solver->decisions;
+	logDebugging(_logger, "The search is done after %llu conflict(s), %llu decision(s) and %llu restart(s).", solver->conflicts, solver->decisions, solver->restarts);
+	if (optimization->status == SOLVER_SATISFIABLE)
+	{
+		optimization->assignments = calloc(1 + model->sessionCount, sizeof(Assignment));
+		for (unsigned int s = 0; s < model->sessionCount; ++s)
+		{
+			const Session *session = &model->sessions[s];
+			Assignment *assignment = &optimization->assignments[s];
+			assignment->placement = -1;
+			assignment->classroom = UNDEFINED_SYMBOL;
+			for (unsigned int p = session->firstPlacement; p < session->firstPlacement + session->placementCount; ++p)
+			{
+				if (satValue(solver, p))
+				{
+					assignment->placement = (int)p;
+				}
+			}
+			for (unsigned int k = 0; model->usesClassrooms && k < session->roomCount; ++k)
+			{
+				if (satValue(solver, formula->roomVariables[s] + k))
+				{
+					assignment->classroom = model->rooms[session->firstRoom + k];
+				}
+			}
+		}
+		notifySchedule(listener, model, optimization->assignments, 0);
+	}
+	destroySatSolver(solver);
+	destroyCnfFormula(formula);
+	return optimization;
+}
@@ -0,0 +1,91 @@
+#ifndef SAT_ENCODING_HEADER
+#define SAT_ENCODING_HEADER
+
+#include "../../shared/Logger.h"
+#include "../../shared/Type.h"
+#include "Model.h"
+#include "Optimizer.h"
+#include "Sat.h"
+#include "Solver.h"
+#include <stdio.h>
+
+/** Initialize module's internal state. */
+void initializeSatEncodingModule();
+
+/** Shutdown module's internal state. */
+void shutdownSatEncodingModule();
+
+/**
+ * The largest group of an "at most one" constraint that is encoded with a
+ * clause per pair of literals (a larger one uses a sequential counter).
+ */
+#define MAXIMUM_PAIRWISE_GROUP 6
+
+/**
+ * The CNF encoding of a model. The variable of a placement is its index (so
+ * it means "the session takes that placement"), and the variable of the k-th
+ * classroom of a session is "roomVariables[session] + k" (only if the model
+ * uses classrooms). These are the first "valueCount" variables, and the
+ * remaining ones are auxiliary.
+ *
+ * The clauses are stored contiguously: the clause c is [clauseEnds[c - 1],
+ * clauseEnds[c]) of the literals (from 0 for the first one).
+ */
+typedef struct {
+	unsigned int variableCount;
+	unsigned int valueCount;
+	unsigned int * roomVariables;
+
+	SatLiteral * literals;
+	unsigned int literalCount;
+	unsigned int literalCapacity;
+
+	unsigned int * clauseEnds;
+	unsigned int clauseCount;
+	unsigned int clauseCapacity;
+} CnfFormula;
+
+/**
+ * Encodes the hard constraints of a model in CNF. The unary constraints
+ * (availability, qualification, capacity, features and the hard preferences)
+ * are already in the domains, so they need no clauses: a value outside of
+ * them has no variable. The clauses are:
+ *
+ *  - every session takes exactly one placement, and exactly one classroom;
+ *  - a professor teaches at most one session in each week-slot;
+ *  - a course has at most "sessionsPerDay" sessions in each day, and at most
+ *    one in each week-slot;
+ *  - a classroom hosts at most one session in each week-slot (through a
+ *    variable per session and week-slot that it may occupy, and other per
+ *    classroom of it);
+ *  - the interchangeable classrooms of a class are used in order (i.e., the
+ *    first session of each one comes after the first session of the previous
+ *    one), so their permutations are never explored.
+ *
+ * Every "at most" constraint over more than "MAXIMUM_PAIRWISE_GROUP"
+ * literals is a sequential counter, so the formula grows linearly.
+ */
+CnfFormula * encodeModel(const Model * model);
+
+/**
+ * Destroy a formula and its resources.
+ */
+void destroyCnfFormula(CnfFormula * formula);
+
+/**
+ * Writes the encoding of a model to a file in DIMACS format (e.g., to
+ * benchmark external solvers), with comments that map every placement and
+ * classroom variable to its session. Returns false (after logging the
+ * reason) if the file cannot be written.
+ */
+boolean exportDimacs(const Model * model, const char * path);
+
+/**
+ * Solves a model with its encoding and the CDCL solver. It searches a
+ * schedule (the soft preferences are ignored), so the listener only receives
+ * the final one. Since the search is complete (including the classrooms), an
+ * unsatisfiable result proves that there is no schedule.
+ */
+Optimization * satisfyModel(const Model * model, const ScheduleListener * listener);
+
+#endif
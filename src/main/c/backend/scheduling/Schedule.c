@@ -0,0 +1,108 @@
+#include "Schedule.h"
+
+/* MODULE INTERNAL STATE */
+
+static const char *const _days[] = {"MONDAY", "TUESDAY", "WEDNESDAY", "THURSDAY", "FRIDAY", "EVERYDAY"};
+
+/** PRIVATE FUNCTIONS */
+
+static int _compareScheduledSessions(const void *left, const void *right);
+
+static int _compareScheduledSessions(const void *left, const void *right)
+{
+	const ScheduledSession *a = left;
+	const ScheduledSession *b = right;
+	if (a->day != b->day)
+	{
+		return a->day < b->day ? -1 : 1;
+	}
+	const int aStart = timeToMinutes(a->start);
+	const int bStart = timeToMinutes(b->start);
+	if (aStart != bStart)
+	{
+		return aStart < bStart ? -1 : 1;
+	}
+	if (a->course != b->course)
+	{
+		return a->course < b->course ? -1 : 1;
+	}
+	return a->professor < b->professor ? -1 : (a->professor == b->professor ? 0 : 1);
+}
+
+/** PUBLIC FUNCTIONS */
+
+Schedule *createSchedule()
+{
+	return calloc(1, sizeof(Schedule));
+}
+
+void destroySchedule(Schedule *schedule)
+{
+	if (schedule != NULL)
+	{
+		free(schedule->sessions);
+		free(schedule);
+	}
+}
+
+void appendScheduledSession(Schedule *schedule, const ScheduledSession session)
+{
+	if (schedule->sessionCount == schedule->sessionCapacity)
+	{
+		schedule->sessionCapacity = schedule->sessionCapacity < 16 ? 16 : 2 * schedule->sessionCapacity;
+		schedule->sessions = realloc(schedule->sessions, schedule->sessionCapacity * sizeof(ScheduledSession));
+	}
+	schedule->sessions[schedule->sessionCount++] = session;
+}
+
+void sortSchedule(Schedule *schedule)
+{
+	qsort(schedule->sessions, schedule->sessionCount, sizeof(ScheduledSession), _compareScheduledSessions);
+}
+
+const char *dayOfWeekToString(const DayOfWeek day)
+{
+	return day < DAY_EVERYDAY ? _days[day] : _days[DAY_EVERYDAY];
+}
+
+int timeToMinutes(const Time time)
+{
+	return 60 * time.hour + time.minute;
+}
+
+boolean parseScheduledSession(const SymbolTable *symbolTable, char *line, ScheduledSession *session, boolean *hasClassroom)
+{
+	char *comment = strstr(line, "//");
+	if (comment != NULL)
+	{
+		*comment = '\0';
+	}
+	char professor[256];
+	char course[256];
+	char day[16];
+	char classroom[256];
+	unsigned int startHour, startMinute, endHour, endMinute;
+	const int count = sscanf(line, " %255s teaches %255s from %u:%u to %u:%u on %15[A-Z] in %255[^; \t\r\n]",
+							 professor, course, &startHour, &startMinute, &endHour, &endMinute, day, classroom);
+	if (count < 7 || 23 < startHour || 59 < startMinute || 24 < endHour || 59 < endMinute)
+	{
+		return false;
+	}
+	session->day = DAY_EVERYDAY;
+	for (unsigned int d = 0; d < DAY_EVERYDAY; ++d)
+	{
+		if (strcmp(day, _days[d]) == 0)
+		{
+			session->day = (DayOfWeek)d;
+		}
+	}
+	session->professor = lookupSymbol(symbolTable, SYMBOL_PROFESSOR, professor);
+	session->course = lookupSymbol(symbolTable, SYMBOL_COURSE, course);
+	session->classroom = count == 8 ? lookupSymbol(symbolTable, SYMBOL_CLASSROOM, classroom) : UNDEFINED_SYMBOL;
+	session->start.hour = (int)startHour;
+	session->start.minute = (int)startMinute;
+	session->end.hour = (int)endHour;
+	session->end.minute = (int)endMinute;
+	*hasClassroom = count == 8;
+	return session->day != DAY_EVERYDAY;
+}
@@ -0,0 +1,83 @@
+#ifndef SCHEDULE_HEADER
+#define SCHEDULE_HEADER
+
+#include "../../shared/SymbolTable.h"
+#include "../../shared/Type.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * A class of a course, placed in the week.
+ */
+typedef struct {
+	SymbolId course;
+	SymbolId professor;
+
+	// UNDEFINED_SYMBOL if the program does not declare classrooms.
+	SymbolId classroom;
+
+	DayOfWeek day;
+	Time start;
+	Time end;
+} ScheduledSession;
+
+/**
+ * The resources whose classes cannot overlap.
+ */
+typedef enum {
+	RESOURCE_PROFESSOR,
+	RESOURCE_CLASSROOM,
+	RESOURCE_COURSE
+} ResourceType;
+
+/**
+ * A complete timetable: every class of every scheduled course.
+ */
+typedef struct {
+	ScheduledSession * sessions;
+	unsigned int sessionCount;
+	unsigned int sessionCapacity;
+} Schedule;
+
+/**
+ * Creates an empty schedule.
+ */
+Schedule * createSchedule();
+
+/**
+ * Destroy a schedule and its resources.
+ */
+void destroySchedule(Schedule * schedule);
+
+/**
+ * Appends a class to the schedule (amortized constant time).
+ */
+void appendScheduledSession(Schedule * schedule, const ScheduledSession session);
+
+/**
+ * Sorts the classes by day and start time (and then, by course).
+ */
+void sortSchedule(Schedule * schedule);
+
+/**
+ * The name of a day, as the programs and the schedules write it (e.g.,
+ * "MONDAY", or "EVERYDAY").
+ */
+const char * dayOfWeekToString(const DayOfWeek day);
+
+/**
+ * The minutes of a time since midnight.
+ */
+int timeToMinutes(const Time time);
+
+/**
+ * Parses a "teaches" line of a schedule (as written by the generator), in
+ * terms of the symbols of a program, where an unknown entity is
+ * UNDEFINED_SYMBOL, and "hasClassroom" tells if the line names a classroom.
+ * Returns false if it's not such a line, or if its day or its time is
+ * malformed.
+ */
+boolean parseScheduledSession(const SymbolTable * symbolTable, char * line, ScheduledSession * session, boolean * hasClassroom);
+
+#endif
@@ -0,0 +1,817 @@
+#include "Solver.h"
+
+/* MODULE INTERNAL STATE */
+
+// The results of a search that are not a depth to jump back to.
+#define SEARCH_FOUND -1
+#define SEARCH_EXHAUSTED -2
+
+static Logger *_logger = NULL;
+static unsigned int _threads = 1;
+
+void initializeSolverModule()
+{
+	_logger = createLogger("Solver");
+	const int threads = getIntegerOrDefault("SOLVER_THREADS", 0);
+	if (threads < 0)
+	{
+		logWarning(_logger, "Invalid amount of threads: %d (using every processor instead).", threads);
+	}
+	_threads = threads <= 0 ? availableProcessors() : (unsigned int)threads;
+}
+
+void shutdownSolverModule()
+{
+	if (_logger != NULL)
+	{
+		destroyLogger(_logger);
+	}
+}
+
+/** PRIVATE FUNCTIONS */
+
+static unsigned int *_toOffsets(unsigned int *first, const unsigned int entityCount);
+static void _indexProfessorSessions(Solver *solver);
+static void _indexClassroomSessions(Solver *solver);
+static unsigned int _lowerBound(const Model *model, const Session *session, const SymbolId professor, const unsigned int day, const unsigned int slot);
+static boolean _prune(Solver *solver, const unsigned int placement, const int culprit);
+static boolean _forwardCheck(Solver *solver, const unsigned int session);
+static unsigned long long _nogoodKey(const unsigned int *placements, const unsigned int size);
+static unsigned int _nogoodSlot(const NogoodStore *store, const unsigned long long key);
+static boolean _hasNogood(const NogoodStore *store, const unsigned long long key);
+static void _addNogood(NogoodStore *store, const unsigned int *placements, const unsigned int size);
+static boolean _violatesNogood(const Solver *solver, const unsigned int placement, BitsetWord *conflict);
+static void _learnNogood(Solver *solver, const BitsetWord *conflict);
+static void _explainDomain(const Solver *solver, const unsigned int session, BitsetWord *conflict);
+static boolean _precedes(const Solver *solver, const unsigned int candidate, const unsigned int selected);
+static unsigned long long _nextRandom(Solver *solver);
+static boolean _isCancelled(const Solver *solver);
+static int _search(Solver *solver);
+
+/**
+ * Converts the counts of a CSR index into offsets, and returns a copy of the
+ * offsets to be used as insertion cursors.
+ */
+static unsigned int *_toOffsets(unsigned int *first, const unsigned int entityCount)
+{
+	for (unsigned int k = 0; k < entityCount; ++k)
+	{
+		first[k + 1] += first[k];
+	}
+	unsigned int *cursor = malloc((entityCount + 1) * sizeof(unsigned int));
+	memcpy(cursor, first, (entityCount + 1) * sizeof(unsigned int));
+	return cursor;
+}
+
+/**
+ * Builds the sessions with a placement of each professor. The placements of
+ * a session are sorted by professor, so every professor is a single run.
+ */
+static void _indexProfessorSessions(Solver *solver)
+{
+	const Model *model = solver->model;
+	solver->professorFirst = calloc(model->professorCount + 1, sizeof(unsigned int));
+	for (unsigned int pass = 0; pass < 2; ++pass)
+	{
+		unsigned int *cursor = pass == 0 ? NULL : _toOffsets(solver->professorFirst, model->professorCount);
+		if (pass == 1)
+		{
+			solver->professorSessions = malloc((1 + solver->professorFirst[model->professorCount]) * sizeof(unsigned int));
+		}
+		for (unsigned int s = 0; s < model->sessionCount; ++s)
+		{
+			const Session *session = &model->sessions[s];
+			for (unsigned int p = session->firstPlacement; p < session->firstPlacement + session->placementCount; ++p)
+			{
+				const SymbolId professor = model->placements[p].professor;
+				if (p != session->firstPlacement && model->placements[p - 1].professor == professor)
+				{
+					continue;
+				}
+				if (pass == 0)
+				{
+					solver->professorFirst[professor + 1] += 1;
+				}
+				else
+				{
+					solver->professorSessions[cursor[professor]++] = s;
+				}
+			}
+		}
+		free(cursor);
+	}
+}
+
+/**
+ * Builds the sessions with a single possible classroom, by classroom.
+ */
+static void _indexClassroomSessions(Solver *solver)
+{
+	const Model *model = solver->model;
+	solver->classroomFirst = calloc(model->classroomCount + 1, sizeof(unsigned int));
+	for (unsigned int pass = 0; pass < 2; ++pass)
+	{
+		unsigned int *cursor = pass == 0 ? NULL : _toOffsets(solver->classroomFirst, model->classroomCount);
+		if (pass == 1)
+		{
+			solver->classroomSessions = malloc((1 + solver->classroomFirst[model->classroomCount]) * sizeof(unsigned int));
+		}
+		for (unsigned int s = 0; s < model->sessionCount; ++s)
+		{
+			const Session *session = &model->sessions[s];
+			if (session->roomCount != 1)
+			{
+				continue;
+			}
+			const SymbolId classroom = model->rooms[session->firstRoom];
+			if (pass == 0)
+			{
+				solver->classroomFirst[classroom + 1] += 1;
+			}
+			else
+			{
+				solver->classroomSessions[cursor[classroom]++] = s;
+			}
+		}
+		free(cursor);
+	}
+}
+
+/**
+ * The first placement of a session that is not lower than (professor, day,
+ * slot), as an index of the model placements.
+ */
+static unsigned int _lowerBound(const Model *model, const Session *session, const SymbolId professor, const unsigned int day, const unsigned int slot)
+{
+	unsigned int low = session->firstPlacement;
+	unsigned int high = session->firstPlacement + session->placementCount;
+	while (low < high)
+	{
+		const unsigned int middle = low + (high - low) / 2;
+		const Placement *placement = &model->placements[middle];
+		boolean lower = placement->slot < slot;
+		if (placement->professor != professor)
+		{
+			lower = placement->professor < professor;
+		}
+		else if (placement->day != day)
+		{
+			lower = placement->day < day;
+		}
+		if (lower)
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+	return low;
+}
+
+/**
+ * Removes a placement from the domain of its session, because of the
+ * assignment of the culprit session (or -1 if unknown). Returns false if the
+ * domain becomes empty (i.e., a wipe-out).
+ */
+static boolean _prune(Solver *solver, const unsigned int placement, const int culprit)
+{
+	if (!solver->alive[placement])
+	{
+		return true;
+	}
+	const unsigned int session = solver->placementSession[placement];
+	solver->alive[placement] = 0;
+	solver->prunedBy[placement] = culprit;
+	solver->unexplainedCount += culprit < 0 ? 1 : 0;
+	solver->trail[solver->trailSize++] = placement;
+	if (--solver->aliveCount[session] == 0)
+	{
+		solver->wipedOut = (int)session;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Prunes the placements of every unassigned session that conflict with the
+ * assignment of a session.
+ */
+static boolean _forwardCheck(Solver *solver, const unsigned int session)
+{
+	const Model *model = solver->model;
+	const Assignment *assignment = &solver->assignments[session];
+	const Placement *placement = &model->placements[assignment->placement];
+	const unsigned int length = model->sessions[session].length;
+	const unsigned int end = placement->slot + length;
+
+	// Same professor, overlapping time.
+	for (unsigned int k = solver->professorFirst[placement->professor]; k < solver->professorFirst[placement->professor + 1]; ++k)
+	{
+		const unsigned int other = solver->professorSessions[k];
+		if (solver->assignments[other].placement != -1)
+		{
+			continue;
+		}
+		const Session *candidate = &model->sessions[other];
+		const unsigned int from = candidate->length <= placement->slot ? placement->slot + 1 - candidate->length : 0;
+		const unsigned int last = candidate->firstPlacement + candidate->placementCount;
+		for (unsigned int p = _lowerBound(model, candidate, placement->professor, placement->day, from); p < last; ++p)
+		{
+			const Placement *conflict = &model->placements[p];
+			if (conflict->professor != placement->professor || conflict->day != placement->day || end <= conflict->slot)
+			{
+				break;
+			}
+			if (!_prune(solver, p, (int)session))
+			{
+				return false;
+			}
+		}
+	}
+
+	// Same course, same day (if it's full), or else overlapping time.
+	const SymbolId course = model->sessions[session].course;
+	const boolean full = model->sessionsPerDay <= solver->courseDayLoad[course * WEEK_DAY_COUNT + placement->day];
+	for (unsigned int other = model->courseFirstSession[course]; (full || 1 < model->sessionsPerDay) && other < model->courseFirstSession[course + 1]; ++other)
+	{
+		if (solver->assignments[other].placement != -1)
+		{
+			continue;
+		}
+		const Session *candidate = &model->sessions[other];
+		for (unsigned int p = candidate->firstPlacement; p < candidate->firstPlacement + candidate->placementCount; ++p)
+		{
+			const Placement *conflict = &model->placements[p];
+			if (conflict->day != placement->day || (!full && (end <= conflict->slot || conflict->slot + candidate->length <= placement->slot)))
+			{
+				continue;
+			}
+			if (!_prune(solver, p, (int)session))
+			{
+				return false;
+			}
+		}
+	}
+
+	// Same (and only) classroom, overlapping time. A session that can move to
+	// other classroom prunes nothing, since the matching can still free it.
+	const SymbolId classroom = model->usesClassrooms ? fixedClassroom(solver->rooms, session) : UNDEFINED_SYMBOL;
+	if (classroom != UNDEFINED_SYMBOL)
+	{
+		for (unsigned int k = solver->classroomFirst[classroom]; k < solver->classroomFirst[classroom + 1]; ++k)
+		{
+			const unsigned int other = solver->classroomSessions[k];
+			if (solver->assignments[other].placement != -1)
+			{
+				continue;
+			}
+			const Session *candidate = &model->sessions[other];
+			for (unsigned int p = candidate->firstPlacement; p < candidate->firstPlacement + candidate->placementCount; ++p)
+			{
+				const Placement *conflict = &model->placements[p];
+				if (conflict->day == placement->day && conflict->slot < end && placement->slot < conflict->slot + candidate->length && !_prune(solver, p, (int)session))
+				{
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * The key of a nogood (see "NogoodStore").
+ */
+static unsigned long long _nogoodKey(const unsigned int *placements, const unsigned int size)
+{
+	unsigned long long low = placements[0] + 1ULL;
+	unsigned long long high = 0;
+	if (size == 2)
+	{
+		high = placements[1] + 1ULL;
+		if (high < low)
+		{
+			const unsigned long long swap = low;
+			low = high;
+			high = swap;
+		}
+	}
+	return (low << 32) | high;
+}
+
+/**
+ * The slot of a key in the hash set (or the empty slot where it goes), with
+ * linear probing.
+ */
+static unsigned int _nogoodSlot(const NogoodStore *store, const unsigned long long key)
+{
+	unsigned int slot = (unsigned int)((key * 0x9E3779B97F4A7C15ULL) >> 32) & (store->capacity - 1);
+	while (store->keys[slot] != 0 && store->keys[slot] != key)
+	{
+		slot = (slot + 1) & (store->capacity - 1);
+	}
+	return slot;
+}
+
+static boolean _hasNogood(const NogoodStore *store, const unsigned long long key)
+{
+	return 0 < store->count && store->keys[_nogoodSlot(store, key)] == key;
+}
+
+/**
+ * Adds a nogood to the store (if it's new), doubling the hash set when it's
+ * half full.
+ */
+static void _addNogood(NogoodStore *store, const unsigned int *placements, const unsigned int size)
+{
+	const unsigned long long key = _nogoodKey(placements, size);
+	if (_hasNogood(store, key))
+	{
+		return;
+	}
+	if (store->capacity < 2 * (store->count + 1))
+	{
+		const unsigned long long *keys = store->keys;
+		const unsigned int capacity = store->capacity;
+		store->capacity = capacity < 64 ? 64 : 2 * capacity;
+		store->keys = calloc(store->capacity, sizeof(unsigned long long));
+		for (unsigned int k = 0; k < capacity; ++k)
+		{
+			if (keys[k] != 0)
+			{
+				store->keys[_nogoodSlot(store, keys[k])] = keys[k];
+			}
+		}
+		free((void *)keys);
+	}
+	store->keys[_nogoodSlot(store, key)] = key;
+	store->count += 1;
+	for (unsigned int k = 0; k < size; ++k)
+	{
+		store->members[placements[k]] = 1;
+	}
+}
+
+/**
+ * Returns true if a placement (of the session to assign) completes a nogood
+ * with the current assignment, and adds the depth of its other session to
+ * the conflict set.
+ */
+static boolean _violatesNogood(const Solver *solver, const unsigned int placement, BitsetWord *conflict)
+{
+	if (!solver->nogoods.members[placement])
+	{
+		return false;
+	}
+	if (_hasNogood(&solver->nogoods, _nogoodKey(&placement, 1)))
+	{
+		return true;
+	}
+	for (unsigned int depth = 0; depth < solver->assignedCount; ++depth)
+	{
+		const unsigned int pair[2] = {(unsigned int)solver->assignments[solver->depthSession[depth]].placement, placement};
+		if (solver->nogoods.members[pair[0]] && _hasNogood(&solver->nogoods, _nogoodKey(pair, 2)))
+		{
+			bitsetSet(conflict, depth);
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Learns the placements of the sessions of a conflict set as a nogood, if
+ * it's small enough and it only depends on the hard constraints.
+ */
+static void _learnNogood(Solver *solver, const BitsetWord *conflict)
+{
+	if (0 < solver->unexplainedCount || MAXIMUM_NOGOOD_SIZE < bitsetPopulation(conflict, solver->conflictWords))
+	{
+		return;
+	}
+	unsigned int placements[MAXIMUM_NOGOOD_SIZE] = {0};
+	unsigned int size = 0;
+	for (unsigned int depth = 0; depth < solver->assignedCount; ++depth)
+	{
+		if (bitsetTest(conflict, depth))
+		{
+			placements[size++] = (unsigned int)solver->assignments[solver->depthSession[depth]].placement;
+		}
+	}
+	_addNogood(&solver->nogoods, placements, size);
+}
+
+/**
+ * Adds the depths of the sessions that pruned the placements of a session to
+ * a conflict set (every assigned session, for a placement removed without a
+ * culprit). With more than one session of a course per day, the pruning of
+ * a day also depends on the other sessions of the course in that day.
+ */
+static void _explainDomain(const Solver *solver, const unsigned int session, BitsetWord *conflict)
+{
+	const Model *model = solver->model;
+	const Session *variable = &model->sessions[session];
+	for (unsigned int p = variable->firstPlacement; p < variable->firstPlacement + variable->placementCount; ++p)
+	{
+		const int culprit = solver->prunedBy[p];
+		if (solver->alive[p])
+		{
+			continue;
+		}
+		if (culprit < 0)
+		{
+			bitsetSetRange(conflict, 0, solver->assignedCount);
+			continue;
+		}
+		bitsetSet(conflict, solver->sessionDepth[culprit]);
+		if (1 < model->sessionsPerDay && model->sessions[culprit].course == variable->course)
+		{
+			for (unsigned int other = model->courseFirstSession[variable->course]; other < model->courseFirstSession[variable->course + 1]; ++other)
+			{
+				const int placement = solver->assignments[other].placement;
+				if (placement != -1 && model->placements[placement].day == model->placements[p].day)
+				{
+					bitsetSet(conflict, solver->sessionDepth[other]);
+				}
+			}
+		}
+	}
+}
+
+/**
+ * Returns true if the candidate session should be assigned before the
+ * selected one, according to the variable ordering.
+ */
+static boolean _precedes(const Solver *solver, const unsigned int candidate, const unsigned int selected)
+{
+	const unsigned int candidateDomain = solver->aliveCount[candidate];
+	const unsigned int selectedDomain = solver->aliveCount[selected];
+	switch (solver->options.variableOrdering)
+	{
+	case VARIABLE_DOMAIN_OVER_DEGREE:
+	{
+		const unsigned long long left = (unsigned long long)candidateDomain * (1 + solver->degrees[selected]);
+		const unsigned long long right = (unsigned long long)selectedDomain * (1 + solver->degrees[candidate]);
+		return left < right;
+	}
+	case VARIABLE_MINIMUM_DOMAIN_RANDOM_TIES:
+		return candidateDomain < selectedDomain
+			|| (candidateDomain == selectedDomain && solver->priorities[candidate] < solver->priorities[selected]);
+	default:
+	{
+		if (candidateDomain != selectedDomain)
+		{
+			return candidateDomain < selectedDomain;
+		}
+		const Session *left = &solver->model->sessions[candidate];
+		const Session *right = &solver->model->sessions[selected];
+		return left->roomCount < right->roomCount || (left->roomCount == right->roomCount && right->length < left->length);
+	}
+	}
+}
+
+/**
+ * A pseudo-random number (xorshift64*), private to each solver so the
+ * searches are reproducible.
+ */
+static unsigned long long _nextRandom(Solver *solver)
+{
+	solver->random ^= solver->random >> 12;
+	solver->random ^= solver->random << 25;
+	solver->random ^= solver->random >> 27;
+	return solver->random * 2685821657736338717ULL;
+}
+
+/**
+ * Returns true if other thread cancels the search, if the time limit expired
+ * (see "_search"), or if the search runs out of nodes.
+ */
+static boolean _isCancelled(const Solver *solver)
+{
+	const boolean exhausted = solver->nodeLimit != 0 && solver->nodeLimit <= solver->nodes;
+	return solver->expired || exhausted || (solver->options.cancelled != NULL && atomicLoad(solver->options.cancelled)) ? true : false;
+}
+
+/**
+ * Searches with forward checking and conflict-directed backjumping. Returns
+ * SEARCH_FOUND if the assignment is complete, SEARCH_EXHAUSTED if there is
+ * no schedule (or the search is cancelled), or else the depth to jump back
+ * to (whose conflict set already includes the conflict).
+ */
+static int _search(Solver *solver)
+{
+	const int session = selectSession(solver);
+	if (session == -1)
+	{
+		return SEARCH_FOUND;
+	}
+	const Model *model = solver->model;
+	const Session *variable = &model->sessions[session];
+	const unsigned int depth = solver->assignedCount;
+	const unsigned int words = solver->conflictWords;
+	BitsetWord *conflict = solver->conflicts + depth * words;
+	bitsetClear(conflict, words);
+	solver->approximate[depth] = 0;
+	solver->nodes += 1;
+	if (solver->nodes % DEADLINE_POLL_NODES == 0 && isDeadlineExpired())
+	{
+		solver->expired = true;
+		return SEARCH_EXHAUSTED;
+	}
+	const unsigned int count = variable->placementCount;
+	const unsigned int rotation = solver->options.valueOrdering == VALUE_RANDOM_ROTATION ? _nextRandom(solver) % count : 0;
+	for (unsigned int k = 0; k < count; ++k)
+	{
+		if (_isCancelled(solver))
+		{
+			return SEARCH_EXHAUSTED;
+		}
+		const unsigned int p = variable->firstPlacement + (solver->options.valueOrdering == VALUE_REVERSE_ORDER ? count - 1 - k : (k + rotation) % count);
+		if (!solver->alive[p] || _violatesNogood(solver, p, conflict))
+		{
+			continue;
+		}
+		const unsigned int trailMark = solver->trailSize;
+		if (assignSession(solver, session, p, UNDEFINED_SYMBOL))
+		{
+			const int result = _search(solver);
+			if (result == SEARCH_FOUND)
+			{
+				return SEARCH_FOUND;
+			}
+			unassignSession(solver, session, trailMark);
+			solver->backtracks += 1;
+			if (result != (int)depth)
+			{
+				return result;
+			}
+			continue;
+		}
+
+		// The value fails because of the sessions that pruned the wiped-out
+		// domain, or else because of every assigned session (whose classrooms
+		// the matching could not rearrange).
+		if (solver->wipedOut < 0)
+		{
+			bitsetSetRange(conflict, 0, depth);
+			solver->approximate[depth] = 1;
+		}
+		else
+		{
+			_explainDomain(solver, (unsigned int)solver->wipedOut, conflict);
+		}
+		unassignSession(solver, session, trailMark);
+		solver->backtracks += 1;
+	}
+
+	// Every value fails: jumps back to the deepest session of the conflict.
+	_explainDomain(solver, (unsigned int)session, conflict);
+	bitsetReset(conflict, depth);
+	const int target = bitsetLast(conflict, words);
+	solver->backjumps += (unsigned int)((int)depth - 1 - target);
+	if (target < 0)
+	{
+		return SEARCH_EXHAUSTED;
+	}
+	if (!solver->approximate[depth])
+	{
+		_learnNogood(solver, conflict);
+	}
+	BitsetWord *targetConflict = solver->conflicts + target * words;
+	bitsetUnion(targetConflict, targetConflict, conflict, words);
+	bitsetReset(targetConflict, (unsigned int)target);
+	solver->approximate[target] |= solver->approximate[depth];
+	return target;
+}
+
+/** PUBLIC FUNCTIONS */
+
+unsigned int solverThreads()
+{
+	return _threads;
+}
+
+boolean assignSession(Solver *solver, const unsigned int session, const unsigned int placement, const SymbolId classroom)
+{
+	const Model *model = solver->model;
+	const Placement *value = &model->placements[placement];
+	const unsigned int length = model->sessions[session].length;
+	const unsigned int weekSlot = placementWeekSlot(model, value);
+	const unsigned int words = model->grid.wordCount;
+	solver->assignments[session].placement = placement;
+	solver->sessionDepth[session] = solver->assignedCount;
+	solver->depthSession[solver->assignedCount] = session;
+	solver->assignedCount += 1;
+	solver->wipedOut = -1;
+	bitsetSetRange(solver->professorBusy + value->professor * words, weekSlot, length);
+	solver->courseDayLoad[model->sessions[session].course * WEEK_DAY_COUNT + value->day] += 1;
+	if (model->usesClassrooms && !matchSession(solver->rooms, session, weekSlot, classroom))
+	{
+		return false;
+	}
+	return _forwardCheck(solver, session);
+}
+
+void unassignSession(Solver *solver, const unsigned int session, const unsigned int trailMark)
+{
+	const Model *model = solver->model;
+	Assignment *assignment = &solver->assignments[session];
+	const Placement *value = &model->placements[assignment->placement];
+	const unsigned int length = model->sessions[session].length;
+	const unsigned int weekSlot = placementWeekSlot(model, value);
+	const unsigned int words = model->grid.wordCount;
+	restorePlacements(solver, trailMark);
+	bitsetResetRange(solver->professorBusy + value->professor * words, weekSlot, length);
+	unmatchSession(solver->rooms, session);
+	solver->courseDayLoad[model->sessions[session].course * WEEK_DAY_COUNT + value->day] -= 1;
+	assignment->placement = -1;
+	solver->assignedCount -= 1;
+}
+
+boolean removePlacement(Solver *solver, const unsigned int placement)
+{
+	return _prune(solver, placement, -1);
+}
+
+void restorePlacements(Solver *solver, const unsigned int trailMark)
+{
+	while (trailMark < solver->trailSize)
+	{
+		const unsigned int placement = solver->trail[--solver->trailSize];
+		solver->unexplainedCount -= solver->prunedBy[placement] < 0 ? 1 : 0;
+		solver->alive[placement] = 1;
+		solver->aliveCount[solver->placementSession[placement]] += 1;
+	}
+}
+
+int selectSession(const Solver *solver)
+{
+	int selected = -1;
+	for (unsigned int s = 0; s < solver->model->sessionCount; ++s)
+	{
+		if (solver->assignments[s].placement == -1 && (selected == -1 || _precedes(solver, s, selected)))
+		{
+			selected = s;
+		}
+	}
+	return selected;
+}
+
+SolverOptions defaultSolverOptions()
+{
+	SolverOptions options;
+	options.variableOrdering = VARIABLE_MINIMUM_DOMAIN;
+	options.valueOrdering = VALUE_IN_ORDER;
+	options.seed = 0;
+	options.cancelled = NULL;
+	return options;
+}
+
+Solver *createSolver(const Model *model, const SolverOptions *options)
+{
+	Solver *solver = calloc(1, sizeof(Solver));
+	const unsigned int words = model->grid.wordCount;
+	solver->model = model;
+	solver->options = *options;
+	solver->random = options->seed ^ 0x9E3779B97F4A7C15ULL;
+	solver->assignments = malloc((1 + model->sessionCount) * sizeof(Assignment));
+	solver->placementSession = malloc((1 + model->placementCount) * sizeof(unsigned int));
+	solver->alive = malloc(1 + model->placementCount);
+	solver->aliveCount = malloc((1 + model->sessionCount) * sizeof(unsigned int));
+	solver->trail = malloc((1 + model->placementCount) * sizeof(unsigned int));
+	solver->prunedBy = malloc((1 + model->placementCount) * sizeof(int));
+	solver->depthSession = malloc((1 + model->sessionCount) * sizeof(unsigned int));
+	solver->sessionDepth = malloc((1 + model->sessionCount) * sizeof(unsigned int));
+	solver->conflictWords = BITSET_WORDS(1 + model->sessionCount);
+	solver->conflicts = createBitset((1 + model->sessionCount) * solver->conflictWords);
+	solver->approximate = calloc(1 + model->sessionCount, sizeof(unsigned char));
+	solver->wipedOut = -1;
+	solver->nogoods.members = calloc(1 + model->placementCount, sizeof(unsigned char));
+	solver->professorBusy = calloc(1 + model->professorCount * words, sizeof(BitsetWord));
+	solver->courseDayLoad = calloc(1 + model->courseCount * WEEK_DAY_COUNT, sizeof(unsigned char));
+	for (unsigned int s = 0; s < model->sessionCount; ++s)
+	{
+		const Session *session = &model->sessions[s];
+		solver->assignments[s].placement = -1;
+		solver->assignments[s].classroom = UNDEFINED_SYMBOL;
+		solver->aliveCount[s] = session->placementCount;
+		for (unsigned int p = session->firstPlacement; p < session->firstPlacement + session->placementCount; ++p)
+		{
+			solver->placementSession[p] = s;
+		}
+	}
+	memset(solver->alive, 1, 1 + model->placementCount);
+	_indexProfessorSessions(solver);
+	_indexClassroomSessions(solver);
+	solver->rooms = createRoomMatching(model, solver->assignments);
+	solver->degrees = calloc(1 + model->sessionCount, sizeof(unsigned int));
+	solver->priorities = malloc((1 + model->sessionCount) * sizeof(unsigned int));
+	for (unsigned int s = 0; s < model->sessionCount; ++s)
+	{
+		const Session *session = &model->sessions[s];
+		for (unsigned int p = session->firstPlacement; p < session->firstPlacement + session->placementCount; ++p)
+		{
+			const SymbolId professor = model->placements[p].professor;
+			if (p == session->firstPlacement || model->placements[p - 1].professor != professor)
+			{
+				solver->degrees[s] += solver->professorFirst[professor + 1] - solver->professorFirst[professor] - 1;
+			}
+		}
+		solver->priorities[s] = (unsigned int)_nextRandom(solver);
+	}
+	return solver;
+}
+
+void destroySolver(Solver *solver)
+{
+	if (solver != NULL)
+	{
+		free(solver->assignments);
+		free(solver->placementSession);
+		free(solver->alive);
+		free(solver->aliveCount);
+		free(solver->trail);
+		free(solver->prunedBy);
+		free(solver->depthSession);
+		free(solver->sessionDepth);
+		destroyBitset(solver->conflicts);
+		free(solver->approximate);
+		free(solver->nogoods.keys);
+		free(solver->nogoods.members);
+		free(solver->professorBusy);
+		destroyRoomMatching(solver->rooms);
+		free(solver->courseDayLoad);
+		free(solver->professorFirst);
+		free(solver->professorSessions);
+		free(solver->classroomFirst);
+		free(solver->classroomSessions);
+		free(solver->degrees);
+		free(solver->priorities);
+		free(solver);
+	}
+}
+
+SolverStatus solve(Solver *solver)
+{
+	logDebugging(_logger, "Searching a schedule for %u session(s)...", solver->model->sessionCount);
+	const SolverStatus status = completeAssignment(solver, 0);
+	logDebugging(_logger, "The search is done after %llu node(s), %llu backtrack(s), %llu skipped level(s) and %u nogood(s).",
+				 solver->nodes, solver->backtracks, solver->backjumps, solver->nogoods.count);
+	return status;
+}
+
+SolverStatus completeAssignment(Solver *solver, const unsigned long long nodeBudget)
+{
+	solver->nodeLimit = nodeBudget == 0 ? 0 : solver->nodes + nodeBudget;
+	const boolean found = _search(solver) == SEARCH_FOUND;
+	const boolean cancelled = _isCancelled(solver);
+	solver->nodeLimit = 0;
+	if (found)
+	{
+		return SOLVER_SATISFIABLE;
+	}
+	if (solver->expired)
+	{
+		return SOLVER_TIMEOUT;
+	}
+	return cancelled ? SOLVER_CANCELLED : SOLVER_UNSATISFIABLE;
+}
+
+void unassignFrom(Solver *solver, const unsigned int depth, const unsigned int trailMark)
+{
+	while (depth < solver->assignedCount)
+	{
+		unassignSession(solver, solver->depthSession[solver->assignedCount - 1], trailMark);
+	}
+}
+
+Schedule *createScheduleFromAssignments(const Model *model, const Assignment *assignments)
+{
+	Schedule *schedule = createSchedule();
+	for (unsigned int s = 0; s < model->sessionCount; ++s)
+	{
+		const Assignment *assignment = &assignments[s];
+		if (assignment->placement == -1)
+		{
+			continue;
+		}
+		const Placement *placement = &model->placements[assignment->placement];
+		ScheduledSession session;
+		session.course = model->sessions[s].course;
+		session.professor = placement->professor;
+		session.classroom = assignment->classroom;
+		session.day = (DayOfWeek)placement->day;
+		session.start = slotToTime(&model->grid, placement->slot);
+		session.end = slotToTime(&model->grid, placement->slot + model->sessions[s].length);
+		appendScheduledSession(schedule, session);
+	}
+	sortSchedule(schedule);
+	return schedule;
+}
+
+Schedule *createScheduleFromSolver(const Solver *solver)
+{
+	return createScheduleFromAssignments(solver->model, solver->assignments);
+}
@@ -0,0 +1,280 @@
+#ifndef SOLVER_HEADER
+#define SOLVER_HEADER
+
+#include "../../shared/Environment.h"
+#include "../../shared/Logger.h"
+#include "../../shared/Thread.h"
+#include "../../shared/Type.h"
+#include "Bitset.h"
+#include "Deadline.h"
+#include "Model.h"
+#include "RoomMatching.h"
+#include "Schedule.h"
+
+/** Initialize module's internal state. */
+void initializeSolverModule();
+
+/** Shutdown module's internal state. */
+void shutdownSolverModule();
+
+/**
+ * The threads that the engines may use (see "SOLVER_THREADS"): every
+ * processor, unless it's specified.
+ */
+unsigned int solverThreads();
+
+typedef enum {
+	SOLVER_SATISFIABLE,
+	SOLVER_UNSATISFIABLE,
+	SOLVER_CANCELLED,
+
+	// The time limit expired before any schedule was found.
+	SOLVER_TIMEOUT
+} SolverStatus;
+
+/**
+ * How to select the next session to assign. Every ordering is fail-first
+ * (i.e., the session with the smallest domain), but they break ties
+ * differently, or weight the domain by the degree of the session.
+ */
+typedef enum {
+	// Ties by fewer classrooms, and then by longer sessions.
+	VARIABLE_MINIMUM_DOMAIN,
+
+	// Ties by a random (but fixed) priority of every session.
+	VARIABLE_MINIMUM_DOMAIN_RANDOM_TIES,
+
+	// The smallest domain over the amount of sessions that share a professor.
+	VARIABLE_DOMAIN_OVER_DEGREE
+} VariableOrdering;
+
+/**
+ * How to traverse the placements of the selected session.
+ */
+typedef enum {
+	// By professor, day and slot (i.e., earliest first).
+	VALUE_IN_ORDER,
+
+	// Latest first.
+	VALUE_REVERSE_ORDER,
+
+	// In order, but from a random placement (and wrapping around).
+	VALUE_RANDOM_ROTATION
+} ValueOrdering;
+
+/**
+ * The strategy of a search. The cancellation flag (if any) can be set by
+ * other thread to stop the search as soon as possible.
+ */
+typedef struct {
+	VariableOrdering variableOrdering;
+	ValueOrdering valueOrdering;
+	unsigned long long seed;
+	Atomic * cancelled;
+} SolverOptions;
+
+/**
+ * The largest nogood that the search learns (a larger one is too expensive to
+ * check against every assignment).
+ */
+#define MAXIMUM_NOGOOD_SIZE 2
+
+/**
+ * The learnt nogoods of a search: sets of placements (of different sessions)
+ * that no schedule has together, as a hash set (with open addressing) of
+ * their keys. The key of a nogood packs its placements (plus one) in
+ * ascending order, with 0 for a missing one, so 0 is the empty entry.
+ */
+typedef struct {
+	unsigned long long * keys;
+	unsigned int count;
+	unsigned int capacity;
+
+	// True if a placement is in some nogood (to skip the lookups).
+	unsigned char * members;
+} NogoodStore;
+
+/**
+ * A depth-first search over the sessions of a model, with fail-first
+ * variable ordering (minimum remaining values) and forward checking.
+ *
+ * Every placement of an unassigned session that conflicts with the current
+ * assignment (same professor and overlapping time, a course with its day
+ * already taken, or a single-classroom session with its classroom taken) is
+ * pruned as soon as the conflict appears, and recorded in a trail, so the
+ * search backtracks as soon as a domain becomes empty, and it restores the
+ * domains in constant time per pruned value.
+ *
+ * The classrooms are not branched: a room matching keeps a classroom for every
+ * assigned session, and a new session may move the others (that are not
+ * pinned) to other classrooms, so a placement only fails if no matching has
+ * room for it.
+ *
+ * The search backjumps (conflict-directed): every pruned placement records
+ * the session that pruned it, and every session of the search path keeps a
+ * conflict set (the shallower sessions that explain why its values failed).
+ * When a session runs out of values, the search jumps back to the deepest
+ * session of its conflict set, skipping the ones that are not involved, and
+ * merges the conflict set into the one of that session. The conflict sets of
+ * at most "MAXIMUM_NOGOOD_SIZE" sessions are learnt as nogoods, so their
+ * placements are never tried together again.
+ */
+typedef struct {
+	const Model * model;
+
+	Assignment * assignments;
+	unsigned int assignedCount;
+
+	// The session of each placement, and if it's still consistent.
+	unsigned int * placementSession;
+	unsigned char * alive;
+	unsigned int * aliveCount;
+
+	// The pruned placements, in order, and the session whose assignment pruned
+	// each one (or -1 if other engine removed it, e.g., with a bound).
+	unsigned int * trail;
+	unsigned int trailSize;
+	int * prunedBy;
+	unsigned int unexplainedCount;
+
+	// The assigned sessions by depth (i.e., in order of assignment), and the
+	// depth of each assigned session.
+	unsigned int * depthSession;
+	unsigned int * sessionDepth;
+
+	// The conflict set of each depth, as a bitset of depths: [conflicts +
+	// depth * conflictWords], and if it comes from a failure of the room
+	// matching (whose search is bounded, so it's never learnt). The session
+	// of a wiped-out domain, during an assignment (or -1 if the room matching
+	// failed).
+	BitsetWord * conflicts;
+	unsigned int conflictWords;
+	unsigned char * approximate;
+	int wipedOut;
+
+	NogoodStore nogoods;
+
+	// The occupied slots of each professor (bitset rows), and the classrooms
+	// of the assigned sessions.
+	BitsetWord * professorBusy;
+	RoomMatching * rooms;
+
+	// The amount of sessions of each course in each day.
+	unsigned char * courseDayLoad;
+
+	// The sessions with a placement of each professor: [professorFirst[p],
+	// professorFirst[p + 1]).
+	unsigned int * professorFirst;
+	unsigned int * professorSessions;
+
+	// The sessions with a single possible classroom, by classroom.
+	unsigned int * classroomFirst;
+	unsigned int * classroomSessions;
+
+	// The degree and the random priority of each session (for ties).
+	unsigned int * degrees;
+	unsigned int * priorities;
+
+	SolverOptions options;
+	unsigned long long random;
+
+	unsigned long long nodes;
+	unsigned long long backtracks;
+	unsigned long long backjumps;
+
+	// The nodes after which the search gives up (or 0, without limit), and
+	// true if the time limit expired during the search.
+	unsigned long long nodeLimit;
+	boolean expired;
+} Solver;
+
+/**
+ * The default strategy: minimum domain, and values in order (deterministic).
+ */
+SolverOptions defaultSolverOptions();
+
+/**
+ * Creates a solver for a model. The model must outlive the solver, but it's
+ * never modified, so many solvers can share it (even in different threads).
+ */
+Solver * createSolver(const Model * model, const SolverOptions * options);
+
+/**
+ * Destroy a solver and its resources.
+ */
+void destroySolver(Solver * solver);
+
+/**
+ * Searches a complete assignment that satisfies every hard constraint. The
+ * search of placements is complete, but the classrooms are matched with a
+ * bounded search (see "MAXIMUM_ROOM_VISITS"), so SOLVER_UNSATISFIABLE only
+ * proves that there is no such assignment if the program has no classrooms
+ * (and it's not cancelled); otherwise, none was found. It stops with
+ * SOLVER_TIMEOUT if the time limit expires first.
+ */
+SolverStatus solve(Solver * solver);
+
+/**
+ * Builds the schedule of the current (complete) assignment of a solver.
+ */
+Schedule * createScheduleFromSolver(const Solver * solver);
+
+/**
+ * Builds the schedule of an assignment of every session of a model (e.g., a
+ * copy of the best assignment found by an optimizer).
+ */
+Schedule * createScheduleFromAssignments(const Model * model, const Assignment * assignments);
+
+/**
+ * The primitives of the search, for engines that drive a solver by their own
+ * (e.g., an optimizer). A session must be unassigned with the trail-size
+ * that the solver had before its assignment.
+ */
+
+/**
+ * Assigns a placement to a session, and propagates it. The classroom is
+ * chosen by the room matching, unless it's pinned to the specified one (if
+ * it's not UNDEFINED_SYMBOL). Returns false if there is no classroom for it,
+ * or if any domain is wiped-out (the caller must undo the assignment
+ * anyway).
+ */
+boolean assignSession(Solver * solver, const unsigned int session, const unsigned int placement, const SymbolId classroom);
+
+/**
+ * Undoes the assignment of a session, and every pruning since the mark.
+ */
+void unassignSession(Solver * solver, const unsigned int session, const unsigned int trailMark);
+
+/**
+ * Removes a placement from the domain of its session (if it's still there),
+ * without a session that explains it. Returns false if the domain becomes
+ * empty.
+ */
+boolean removePlacement(Solver * solver, const unsigned int placement);
+
+/**
+ * Restores every placement removed since the mark.
+ */
+void restorePlacements(Solver * solver, const unsigned int trailMark);
+
+/**
+ * Completes the current (partial) assignment with the search of "solve",
+ * giving up with SOLVER_CANCELLED after a budget of nodes (or 0, without
+ * limit). If it's not SOLVER_SATISFIABLE, the assignment is the same as
+ * before; otherwise, the new sessions must be undone with "unassignFrom".
+ */
+SolverStatus completeAssignment(Solver * solver, const unsigned long long nodeBudget);
+
+/**
+ * Undoes the assignments from a depth (in reverse order), and every pruning
+ * since the mark (i.e., the trail-size before the first of them).
+ */
+void unassignFrom(Solver * solver, const unsigned int depth, const unsigned int trailMark);
+
+/**
+ * Fail-first: the unassigned session with the smallest domain (see
+ * "VariableOrdering"). Returns -1 if every session is assigned.
+ */
+int selectSession(const Solver * solver);
+
+#endif
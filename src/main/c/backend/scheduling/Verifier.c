@@ -0,0 +1,583 @@
+#include "Verifier.h"
+
+/* MODULE INTERNAL STATE */
+
+static Logger *_logger = NULL;
+static const char *_path = NULL;
+
+void initializeVerifierModule()
+{
+	_logger = createLogger("Verifier");
+	_path = getStringOrDefault("VERIFY_SCHEDULE", NULL);
+	if (_path != NULL && _path[0] == '\0')
+	{
+		_path = NULL;
+	}
+}
+
+void shutdownVerifierModule()
+{
+	if (_logger != NULL)
+	{
+		destroyLogger(_logger);
+	}
+}
+
+/** PRIVATE FUNCTIONS */
+
+/**
+ * The state of a verification. Only the valid classes (i.e., with declared
+ * professor and course, and a time inside of the opening hours) are
+ * bucketed, and the buckets of a single resource type are kept at once:
+ * [first[r], first[r + 1]) of "items", for each resource r.
+ */
+typedef struct
+{
+	const Program *program;
+	const Schedule *schedule;
+	int openMinute;
+	unsigned int span;
+	unsigned int granularity;
+	boolean usesClassrooms;
+
+	boolean *valid;
+	unsigned int *first;
+	unsigned int *items;
+
+	// A row of bits per day (of "span" minutes): the busy minutes of the
+	// current resource, and the available ones of the current professor.
+	BitsetWord *busy;
+	BitsetWord *available;
+
+	unsigned int violationCount;
+} Verifier;
+
+static unsigned int _offset(const Verifier *verifier, const ScheduledSession *session);
+static unsigned int _length(const ScheduledSession *session);
+static void _describe(const Program *program, const ScheduledSession *session, char *buffer, const size_t size);
+static SymbolId _resourceOf(const ScheduledSession *session, const ResourceType type);
+static void _checkSession(Verifier *verifier, const unsigned int k);
+static void _bucket(Verifier *verifier, const ResourceType type, const unsigned int resourceCount);
+static void _markAvailability(Verifier *verifier, const Professor *professor, const boolean mark);
+static void _checkProfessors(Verifier *verifier);
+static void _checkClassrooms(Verifier *verifier);
+static boolean _satisfies(const ScheduledSession *session, const PreferenceDetails *details, const Program *program);
+static boolean _augment(Verifier *verifier, const unsigned int *preferences, const unsigned int preference, const unsigned int course, int *matches, unsigned int *visited, const unsigned int stamp);
+static void _checkPreferences(Verifier *verifier, const SymbolId course, int *matches, unsigned int *visited, unsigned int *stamp);
+static void _checkCourses(Verifier *verifier);
+static Schedule *_readSchedule(const SymbolTable *symbolTable);
+
+/**
+ * The first bit of a (valid) class in a row of the week.
+ */
+static unsigned int _offset(const Verifier *verifier, const ScheduledSession *session)
+{
+	return session->day * verifier->span + (unsigned int)(timeToMinutes(session->start) - verifier->openMinute);
+}
+
+static unsigned int _length(const ScheduledSession *session)
+{
+	return (unsigned int)(timeToMinutes(session->end) - timeToMinutes(session->start));
+}
+
+/**
+ * Writes a class as "Ana teaches ATLyC from 16:00 to 19:00 on WEDNESDAY in
+ * Aula1" (its entities must be symbols of the program).
+ */
+static void _describe(const Program *program, const ScheduledSession *session, char *buffer, const size_t size)
+{
+	const int written = snprintf(buffer, size, "\"%s\" teaches \"%s\" from %02d:%02d to %02d:%02d on %s",
+								 program->professors[session->professor].id, program->courses[session->course].id,
+								 session->start.hour, session->start.minute, session->end.hour, session->end.minute,
+								 session->day < WEEK_DAY_COUNT ? dayOfWeekToString(session->day) : "an unknown day");
+	if (session->classroom != UNDEFINED_SYMBOL && 0 <= written && (size_t)written < size)
+	{
+		snprintf(buffer + written, size - (size_t)written, " in \"%s\"", program->classrooms[session->classroom].id);
+	}
+}
+
+static SymbolId _resourceOf(const ScheduledSession *session, const ResourceType type)
+{
+	switch (type)
+	{
+		case RESOURCE_PROFESSOR:
+			return session->professor;
+		case RESOURCE_CLASSROOM:
+			return session->classroom;
+		default:
+			return session->course;
+	}
+}
+
+/**
+ * Checks the constraints of a class on its own: its entities, its time, and
+ * its classroom. The class is valid (i.e., it's bucketed) if its professor,
+ * course and time are.
+ */
+static void _checkSession(Verifier *verifier, const unsigned int k)
+{
+	const Program *program = verifier->program;
+	const Configuration *configuration = &program->configuration;
+	const ScheduledSession *session = &verifier->schedule->sessions[k];
+	verifier->valid[k] = false;
+	if (session->professor == UNDEFINED_SYMBOL || (SymbolId)program->professorCount <= session->professor || !program->professors[session->professor].declared
+		|| session->course == UNDEFINED_SYMBOL || (SymbolId)program->courseCount <= session->course || !program->courses[session->course].declared
+		|| (session->classroom != UNDEFINED_SYMBOL && ((SymbolId)program->classroomCount <= session->classroom || !program->classrooms[session->classroom].declared)))
+	{
+		logError(_logger, "The class %u of the schedule has an undeclared professor, course or classroom.", k + 1);
+		verifier->violationCount += 1;
+		return;
+	}
+	char description[512];
+	const int start = timeToMinutes(session->start);
+	const int end = timeToMinutes(session->end);
+	if (WEEK_DAY_COUNT <= session->day || start < verifier->openMinute || verifier->openMinute + (int)verifier->span < end || end <= start)
+	{
+		_describe(program, session, description, sizeof(description));
+		logError(_logger, "The class %s is outside of the opening hours.", description);
+		verifier->violationCount += 1;
+		return;
+	}
+	verifier->valid[k] = true;
+	if (configuration->hasClassDuration && (end - start < 60 * configuration->classDuration.minHours || 60 * configuration->classDuration.maxHours < end - start))
+	{
+		_describe(program, session, description, sizeof(description));
+		logError(_logger, "The class %s lasts %d minute(s), outside of the class duration.", description, end - start);
+		verifier->violationCount += 1;
+	}
+	if (session->classroom == UNDEFINED_SYMBOL)
+	{
+		if (verifier->usesClassrooms)
+		{
+			_describe(program, session, description, sizeof(description));
+		logError(_logger, "The class %s has no classroom.", description);
+			verifier->violationCount += 1;
+		}
+		return;
+	}
+	const Course *course = &program->courses[session->course];
+	const Classroom *classroom = &program->classrooms[session->classroom];
+	if (classroom->capacity < program->index.courseStudents[session->course])
+	{
+		_describe(program, session, description, sizeof(description));
+		logError(_logger, "The class %s has %d student(s), but its classroom has only %d seat(s).", description,
+				 program->index.courseStudents[session->course], classroom->capacity);
+		verifier->violationCount += 1;
+	}
+	if (!featureMaskCovers(&classroom->features, &course->requires))
+	{
+		_describe(program, session, description, sizeof(description));
+		logError(_logger, "The class %s is in a classroom without every required feature.", description);
+		verifier->violationCount += 1;
+	}
+}
+
+/**
+ * Buckets the valid classes by a resource, in order (a counting sort).
+ */
+static void _bucket(Verifier *verifier, const ResourceType type, const unsigned int resourceCount)
+{
+	const Schedule *schedule = verifier->schedule;
+	memset(verifier->first, 0, (resourceCount + 2) * sizeof(unsigned int));
+	for (unsigned int k = 0; k < schedule->sessionCount; ++k)
+	{
+		const SymbolId resource = _resourceOf(&schedule->sessions[k], type);
+		if (verifier->valid[k] && resource != UNDEFINED_SYMBOL)
+		{
+			verifier->first[resource + 2] += 1;
+		}
+	}
+	for (unsigned int r = 0; r < resourceCount; ++r)
+	{
+		verifier->first[r + 2] += verifier->first[r + 1];
+	}
+	for (unsigned int k = 0; k < schedule->sessionCount; ++k)
+	{
+		const SymbolId resource = _resourceOf(&schedule->sessions[k], type);
+		if (verifier->valid[k] && resource != UNDEFINED_SYMBOL)
+		{
+			verifier->items[verifier->first[resource + 1]++] = k;
+		}
+	}
+}
+
+/**
+ * Marks (or clears) the available windows of a professor, inside of the
+ * opening hours.
+ */
+static void _markAvailability(Verifier *verifier, const Professor *professor, const boolean mark)
+{
+	for (unsigned int a = 0; a < professor->availabilityCount; ++a)
+	{
+		const IntervalDayOfWeek *window = &professor->availability[a];
+		const int close = verifier->openMinute + (int)verifier->span;
+		const int start = timeToMinutes(window->start) < verifier->openMinute ? verifier->openMinute : timeToMinutes(window->start);
+		const int end = close < timeToMinutes(window->end) ? close : timeToMinutes(window->end);
+		for (unsigned int day = 0; start < end && day < WEEK_DAY_COUNT; ++day)
+		{
+			if (window->dayOfWeek != DAY_EVERYDAY && window->dayOfWeek != (DayOfWeek)day)
+			{
+				continue;
+			}
+			const unsigned int from = day * verifier->span + (unsigned int)(start - verifier->openMinute);
+			if (mark)
+			{
+				bitsetSetRange(verifier->available, from, (unsigned int)(end - start));
+			}
+			else
+			{
+				bitsetResetRange(verifier->available, from, (unsigned int)(end - start));
+			}
+		}
+	}
+}
+
+/**
+ * Checks the qualification, the availability and the overlaps of the classes
+ * of each professor. The courses of the professor are stamped on a table, so
+ * the qualification of a class takes constant time.
+ */
+static void _checkProfessors(Verifier *verifier)
+{
+	const Program *program = verifier->program;
+	const Schedule *schedule = verifier->schedule;
+	char description[512];
+	unsigned int *teaches = calloc(1 + program->courseCount, sizeof(unsigned int));
+	_bucket(verifier, RESOURCE_PROFESSOR, program->professorCount);
+	for (unsigned int p = 0; p < program->professorCount; ++p)
+	{
+		const Professor *professor = &program->professors[p];
+		if (verifier->first[p] == verifier->first[p + 1])
+		{
+			continue;
+		}
+		for (unsigned int k = 0; k < professor->courseCount; ++k)
+		{
+			teaches[professor->courses[k]] = p + 1;
+		}
+		_markAvailability(verifier, professor, true);
+		for (unsigned int j = verifier->first[p]; j < verifier->first[p + 1]; ++j)
+		{
+			const ScheduledSession *session = &schedule->sessions[verifier->items[j]];
+			const unsigned int offset = _offset(verifier, session);
+			const unsigned int length = _length(session);
+			if (teaches[session->course] != p + 1)
+			{
+				_describe(program, session, description, sizeof(description));
+				logError(_logger, "The class %s has a professor that cannot teach its course.", description);
+				verifier->violationCount += 1;
+			}
+			if (professor->availabilityCount != 0 && !bitsetAllInRange(verifier->available, offset, length))
+			{
+				_describe(program, session, description, sizeof(description));
+				logError(_logger, "The class %s is outside of the availability of its professor.", description);
+				verifier->violationCount += 1;
+			}
+			if (bitsetAnyInRange(verifier->busy, offset, length))
+			{
+				_describe(program, session, description, sizeof(description));
+				logError(_logger, "The class %s overlaps other class of its professor.", description);
+				verifier->violationCount += 1;
+			}
+			bitsetSetRange(verifier->busy, offset, length);
+		}
+		_markAvailability(verifier, professor, false);
+		for (unsigned int j = verifier->first[p]; j < verifier->first[p + 1]; ++j)
+		{
+			const ScheduledSession *session = &schedule->sessions[verifier->items[j]];
+			bitsetResetRange(verifier->busy, _offset(verifier, session), _length(session));
+		}
+	}
+	free(teaches);
+}
+
+static void _checkClassrooms(Verifier *verifier)
+{
+	const Program *program = verifier->program;
+	const Schedule *schedule = verifier->schedule;
+	char description[512];
+	_bucket(verifier, RESOURCE_CLASSROOM, program->classroomCount);
+	for (unsigned int r = 0; r < program->classroomCount; ++r)
+	{
+		for (unsigned int j = verifier->first[r]; j < verifier->first[r + 1]; ++j)
+		{
+			const ScheduledSession *session = &schedule->sessions[verifier->items[j]];
+			if (bitsetAnyInRange(verifier->busy, _offset(verifier, session), _length(session)))
+			{
+				_describe(program, session, description, sizeof(description));
+				logError(_logger, "The class %s overlaps other class of its classroom.", description);
+				verifier->violationCount += 1;
+			}
+			bitsetSetRange(verifier->busy, _offset(verifier, session), _length(session));
+		}
+		for (unsigned int j = verifier->first[r]; j < verifier->first[r + 1]; ++j)
+		{
+			const ScheduledSession *session = &schedule->sessions[verifier->items[j]];
+			bitsetResetRange(verifier->busy, _offset(verifier, session), _length(session));
+		}
+	}
+}
+
+/**
+ * Returns true if a class of the course of a hard preference satisfies it:
+ * the same professor, and its day, time and classroom (if it has them).
+ */
+static boolean _satisfies(const ScheduledSession *session, const PreferenceDetails *details, const Program *program)
+{
+	if (session->professor != details->professor)
+	{
+		return false;
+	}
+	if (details->hasDay && details->day != DAY_EVERYDAY && session->day != details->day)
+	{
+		return false;
+	}
+	if (details->hasTime && (timeToMinutes(session->start) != timeToMinutes(details->startTime) || timeToMinutes(session->end) != timeToMinutes(details->endTime)))
+	{
+		return false;
+	}
+	return details->classroom == UNDEFINED_SYMBOL || !program->classrooms[details->classroom].declared || session->classroom == details->classroom;
+}
+
+/**
+ * Looks for an augmenting path from a hard preference (as an index of the
+ * preferences of the course bucket) to the classes of its course, where
+ * "matches" holds the preference of each class (or -1).
+ */
+static boolean _augment(Verifier *verifier, const unsigned int *preferences, const unsigned int preference, const unsigned int course, int *matches, unsigned int *visited, const unsigned int stamp)
+{
+	const Program *program = verifier->program;
+	const PreferenceDetails *details = &program->preferences[preferences[preference]].details;
+	for (unsigned int j = verifier->first[course]; j < verifier->first[course + 1]; ++j)
+	{
+		const unsigned int k = verifier->items[j];
+		if (visited[k] == stamp || !_satisfies(&verifier->schedule->sessions[k], details, program))
+		{
+			continue;
+		}
+		visited[k] = stamp;
+		if (matches[k] == -1 || _augment(verifier, preferences, (unsigned int)matches[k], course, matches, visited, stamp))
+		{
+			matches[k] = (int)preference;
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Every hard preference of a course requires a class of its own, so they are
+ * matched to the classes of the course (with augmenting paths, since a class
+ * can satisfy more than one preference).
+ */
+static void _checkPreferences(Verifier *verifier, const SymbolId course, int *matches, unsigned int *visited, unsigned int *stamp)
+{
+	const Program *program = verifier->program;
+	const EntityBuckets *buckets = &program->index.coursePreferences;
+	const unsigned int *preferences = buckets->items + buckets->first[course];
+	const unsigned int preferenceCount = buckets->first[course + 1] - buckets->first[course];
+	for (unsigned int k = 0; k < preferenceCount; ++k)
+	{
+		const Preference *preference = &program->preferences[preferences[k]];
+		const PreferenceDetails *details = &preference->details;
+		if (preference->type != HARD_PREFERENCE || details->professor == UNDEFINED_SYMBOL || !program->professors[details->professor].declared)
+		{
+			continue;
+		}
+		*stamp += 1;
+		if (!_augment(verifier, preferences, k, course, matches, visited, *stamp))
+		{
+			logError(_logger, "The hard preference of \"%s\" to teach \"%s\" has no class that satisfies it.",
+					 program->professors[details->professor].id, program->courses[course].id);
+			verifier->violationCount += 1;
+		}
+	}
+}
+
+/**
+ * Checks the overlaps, the classes per day, the hours and the hard
+ * preferences of each course. A course needs its hours only if it has a
+ * qualified professor (otherwise, it's not scheduled), and at most its hours
+ * rounded up to the granularity of the time-grid.
+ */
+static void _checkCourses(Verifier *verifier)
+{
+	const Program *program = verifier->program;
+	const Schedule *schedule = verifier->schedule;
+	char description[512];
+	boolean *qualified = calloc(1 + program->courseCount, sizeof(boolean));
+	for (unsigned int p = 0; p < program->professorCount; ++p)
+	{
+		const Professor *professor = &program->professors[p];
+		for (unsigned int k = 0; professor->declared && k < professor->courseCount; ++k)
+		{
+			qualified[professor->courses[k]] = true;
+		}
+	}
+	int *matches = malloc((1 + schedule->sessionCount) * sizeof(int));
+	unsigned int *visited = calloc(1 + schedule->sessionCount, sizeof(unsigned int));
+	unsigned int stamp = 0;
+	for (unsigned int k = 0; k < schedule->sessionCount; ++k)
+	{
+		matches[k] = -1;
+	}
+	_bucket(verifier, RESOURCE_COURSE, program->courseCount);
+	for (SymbolId c = 0; c < (SymbolId)program->courseCount; ++c)
+	{
+		const Course *course = &program->courses[c];
+		unsigned int daily[WEEK_DAY_COUNT] = {0};
+		int minutes = 0;
+		for (unsigned int j = verifier->first[c]; j < verifier->first[c + 1]; ++j)
+		{
+			const ScheduledSession *session = &schedule->sessions[verifier->items[j]];
+			if (bitsetAnyInRange(verifier->busy, _offset(verifier, session), _length(session)))
+			{
+				_describe(program, session, description, sizeof(description));
+				logError(_logger, "The class %s overlaps other class of its course.", description);
+				verifier->violationCount += 1;
+			}
+			bitsetSetRange(verifier->busy, _offset(verifier, session), _length(session));
+			daily[session->day] += 1;
+			if (daily[session->day] == classesPerDay() + 1)
+			{
+				logError(_logger, "The course \"%s\" has more than %u class(es) on %s.", course->id, classesPerDay(), dayOfWeekToString(session->day));
+				verifier->violationCount += 1;
+			}
+			minutes += (int)_length(session);
+		}
+		for (unsigned int j = verifier->first[c]; j < verifier->first[c + 1]; ++j)
+		{
+			const ScheduledSession *session = &schedule->sessions[verifier->items[j]];
+			bitsetResetRange(verifier->busy, _offset(verifier, session), _length(session));
+		}
+		if (!course->declared || course->hours <= 0 || !qualified[c])
+		{
+			continue;
+		}
+		const int granularity = (int)verifier->granularity;
+		if (minutes < 60 * course->hours || (60 * course->hours + granularity - 1) / granularity * granularity < minutes)
+		{
+			logError(_logger, "The course \"%s\" has %d minute(s) of classes, but it requires %d hour(s).", course->id, minutes, course->hours);
+			verifier->violationCount += 1;
+		}
+		_checkPreferences(verifier, c, matches, visited, &stamp);
+	}
+	free(matches);
+	free(visited);
+	free(qualified);
+}
+
+/**
+ * Reads every "teaches" line of the schedule to verify. Returns NULL (after
+ * logging the reason) if the file cannot be read, or if a line cannot be
+ * parsed.
+ */
+static Schedule *_readSchedule(const SymbolTable *symbolTable)
+{
+	FILE *file = fopen(_path, "r");
+	if (file == NULL)
+	{
+		logError(_logger, "Cannot read the schedule \"%s\".", _path);
+		return NULL;
+	}
+	Schedule *schedule = createSchedule();
+	boolean succeed = true;
+	char *line = NULL;
+	size_t size = 0;
+	unsigned int lineNumber = 0;
+	while (getline(&line, &size, file) != -1)
+	{
+		++lineNumber;
+		if (strstr(line, " teaches ") == NULL)
+		{
+			continue;
+		}
+		ScheduledSession session;
+		boolean hasClassroom = false;
+		if (!parseScheduledSession(symbolTable, line, &session, &hasClassroom) || session.professor == UNDEFINED_SYMBOL
+			|| session.course == UNDEFINED_SYMBOL || (hasClassroom && session.classroom == UNDEFINED_SYMBOL))
+		{
+			logError(_logger, "The line %u of \"%s\" is not a class of the program.", lineNumber, _path);
+			succeed = false;
+			continue;
+		}
+		appendScheduledSession(schedule, session);
+	}
+	free(line);
+	fclose(file);
+	if (!succeed)
+	{
+		destroySchedule(schedule);
+		return NULL;
+	}
+	return schedule;
+}
+
+/** PUBLIC FUNCTIONS */
+
+boolean hasScheduleToVerify()
+{
+	return _path != NULL;
+}
+
+VerificationStatus verifySchedule(const Program *program, const Schedule *schedule)
+{
+	logDebugging(_logger, "Verifying a schedule of %u class(es)...", schedule->sessionCount);
+	const UniversityOpen *open = &program->configuration.universityOpen;
+	const unsigned int resourceCount = program->professorCount + program->classroomCount + program->courseCount;
+	Verifier verifier = {
+		.program = program,
+		.schedule = schedule,
+		.openMinute = timeToMinutes(open->openFrom),
+		.span = timeToMinutes(open->openFrom) < timeToMinutes(open->openTo) ? (unsigned int)(timeToMinutes(open->openTo) - timeToMinutes(open->openFrom)) : 0,
+		.granularity = createTimeGrid(&program->configuration).granularity,
+		.usesClassrooms = false,
+		.valid = calloc(1 + schedule->sessionCount, sizeof(boolean)),
+		.first = calloc(resourceCount + 2, sizeof(unsigned int)),
+		.items = calloc(1 + schedule->sessionCount, sizeof(unsigned int)),
+		.busy = NULL,
+		.available = NULL,
+		.violationCount = 0};
+	verifier.busy = createBitset(1 + BITSET_WORDS(WEEK_DAY_COUNT * verifier.span));
+	verifier.available = createBitset(1 + BITSET_WORDS(WEEK_DAY_COUNT * verifier.span));
+	for (unsigned int r = 0; r < program->classroomCount; ++r)
+	{
+		verifier.usesClassrooms = verifier.usesClassrooms || program->classrooms[r].declared;
+	}
+	for (unsigned int k = 0; k < schedule->sessionCount; ++k)
+	{
+		_checkSession(&verifier, k);
+	}
+	_checkProfessors(&verifier);
+	_checkClassrooms(&verifier);
+	_checkCourses(&verifier);
+	free(verifier.valid);
+	free(verifier.first);
+	free(verifier.items);
+	destroyBitset(verifier.busy);
+	destroyBitset(verifier.available);
+	if (verifier.violationCount != 0)
+	{
+		logError(_logger, "The schedule violates %u hard constraint(s).", verifier.violationCount);
+		return VERIFICATION_REJECT;
+	}
+	logDebugging(_logger, "The schedule satisfies every hard constraint.");
+	return VERIFICATION_ACCEPT;
+}
+
+VerificationStatus verifyScheduleFile(CompilerState *compilerState)
+{
+	const Program *program = compilerState->abstractSyntaxtTree;
+	Schedule *schedule = _readSchedule(compilerState->symbolTable);
+	if (schedule == NULL)
+	{
+		return VERIFICATION_REJECT;
+	}
+	const VerificationStatus status = verifySchedule(program, schedule);
+	if (status == VERIFICATION_ACCEPT)
+	{
+		logInformation(_logger, "The schedule \"%s\" of %u class(es) satisfies every hard constraint.", _path, schedule->sessionCount);
+	}
+	destroySchedule(schedule);
+	return status;
+}
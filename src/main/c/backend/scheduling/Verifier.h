@@ -0,0 +1,69 @@
+#ifndef VERIFIER_HEADER
+#define VERIFIER_HEADER
+
+#include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
+#include "../../shared/CompilerState.h"
+#include "../../shared/Environment.h"
+#include "../../shared/Logger.h"
+#include "../../shared/SymbolTable.h"
+#include "../../shared/Type.h"
+#include "Availability.h"
+#include "Bitset.h"
+#include "Partition.h"
+#include "Schedule.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Initialize module's internal state. */
+void initializeVerifierModule();
+
+/** Shutdown module's internal state. */
+void shutdownVerifierModule();
+
+typedef enum {
+	VERIFICATION_ACCEPT,
+	VERIFICATION_REJECT
+} VerificationStatus;
+
+/**
+ * Returns true if there is a schedule to verify instead of scheduling the
+ * program (see "VERIFY_SCHEDULE").
+ */
+boolean hasScheduleToVerify();
+
+/**
+ * Checks every hard constraint of a program on a schedule, directly on the
+ * program (i.e., without its scheduling model, so it also catches the
+ * mistakes of the model and the solvers):
+ *
+ * - Every class has a declared professor, course and day, inside of the
+ *   opening hours, and within the class duration (if any).
+ * - The professor can teach the course, and it's inside of an available
+ *   window of the professor (if it declares any).
+ * - The classroom is declared (and required, if the program declares any),
+ *   with the seats for the students of the course and every required
+ *   feature.
+ * - A professor, a classroom or a course never has two overlapping classes,
+ *   and a course has at most "classesPerDay" classes per day.
+ * - Every course with hours and a qualified professor has its hours (at
+ *   least, and at most rounded up to the granularity of the time-grid), and
+ *   every hard preference of it has a class of its own.
+ *
+ * The classes are bucketed by professor, classroom and course (with a
+ * counting sort), and each bucket is checked against a single row of bits
+ * of the week (in minutes of the opening hours), which is cleared after it,
+ * so it runs in O(n + m) for n classes and a program of size m. Returns
+ * VERIFICATION_REJECT after logging every violation.
+ */
+VerificationStatus verifySchedule(const Program * program, const Schedule * schedule);
+
+/**
+ * Reads the schedule to verify (an output of the compiler, i.e., its
+ * "teaches" lines), in terms of the program of the compiler state, and
+ * verifies it. An unreadable file, or a line that cannot be parsed or that
+ * references an unknown entity, also rejects it.
+ */
+VerificationStatus verifyScheduleFile(CompilerState * compilerState);
+
+#endif
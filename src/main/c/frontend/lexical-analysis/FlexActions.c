@@ -24,10 +24,15 @@ void shutdownFlexActionsModule()
 static void _logLexicalAnalyzerContext(const char *functionName, LexicalAnalyzerContext *lexicalAnalyzerContext);
 
 /**
- * Logs a lexical-analyzer context in DEBUGGING level.
+ * Logs a lexical-analyzer context in DEBUGGING level. The lexeme is only
+ * escaped (which requires heap-memory) if the log will be visible.
  */
 static void _logLexicalAnalyzerContext(const char *functionName, LexicalAnalyzerContext *lexicalAnalyzerContext)
 {
+	if (!isLoggingLevelEnabled(_logger, DEBUGGING))
+	{
+		return;
+	}
 	char *escapedLexeme = escape(lexicalAnalyzerContext->lexeme);
 	logDebugging(_logger, "%s: %s (context = %d, length = %d, line = %d)",
 				 functionName,
@@ -87,14 +92,14 @@ Token KeywordLexemeAction(LexicalAnalyzerContext *lexicalAnalyzerContext, Token
 Token IdentifierLexemeAction(LexicalAnalyzerContext *lexicalAnalyzerContext)
 {
 	_logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
-	lexicalAnalyzerContext->semanticValue->string = lexicalAnalyzerContext->lexeme;
+	lexicalAnalyzerContext->semanticValue->string = arenaDuplicateString(currentCompilerState()->arena, lexicalAnalyzerContext->lexeme);
 	return IDENTIFIER;
 }
 
 Token StringLexemeAction(LexicalAnalyzerContext *lexicalAnalyzerContext)
 {
 	_logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
-	lexicalAnalyzerContext->semanticValue->string = lexicalAnalyzerContext->lexeme;
+	lexicalAnalyzerContext->semanticValue->string = arenaDuplicateString(currentCompilerState()->arena, lexicalAnalyzerContext->lexeme);
 	return STRING;
 }
 
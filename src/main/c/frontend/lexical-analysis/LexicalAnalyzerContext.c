@@ -21,24 +21,17 @@ extern union SemanticValue yylval;
 // The current lexeme (provided by Flex).
 extern char * yytext;
 
-/* PUBLIC FUNCTIONS */
+/* MODULE INTERNAL STATE */
 
-LexicalAnalyzerContext * createLexicalAnalyzerContext() {
-	LexicalAnalyzerContext * lexicalAnalyzerContext = calloc(1, sizeof(LexicalAnalyzerContext));
-	lexicalAnalyzerContext->length = yyleng;
-	lexicalAnalyzerContext->lexeme = calloc(1 + yyleng, sizeof(char));
-	lexicalAnalyzerContext->line = yylineno;
-	lexicalAnalyzerContext->semanticValue = &yylval;
-	lexicalAnalyzerContext->currentContext = flexCurrentContext();
-	strncpy(lexicalAnalyzerContext->lexeme, yytext, yyleng);
-	return lexicalAnalyzerContext;
-}
+static LexicalAnalyzerContext _lexicalAnalyzerContext;
+
+/* PUBLIC FUNCTIONS */
 
-void destroyLexicalAnalyzerContext(LexicalAnalyzerContext * lexicalAnalyzerContext) {
-	if (lexicalAnalyzerContext != NULL) {
-		if (lexicalAnalyzerContext->lexeme != NULL) {
-			free(lexicalAnalyzerContext->lexeme);
-		}
-		free(lexicalAnalyzerContext);
-	}
+LexicalAnalyzerContext * updateLexicalAnalyzerContext() {
+	_lexicalAnalyzerContext.length = yyleng;
+	_lexicalAnalyzerContext.lexeme = yytext;
+	_lexicalAnalyzerContext.line = yylineno;
+	_lexicalAnalyzerContext.semanticValue = &yylval;
+	_lexicalAnalyzerContext.currentContext = flexCurrentContext();
+	return &_lexicalAnalyzerContext;
 }
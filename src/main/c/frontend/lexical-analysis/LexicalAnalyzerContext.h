@@ -16,15 +16,12 @@ typedef struct {
 } LexicalAnalyzerContext;
 
 /**
- * Creates a new context with the current state of the lexical-analyzer over
- * the lexeme just consumed. The lexeme is a deep-copy of the original,
- * allocated in heap-memory.
+ * Updates the (unique) context with the current state of the lexical-analyzer
+ * over the lexeme just consumed, and returns it. No heap-memory is used: the
+ * lexeme points directly to the Flex buffer, so it's only valid until the next
+ * lexeme is consumed, and must be copied if it needs to outlive the scanner
+ * (e.g., identifiers and strings referenced by the AST).
  */
-LexicalAnalyzerContext * createLexicalAnalyzerContext();
-
-/**
- * Destroy a lexical-analyzer context and its resources.
- */
-void destroyLexicalAnalyzerContext(LexicalAnalyzerContext * lexicalAnalyzerContext);
+LexicalAnalyzerContext * updateLexicalAnalyzerContext();
 
 #endif
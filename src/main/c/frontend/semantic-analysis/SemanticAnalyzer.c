@@ -0,0 +1,151 @@
+#include "SemanticAnalyzer.h"
+
+/* MODULE INTERNAL STATE */
+
+static Logger *_logger = NULL;
+
+void initializeSemanticAnalyzerModule()
+{
+	_logger = createLogger("SemanticAnalyzer");
+}
+
+void shutdownSemanticAnalyzerModule()
+{
+	if (_logger != NULL)
+	{
+		destroyLogger(_logger);
+	}
+}
+
+/** PRIVATE FUNCTIONS */
+
+static boolean _resolveSymbols(const SymbolTable *symbolTable, const SymbolKind kind);
+static void _fillBuckets(Arena *arena, EntityBuckets *buckets, const unsigned int entityCount, const SymbolId *keys, const unsigned int itemCount);
+static void _indexDeclarations(Arena *arena, Program *program);
+
+/**
+ * Checks that every symbol of a kind is declared exactly once. Returns false
+ * if a symbol is declared more than once.
+ */
+static boolean _resolveSymbols(const SymbolTable *symbolTable, const SymbolKind kind)
+{
+	boolean succeed = true;
+	const unsigned int count = symbolCount(symbolTable, kind);
+	for (SymbolId id = 0; id < (SymbolId)count; ++id)
+	{
+		const Symbol *symbol = getSymbol(symbolTable, kind, id);
+		if (1 < symbol->declarations)
+		{
+			logError(_logger, "The %s \"%s\" is declared %u times.", symbolKindToString(kind), symbol->name, symbol->declarations);
+			succeed = false;
+		}
+		else if (symbol->declarations == 0)
+		{
+			logWarning(_logger, "The %s \"%s\" is not declared, so its %u reference(s) will be ignored.",
+					   symbolKindToString(kind), symbol->name, symbol->references);
+		}
+	}
+	logDebugging(_logger, "Resolved %u %s symbol(s).", count, symbolKindToString(kind));
+	return succeed;
+}
+
+/**
+ * Buckets the items by their key (or skips them, if it's UNDEFINED_SYMBOL)
+ * with a counting sort, where the counts are shifted by two, so the offsets
+ * end shifted by one, and the second pass leaves them in place.
+ */
+static void _fillBuckets(Arena *arena, EntityBuckets *buckets, const unsigned int entityCount, const SymbolId *keys, const unsigned int itemCount)
+{
+	buckets->first = arenaAllocate(arena, (entityCount + 2) * sizeof(unsigned int));
+	for (unsigned int k = 0; k < itemCount; ++k)
+	{
+		if (keys[k] != UNDEFINED_SYMBOL)
+		{
+			buckets->first[keys[k] + 2] += 1;
+		}
+	}
+	for (unsigned int e = 0; e < entityCount; ++e)
+	{
+		buckets->first[e + 2] += buckets->first[e + 1];
+	}
+	buckets->items = arenaAllocate(arena, (1 + buckets->first[entityCount + 1]) * sizeof(unsigned int));
+	for (unsigned int k = 0; k < itemCount; ++k)
+	{
+		if (keys[k] != UNDEFINED_SYMBOL)
+		{
+			buckets->items[buckets->first[keys[k] + 1]++] = k;
+		}
+	}
+}
+
+/**
+ * Builds the secondary indexes of the program (see "ProgramIndex"), and
+ * merges the demands of every course, warning about the courses required
+ * more than once.
+ */
+static void _indexDeclarations(Arena *arena, Program *program)
+{
+	ProgramIndex *index = &program->index;
+	const unsigned int keyCount = program->preferenceCount < program->demandCount ? program->demandCount : program->preferenceCount;
+	SymbolId *professors = calloc(1 + keyCount, sizeof(SymbolId));
+	SymbolId *courses = calloc(1 + keyCount, sizeof(SymbolId));
+	SymbolId *classrooms = calloc(1 + keyCount, sizeof(SymbolId));
+	for (unsigned int k = 0; k < program->preferenceCount; ++k)
+	{
+		const PreferenceDetails *details = &program->preferences[k].details;
+		const boolean indexed = details->professor != UNDEFINED_SYMBOL && program->professors[details->professor].declared
+			&& details->course != UNDEFINED_SYMBOL && program->courses[details->course].declared;
+		professors[k] = indexed ? details->professor : UNDEFINED_SYMBOL;
+		courses[k] = indexed ? details->course : UNDEFINED_SYMBOL;
+		classrooms[k] = indexed && details->classroom != UNDEFINED_SYMBOL && program->classrooms[details->classroom].declared
+			? details->classroom
+			: UNDEFINED_SYMBOL;
+	}
+	_fillBuckets(arena, &index->professorPreferences, program->professorCount, professors, program->preferenceCount);
+	_fillBuckets(arena, &index->coursePreferences, program->courseCount, courses, program->preferenceCount);
+	_fillBuckets(arena, &index->classroomPreferences, program->classroomCount, classrooms, program->preferenceCount);
+
+	for (unsigned int k = 0; k < program->demandCount; ++k)
+	{
+		const SymbolId course = program->demands[k].course;
+		courses[k] = course != UNDEFINED_SYMBOL && program->courses[course].declared ? course : UNDEFINED_SYMBOL;
+	}
+	_fillBuckets(arena, &index->courseDemands, program->courseCount, courses, program->demandCount);
+	index->courseStudents = arenaAllocate(arena, (1 + program->courseCount) * sizeof(int));
+	for (unsigned int c = 0; c < program->courseCount; ++c)
+	{
+		const EntityBuckets *demands = &index->courseDemands;
+		for (unsigned int j = demands->first[c]; j < demands->first[c + 1]; ++j)
+		{
+			index->courseStudents[c] += program->demands[demands->items[j]].students;
+		}
+		if (1 < demands->first[c + 1] - demands->first[c])
+		{
+			logWarning(_logger, "The course \"%s\" is required %u times, so its demands are merged in %d student(s).",
+					   program->courses[c].id, demands->first[c + 1] - demands->first[c], index->courseStudents[c]);
+		}
+	}
+	free(professors);
+	free(courses);
+	free(classrooms);
+	logDebugging(_logger, "Indexed %u preference(s) and %u demand(s) by entity.",
+				 index->coursePreferences.first[program->courseCount], index->courseDemands.first[program->courseCount]);
+}
+
+/** PUBLIC FUNCTIONS */
+
+SemanticAnalysisStatus analyzeSemantics(CompilerState *compilerState)
+{
+	logDebugging(_logger, "Analyzing semantics...");
+	boolean succeed = true;
+	for (SymbolKind kind = 0; kind < SYMBOL_FEATURE; ++kind)
+	{
+		succeed = _resolveSymbols(compilerState->symbolTable, kind) && succeed;
+	}
+	if (succeed)
+	{
+		_indexDeclarations(compilerState->arena, compilerState->abstractSyntaxtTree);
+	}
+	logDebugging(_logger, "Semantic analysis is done.");
+	return succeed ? SEMANTIC_ACCEPT : SEMANTIC_REJECT;
+}
@@ -0,0 +1,32 @@
+#ifndef SEMANTIC_ANALYZER_HEADER
+#define SEMANTIC_ANALYZER_HEADER
+
+#include "../../shared/CompilerState.h"
+#include "../../shared/Logger.h"
+#include "../../shared/SymbolTable.h"
+#include "../syntactic-analysis/AbstractSyntaxTree.h"
+
+/** Initialize module's internal state. */
+void initializeSemanticAnalyzerModule();
+
+/** Shutdown module's internal state. */
+void shutdownSemanticAnalyzerModule();
+
+typedef enum {
+	SEMANTIC_ACCEPT,
+	SEMANTIC_REJECT
+} SemanticAnalysisStatus;
+
+/**
+ * Executes the semantic-analysis phase of the compiler, over an accepted
+ * program. Every identifier was already interned in the symbol table during
+ * the parsing, so this phase resolves the references with a single linear
+ * pass over the symbols: a duplicated declaration rejects the program, and a
+ * reference to an undeclared entity is reported as a warning (and ignored by
+ * the following phases). Then, a second pass buckets the preferences and
+ * demands by entity (see "ProgramIndex"), merging the demands of a course
+ * that is required more than once (with a warning).
+ */
+SemanticAnalysisStatus analyzeSemantics(CompilerState * compilerState);
+
+#endif
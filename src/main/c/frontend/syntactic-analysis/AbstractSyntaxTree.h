@@ -2,6 +2,7 @@
 #define ABSTRACT_SYNTAX_TREE_HEADER
 
 #include "../../shared/Logger.h"
+#include "../../shared/SymbolTable.h"
 #include <stdlib.h>
 
 /** Initialize module's internal state. */
@@ -10,13 +11,6 @@ void initializeAbstractSyntaxTreeModule();
 /** Shutdown module's internal state. */
 void shutdownAbstractSyntaxTreeModule();
 
-typedef enum
-{
-	ENTITY_PROFESSOR,
-	ENTITY_COURSE,
-	ENTITY_CLASSROOM
-} EntityType;
-
 typedef enum
 {
 	HARD_PREFERENCE,
@@ -25,34 +19,55 @@ typedef enum
 
 typedef enum
 {
-	ATTR_INTERVAL,
-	ATTR_STRING,
-	ATTR_INT
-} AttributeType;
-
-typedef enum
-{
-	DECLARATION_ENTITY,
+	DECLARATION_PROFESSOR,
+	DECLARATION_COURSE,
+	DECLARATION_CLASSROOM,
 	DECLARATION_PREFERENCE,
 	DECLARATION_DEMAND
 } DeclarationType;
 
 /**
- * Node types for the Abstract Syntax Tree (AST).
+ * A set of classroom features ("has" and "requires"), where the bit "k" is
+ * the feature with symbol identifier "k". It has as many 64-bit words as its
+ * highest feature needs (i.e., the missing words are zero), so there is no
+ * limit on the amount of distinct features. The words live in the arena of
+ * the compiler.
  */
+typedef unsigned long long FeatureWord;
+
+#define FEATURE_WORD_BITS 64
+
+typedef struct
+{
+	FeatureWord *words;
+	unsigned int wordCount;
+	unsigned int wordCapacity;
+} FeatureMask;
 
-typedef struct Attribute
+/** Returns true if a mask has the feature with the specified identifier. */
+static inline boolean featureMaskHas(const FeatureMask *mask, const SymbolId feature)
 {
-	char *key; // "name", "hours", "available"
-	union
+	const unsigned int word = feature / FEATURE_WORD_BITS;
+	return word < mask->wordCount && ((mask->words[word] >> (feature % FEATURE_WORD_BITS)) & 1) ? true : false;
+}
+
+/** Returns true if every feature of "required" is also in "available". */
+static inline boolean featureMaskCovers(const FeatureMask *available, const FeatureMask *required)
+{
+	for (unsigned int k = 0; k < required->wordCount; ++k)
 	{
-		char *strValue;
-		int intValue;
-		IntervalDayOfWeek intervalValue;
-	};
-	AttributeType attributeType;
-	struct Attribute *next; // para lista enlazada simple
-} Attribute;
+		const FeatureWord words = k < available->wordCount ? available->words[k] : 0;
+		if ((words & required->words[k]) != required->words[k])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Node types for the Abstract Syntax Tree (AST).
+ */
 
 typedef struct UniversityOpen
 {
@@ -73,18 +88,56 @@ typedef struct
 	boolean hasClassDuration;
 } Configuration;
 
-typedef struct Entity
+/**
+ * Typed entities. Every property is a direct field, filled by the grammar
+ * actions while parsing. The arrays live in the compiler arena.
+ */
+
+typedef struct Professor
+{
+	char *id;		  // identificador del profesor
+	SymbolId symbol;  // id denso del profesor
+	char *name;		  // NULL si no se especifica
+	boolean declared; // false si solo fue referenciado (hueco en el arreglo)
+
+	IntervalDayOfWeek *availability; // vector de disponibilidad ("available")
+	unsigned int availabilityCount;
+	unsigned int availabilityCapacity;
+
+	SymbolId *courses; // conjunto de cursos que puede dictar ("can teach"), sin repetidos
+	unsigned int courseCount;
+	unsigned int courseCapacity;
+} Professor;
+
+typedef struct Course
 {
-	char *id;			   // id de la entidad (nombre del profesor, nombre del curso o nombre del aula)
-	Attribute *attributes; // lista enlazada de atributos
-	EntityType type;	   // tipo de entidad (profesor, curso o aula)
-} Entity;
+	char *id;			  // identificador del curso
+	SymbolId symbol;	  // id denso del curso
+	char *name;			  // NULL si no se especifica
+	boolean declared;	  // false si solo fue referenciado (hueco en el arreglo)
+	int hours;			  // horas semanales (0 si no se especifica)
+	FeatureMask requires; // caracteristicas requeridas del aula
+} Course;
+
+typedef struct Classroom
+{
+	char *id;			  // identificador del aula
+	SymbolId symbol;	  // id denso del aula
+	char *name;			  // NULL si no se especifica
+	boolean declared;	  // false si solo fue referenciada (hueco en el arreglo)
+	char *building;		  // NULL si no se especifica
+	int capacity;		  // cantidad de alumnos (0 si no se especifica)
+	FeatureMask features; // caracteristicas del aula ("has")
+} Classroom;
 
 typedef struct PreferenceDetails
 {
 	char *professorId;
 	char *courseId;
 	char *classroomId;
+	SymbolId professor; // UNDEFINED_SYMBOL si no se especifica
+	SymbolId course;
+	SymbolId classroom;
 	Time startTime;
 	Time endTime;
 	DayOfWeek day;
@@ -94,13 +147,14 @@ typedef struct PreferenceDetails
 
 typedef struct Preference
 {
-	PreferenceDetails *details; // detalles de la preferencia
-	PreferenceType type;		// tipo de preferencia (dura o blanda)
+	PreferenceDetails details; // detalles de la preferencia
+	PreferenceType type;	   // tipo de preferencia (dura o blanda)
 } Preference;
 
 typedef struct Demand
 {
 	char *courseId;
+	SymbolId course;
 	int students;
 } Demand;
 
@@ -109,26 +163,75 @@ typedef struct Declaration
 	DeclarationType type;
 	union
 	{
-		Entity *entity;
+		Professor *professor;
+		Course *course;
+		Classroom *classroom;
 		Preference *preference;
 		Demand *demand;
 	};
-	struct Declaration *next; // para lista enlazada simple
 } Declaration;
 
-typedef struct Program
+/**
+ * A secondary index of declarations by entity, in CSR format: the
+ * declarations of the entity with symbol "e" are items[first[e]] to
+ * items[first[e + 1] - 1] (as indexes of their array in the program, in
+ * order of declaration).
+ */
+typedef struct EntityBuckets
 {
-	Configuration configuration; // configuracion de la universidad
-	Declaration *declarations;	 // lista enlazada de declaraciones
-} Program;
+	unsigned int *first;
+	unsigned int *items;
+} EntityBuckets;
 
 /**
- * Node recursive destructors.
+ * The buckets of the preferences and demands of a program, by entity, built
+ * by the semantic-analysis (in the compiler arena), so the following phases
+ * query them in O(degree). A preference is only indexed if its professor and
+ * its course are declared (and by classroom, if its classroom is declared
+ * too), and a demand if its course is declared. The demands of a course are
+ * merged in the sum of their students.
  */
-void releaseAttribute(Attribute *attribute);
-void releasePreference(Preference *preference);
-void releaseEntity(Entity *entity);
-void releaseDeclaration(Declaration *declaration);
-void releaseProgram(Program *program);
+typedef struct ProgramIndex
+{
+	EntityBuckets professorPreferences;
+	EntityBuckets coursePreferences;
+	EntityBuckets classroomPreferences;
+	EntityBuckets courseDemands;
+	int *courseStudents; // alumnos de cada curso (la suma de sus demandas)
+} ProgramIndex;
+
+/**
+ * The declarations of a program are stored in contiguous arrays (one for each
+ * kind of declaration), that grow geometrically inside the compiler arena.
+ * The entities are indexed by symbol identifier, so the entity with symbol
+ * "k" is always at index "k" (undeclared symbols leave a hole, with the
+ * "declared" flag in false).
+ */
+typedef struct Program
+{
+	Configuration configuration; // configuracion de la universidad
+
+	Professor *professors; // indexados por simbolo
+	unsigned int professorCount;
+	unsigned int professorCapacity;
+
+	Course *courses; // indexados por simbolo
+	unsigned int courseCount;
+	unsigned int courseCapacity;
+
+	Classroom *classrooms; // indexados por simbolo
+	unsigned int classroomCount;
+	unsigned int classroomCapacity;
+
+	Preference *preferences; // en orden de declaracion
+	unsigned int preferenceCount;
+	unsigned int preferenceCapacity;
+
+	Demand *demands; // en orden de declaracion
+	unsigned int demandCount;
+	unsigned int demandCapacity;
+
+	ProgramIndex index; // indices secundarios (ver el analisis semantico)
+} Program;
 
 #endif
@@ -24,8 +24,11 @@ extern unsigned int flexCurrentContext(void);
 /* PRIVATE FUNCTIONS */
 
 static void _logSyntacticAnalyzerAction(const char *functionName);
-static Entity *_createEntity(EntityType type, char *id, Attribute *attributes);
+static void *_allocate(const size_t size);
+static SymbolTable *_symbolTable();
+static void _addFeature(FeatureMask *mask, char *feature);
 static Preference *_createPreference(PreferenceType type);
+static void *_reserveEntities(void *entities, unsigned int *capacity, unsigned int *count, const unsigned int required, const size_t size);
 
 /**
  * Logs a syntactic-analyzer action in DEBUGGING level.
@@ -35,79 +38,200 @@ static void _logSyntacticAnalyzerAction(const char *functionName)
 	logDebugging(_logger, "%s", functionName);
 }
 
+/**
+ * Allocates a zero-initialized AST node inside the arena of the current
+ * compiler state.
+ */
+static void *_allocate(const size_t size)
+{
+	return arenaAllocate(currentCompilerState()->arena, size);
+}
+
+/**
+ * The symbol table of the current compiler state.
+ */
+static SymbolTable *_symbolTable()
+{
+	return currentCompilerState()->symbolTable;
+}
+
+/**
+ * Interns a feature, and adds its bit to a mask (growing it in the arena, with
+ * zeroed words, if the feature is beyond its last word).
+ */
+static void _addFeature(FeatureMask *mask, char *feature)
+{
+	const SymbolId id = referenceSymbol(_symbolTable(), SYMBOL_FEATURE, feature);
+	if (id == UNDEFINED_SYMBOL)
+	{
+		return;
+	}
+	const unsigned int word = (unsigned int)id / FEATURE_WORD_BITS;
+	if (mask->wordCount <= word)
+	{
+		mask->words = arenaReserveArray(currentCompilerState()->arena, mask->words, &mask->wordCapacity, word + 1, sizeof(FeatureWord));
+		memset(mask->words + mask->wordCount, 0, (word + 1 - mask->wordCount) * sizeof(FeatureWord));
+		mask->wordCount = word + 1;
+	}
+	mask->words[word] |= ((FeatureWord)1) << ((unsigned int)id % FEATURE_WORD_BITS);
+}
+
+static Preference *_createPreference(PreferenceType type)
+{
+	Preference *preference = _allocate(sizeof(Preference));
+	preference->type = type;
+	preference->details.hasTime = false;
+	preference->details.hasDay = false;
+	preference->details.professorId = NULL;
+	preference->details.courseId = NULL;
+	preference->details.classroomId = NULL;
+	preference->details.professor = UNDEFINED_SYMBOL;
+	preference->details.course = UNDEFINED_SYMBOL;
+	preference->details.classroom = UNDEFINED_SYMBOL;
+	return preference;
+}
+
+/**
+ * Ensures that an array of entities has at least "required" slots (zeroed
+ * slots are undeclared holes).
+ */
+static void *_reserveEntities(void *entities, unsigned int *capacity, unsigned int *count, const unsigned int required, const size_t size)
+{
+	entities = arenaReserveArray(currentCompilerState()->arena, entities, capacity, required, size);
+	if (*count < required)
+	{
+		*count = required;
+	}
+	return entities;
+}
+
 /* PUBLIC FUNCTIONS */
 
-Attribute *createIntAttribute(char *key, int value)
+Professor *newProfessor()
 {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Attribute *attribute = calloc(1, sizeof(Attribute));
-	attribute->key = key;
-	attribute->intValue = value;
-	attribute->attributeType = ATTR_INT;
-	attribute->next = NULL;
-	return attribute;
+	return _allocate(sizeof(Professor));
 }
 
-Attribute *createStringAttribute(char *key, char *value)
+Professor *setProfessorName(Professor *professor, char *name)
 {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Attribute *attribute = calloc(1, sizeof(Attribute));
-	attribute->key = key;
-	attribute->strValue = value;
-	attribute->attributeType = ATTR_STRING;
-	attribute->next = NULL;
-	return attribute;
+	professor->name = name;
+	return professor;
 }
 
-Attribute *createIntervalAttribute(char *key, IntervalDayOfWeek interval)
+Professor *addProfessorAvailability(Professor *professor, IntervalDayOfWeek interval)
 {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Attribute *attribute = calloc(1, sizeof(Attribute));
-	attribute->key = key;
-	attribute->intervalValue = interval;
-	attribute->attributeType = ATTR_INTERVAL;
-	attribute->next = NULL;
-	return attribute;
+	professor->availability = arenaReserveArray(currentCompilerState()->arena, professor->availability,
+												&professor->availabilityCapacity, 1 + professor->availabilityCount, sizeof(IntervalDayOfWeek));
+	professor->availability[professor->availabilityCount++] = interval;
+	return professor;
 }
 
-Attribute *appendAttribute(Attribute *head, Attribute *newAttribute)
+Professor *addProfessorCourse(Professor *professor, char *courseId)
 {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	if (head == NULL)
-	{
-		return newAttribute;
-	}
-	Attribute *current = head;
-	while (current->next != NULL)
+	const SymbolId course = referenceSymbol(_symbolTable(), SYMBOL_COURSE, courseId);
+	for (unsigned int k = 0; k < professor->courseCount; ++k)
 	{
-		current = current->next;
+		if (professor->courses[k] == course)
+		{
+			return professor;
+		}
 	}
-	current->next = newAttribute;
-	return head;
+	professor->courses = arenaReserveArray(currentCompilerState()->arena, professor->courses,
+										   &professor->courseCapacity, 1 + professor->courseCount, sizeof(SymbolId));
+	professor->courses[professor->courseCount++] = course;
+	return professor;
+}
+
+Professor *createProfessor(char *id, Professor *professor)
+{
+	_logSyntacticAnalyzerAction(__FUNCTION__);
+	professor->id = id;
+	professor->symbol = declareSymbol(_symbolTable(), SYMBOL_PROFESSOR, id);
+	professor->declared = true;
+	return professor;
+}
+
+Course *newCourse()
+{
+	_logSyntacticAnalyzerAction(__FUNCTION__);
+	return _allocate(sizeof(Course));
+}
+
+Course *setCourseName(Course *course, char *name)
+{
+	_logSyntacticAnalyzerAction(__FUNCTION__);
+	course->name = name;
+	return course;
+}
+
+Course *setCourseHours(Course *course, int hours)
+{
+	_logSyntacticAnalyzerAction(__FUNCTION__);
+	course->hours = hours;
+	return course;
+}
+
+Course *addCourseRequirement(Course *course, char *feature)
+{
+	_logSyntacticAnalyzerAction(__FUNCTION__);
+	_addFeature(&course->requires, feature);
+	return course;
+}
+
+Course *createCourse(char *id, Course *course)
+{
+	_logSyntacticAnalyzerAction(__FUNCTION__);
+	course->id = id;
+	course->symbol = declareSymbol(_symbolTable(), SYMBOL_COURSE, id);
+	course->declared = true;
+	return course;
+}
+
+Classroom *newClassroom()
+{
+	_logSyntacticAnalyzerAction(__FUNCTION__);
+	return _allocate(sizeof(Classroom));
 }
 
-Attribute *newAttributeList()
+Classroom *setClassroomName(Classroom *classroom, char *name)
 {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	return NULL;
+	classroom->name = name;
+	return classroom;
 }
 
-Entity *createCourse(char *id, Attribute *attributes)
+Classroom *setClassroomBuilding(Classroom *classroom, char *building)
 {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	return _createEntity(ENTITY_COURSE, id, attributes);
+	classroom->building = building;
+	return classroom;
 }
 
-Entity *createProfessor(char *id, Attribute *attributes)
+Classroom *setClassroomCapacity(Classroom *classroom, int capacity)
 {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	return _createEntity(ENTITY_PROFESSOR, id, attributes);
+	classroom->capacity = capacity;
+	return classroom;
 }
 
-Entity *createClassroom(char *id, Attribute *attributes)
+Classroom *addClassroomFeature(Classroom *classroom, char *feature)
 {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	return _createEntity(ENTITY_CLASSROOM, id, attributes);
+	_addFeature(&classroom->features, feature);
+	return classroom;
+}
+
+Classroom *createClassroom(char *id, Classroom *classroom)
+{
+	_logSyntacticAnalyzerAction(__FUNCTION__);
+	classroom->id = id;
+	classroom->symbol = declareSymbol(_symbolTable(), SYMBOL_CLASSROOM, id);
+	classroom->declared = true;
+	return classroom;
 }
 
 Configuration createConfiguration(UniversityOpen universityOpen, ClassDuration classDuration)
@@ -129,12 +253,19 @@ Configuration createConfigurationWithoutClassDuration(UniversityOpen universityO
 	return configuration;
 }
 
-Program *newProgram(CompilerState *compilerState, Configuration configuration, Declaration *declarations)
+Program *newProgram(CompilerState *compilerState, Configuration configuration, Program *declarations)
 {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Program *program = calloc(1, sizeof(Program));
+	Program *program = declarations;
 	program->configuration = configuration;
-	program->declarations = declarations;
+	// Every symbol gets a slot, even the undeclared ones (as holes).
+	SymbolTable *symbolTable = compilerState->symbolTable;
+	program->professors = _reserveEntities(program->professors, &program->professorCapacity, &program->professorCount,
+										   symbolCount(symbolTable, SYMBOL_PROFESSOR), sizeof(Professor));
+	program->courses = _reserveEntities(program->courses, &program->courseCapacity, &program->courseCount,
+										symbolCount(symbolTable, SYMBOL_COURSE), sizeof(Course));
+	program->classrooms = _reserveEntities(program->classrooms, &program->classroomCapacity, &program->classroomCount,
+										   symbolCount(symbolTable, SYMBOL_CLASSROOM), sizeof(Classroom));
 	compilerState->abstractSyntaxtTree = program;
 	if (0 < flexCurrentContext())
 	{
@@ -148,45 +279,89 @@ Program *newProgram(CompilerState *compilerState, Configuration configuration, D
 	return program;
 }
 
-Declaration *newDeclarationList()
+Program *newDeclarationList()
 {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	return NULL;
+	return _allocate(sizeof(Program));
 }
 
-Declaration *appendDeclaration(Declaration *head, Declaration *newDeclaration)
+Program *appendDeclaration(Program *program, Declaration declaration)
 {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	if (head == NULL)
-	{
-		return newDeclaration;
-	}
-	Declaration *current = head;
-	while (current->next != NULL)
+	Arena *arena = currentCompilerState()->arena;
+	switch (declaration.type)
 	{
-		current = current->next;
+	case DECLARATION_PROFESSOR:
+		program->professors = _reserveEntities(program->professors, &program->professorCapacity, &program->professorCount,
+											   1 + declaration.professor->symbol, sizeof(Professor));
+		program->professors[declaration.professor->symbol] = *declaration.professor;
+		break;
+	case DECLARATION_COURSE:
+		program->courses = _reserveEntities(program->courses, &program->courseCapacity, &program->courseCount,
+											1 + declaration.course->symbol, sizeof(Course));
+		program->courses[declaration.course->symbol] = *declaration.course;
+		break;
+	case DECLARATION_CLASSROOM:
+		program->classrooms = _reserveEntities(program->classrooms, &program->classroomCapacity, &program->classroomCount,
+											   1 + declaration.classroom->symbol, sizeof(Classroom));
+		program->classrooms[declaration.classroom->symbol] = *declaration.classroom;
+		break;
+	case DECLARATION_PREFERENCE:
+		program->preferences = arenaReserveArray(arena, program->preferences, &program->preferenceCapacity, 1 + program->preferenceCount, sizeof(Preference));
+		program->preferences[program->preferenceCount++] = *declaration.preference;
+		break;
+	case DECLARATION_DEMAND:
+		program->demands = arenaReserveArray(arena, program->demands, &program->demandCapacity, 1 + program->demandCount, sizeof(Demand));
+		program->demands[program->demandCount++] = *declaration.demand;
+		break;
+	default:
+		break;
 	}
-	current->next = newDeclaration;
-	return head;
+	return program;
+}
+
+Declaration createProfessorDeclaration(Professor *professor)
+{
+	_logSyntacticAnalyzerAction(__FUNCTION__);
+	Declaration declaration;
+	declaration.type = DECLARATION_PROFESSOR;
+	declaration.professor = professor;
+	return declaration;
 }
 
-Declaration *createEntityDeclaration(Entity *entity)
+Declaration createCourseDeclaration(Course *course)
 {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Declaration *declaration = calloc(1, sizeof(Declaration));
-	declaration->type = DECLARATION_ENTITY;
-	declaration->entity = entity;
-	declaration->next = NULL;
+	Declaration declaration;
+	declaration.type = DECLARATION_COURSE;
+	declaration.course = course;
 	return declaration;
 }
 
-Declaration *createPreferenceDeclaration(Preference *preference)
+Declaration createClassroomDeclaration(Classroom *classroom)
 {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Declaration *declaration = calloc(1, sizeof(Declaration));
-	declaration->type = DECLARATION_PREFERENCE;
-	declaration->preference = preference;
-	declaration->next = NULL;
+	Declaration declaration;
+	declaration.type = DECLARATION_CLASSROOM;
+	declaration.classroom = classroom;
+	return declaration;
+}
+
+Declaration createPreferenceDeclaration(Preference *preference)
+{
+	_logSyntacticAnalyzerAction(__FUNCTION__);
+	Declaration declaration;
+	declaration.type = DECLARATION_PREFERENCE;
+	declaration.preference = preference;
+	return declaration;
+}
+
+Declaration createDemandDeclaration(Demand *demand)
+{
+	_logSyntacticAnalyzerAction(__FUNCTION__);
+	Declaration declaration;
+	declaration.type = DECLARATION_DEMAND;
+	declaration.demand = demand;
 	return declaration;
 }
 
@@ -196,6 +371,7 @@ Preference *createHardPreference()
 	Preference *preference = _createPreference(HARD_PREFERENCE);
 	return preference;
 }
+
 Preference *createSoftPreference()
 {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
@@ -205,69 +381,41 @@ Preference *createSoftPreference()
 
 void setPreferenceProfessor(Preference *preference, char *professorId)
 {
-	preference->details->professorId = professorId;
+	preference->details.professorId = professorId;
+	preference->details.professor = referenceSymbol(_symbolTable(), SYMBOL_PROFESSOR, professorId);
 }
 
 void setPreferenceCourse(Preference *preference, char *courseId)
 {
-	preference->details->courseId = courseId;
+	preference->details.courseId = courseId;
+	preference->details.course = referenceSymbol(_symbolTable(), SYMBOL_COURSE, courseId);
 }
 
 void setPreferenceClassroom(Preference *preference, char *classroomId)
 {
-	preference->details->classroomId = classroomId;
+	preference->details.classroomId = classroomId;
+	preference->details.classroom = referenceSymbol(_symbolTable(), SYMBOL_CLASSROOM, classroomId);
 }
 
 void setPreferenceTime(Preference *preference, Time startTime, Time endTime)
 {
-	preference->details->startTime = startTime;
-	preference->details->endTime = endTime;
-	preference->details->hasTime = true;
+	preference->details.startTime = startTime;
+	preference->details.endTime = endTime;
+	preference->details.hasTime = true;
 }
 
 void setPreferenceDay(Preference *preference, DayOfWeek day)
 {
-	preference->details->day = day;
-	preference->details->hasDay = true;
-}
-
-Declaration *createDemandDeclaration(Demand *demand)
-{
-	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Declaration *declaration = calloc(1, sizeof(Declaration));
-	declaration->type = DECLARATION_DEMAND;
-	declaration->demand = demand;
-	declaration->next = NULL;
-	return declaration;
+	preference->details.day = day;
+	preference->details.hasDay = true;
 }
 
 Demand *createDemand(char *courseId, int students)
 {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Demand *demand = calloc(1, sizeof(Demand));
+	Demand *demand = _allocate(sizeof(Demand));
 	demand->courseId = courseId;
+	demand->course = referenceSymbol(_symbolTable(), SYMBOL_COURSE, courseId);
 	demand->students = students;
 	return demand;
 }
-
-static Preference *_createPreference(PreferenceType type)
-{
-	Preference *preference = calloc(1, sizeof(Preference));
-	preference->type = type;
-	preference->details = calloc(1, sizeof(PreferenceDetails));
-	preference->details->hasTime = false;
-	preference->details->hasDay = false;
-	preference->details->professorId = NULL;
-	preference->details->courseId = NULL;
-	preference->details->classroomId = NULL;
-	return preference;
-}
-
-static Entity *_createEntity(EntityType type, char *id, Attribute *attributes)
-{
-	Entity *entity = calloc(1, sizeof(Entity));
-	entity->id = id;
-	entity->attributes = attributes;
-	entity->type = type;
-	return entity;
-}
\ No newline at end of file
@@ -18,13 +18,15 @@ void shutdownBisonActionsModule();
  * Bison semantic actions.
  */
 
-Program *newProgram(CompilerState *compilerState, Configuration configuration, Declaration *declarations);
+Program *newProgram(CompilerState *compilerState, Configuration configuration, Program *declarations);
 
-Declaration *newDeclarationList();
-Declaration *appendDeclaration(Declaration *head, Declaration *newDeclaration);
-Declaration *createEntityDeclaration(Entity *entity);
-Declaration *createPreferenceDeclaration(Preference *preference);
-Declaration *createDemandDeclaration(Demand *demand);
+Program *newDeclarationList();
+Program *appendDeclaration(Program *program, Declaration declaration);
+Declaration createProfessorDeclaration(Professor *professor);
+Declaration createCourseDeclaration(Course *course);
+Declaration createClassroomDeclaration(Classroom *classroom);
+Declaration createPreferenceDeclaration(Preference *preference);
+Declaration createDemandDeclaration(Demand *demand);
 
 Demand *createDemand(char *courseId, int students);
 
@@ -37,15 +39,24 @@ void setPreferenceClassroom(Preference *preference, char *classroomId);
 void setPreferenceTime(Preference *preference, Time startTime, Time endTime);
 void setPreferenceDay(Preference *preference, DayOfWeek days);
 
-Entity *createProfessor(char *id, Attribute *attributes);
-Entity *createCourse(char *id, Attribute *attributes);
-Entity *createClassroom(char *id, Attribute *attributes);
+Professor *newProfessor();
+Professor *setProfessorName(Professor *professor, char *name);
+Professor *addProfessorAvailability(Professor *professor, IntervalDayOfWeek interval);
+Professor *addProfessorCourse(Professor *professor, char *courseId);
+Professor *createProfessor(char *id, Professor *professor);
 
-Attribute *newAttributeList();
-Attribute *appendAttribute(Attribute *head, Attribute *newAttribute);
-Attribute *createIntAttribute(char *key, int value);
-Attribute *createStringAttribute(char *key, char *value);
-Attribute *createIntervalAttribute(char *key, IntervalDayOfWeek interval);
+Course *newCourse();
+Course *setCourseName(Course *course, char *name);
+Course *setCourseHours(Course *course, int hours);
+Course *addCourseRequirement(Course *course, char *feature);
+Course *createCourse(char *id, Course *course);
+
+Classroom *newClassroom();
+Classroom *setClassroomName(Classroom *classroom, char *name);
+Classroom *setClassroomBuilding(Classroom *classroom, char *building);
+Classroom *setClassroomCapacity(Classroom *classroom, int capacity);
+Classroom *addClassroomFeature(Classroom *classroom, char *feature);
+Classroom *createClassroom(char *id, Classroom *classroom);
 
 Configuration createConfiguration(UniversityOpen universityOpen, ClassDuration classDuration);
 Configuration createConfigurationWithoutClassDuration(UniversityOpen universityOpen);
@@ -19,13 +19,12 @@
 	/** Non-terminals. */
 
 	Program * program; // general program
-	Declaration * declarationList; // general declaration
-	Declaration * declaration; // general declaration
+	Declaration declaration; // general declaration
 	Demand * demand; // general demand
 	Preference * preference; // general preference
-	Entity * entity; // professor, course or classroom
-	Attribute * attribute; // attribute for course or professor (hours, name, available, etc)
-	Attribute * attributeList; // list of attributes for course or professor
+	Professor * professor; // professor record, filled attribute by attribute
+	Course * course; // course record, filled attribute by attribute
+	Classroom * classroom; // classroom record, filled attribute by attribute
 
 	Configuration configuration; // configuration of the university
 	UniversityOpen universityOpen; // university open
@@ -34,22 +33,13 @@
 }
 
 /**
- * Destructors. This functions are executed after the parsing ends, so if the
- * AST must be used in the following phases of the compiler you shouldn't used
- * this approach. To use this mechanism, the AST must be translated into
- * another structure.
+ * Destructors. There are none: every node of the AST (and every string it
+ * references) is allocated inside the arena of the compiler state, which is
+ * released at once after the compilation, even if the parsing fails.
  *
  * @see https://www.gnu.org/software/bison/manual/html_node/Destructor-Decl.html
  */
 
-/*
-%destructor { releaseAttribute($$); } <attribute>
-%destructor { releaseEntity($$); } <entity>
-%destructor { releaseEntity($$); } <entityList>
-%destructor { releaseAttribute($$); } <attributeList>
-%destructor { releaseProgram($$); } <program>
-*/
-
 /* Terminals. */
 %token <token> COURSE
 %token <token> PROFESSOR
@@ -110,23 +100,22 @@
 %type <dayOfWeek> dayOfWeekOrEveryday
 %type <intervalDayOfWeek> intervalDayOfWeek
 
-%type <declarationList> declarationList
+%type <program> declarationList
 %type <declaration> declaration
 
-%type <entity> entity
+%type <professor> professor
+%type <course> course
+%type <classroom> classroom
 
 %type <preference> preference
 %type <demand> demand
 
 /* Attribute validation */
-%type <attribute> professorAttribute
-%type <attribute> courseAttribute
-%type <attribute> classroomAttribute
-%type <attribute> nameAttribute
+%type <string> nameAttribute
 
-%type <attributeList> professorAttributeList
-%type <attributeList> courseAttributeList
-%type <attributeList> classroomAttributeList
+%type <professor> professorAttributeList
+%type <course> courseAttributeList
+%type <classroom> classroomAttributeList
 
 %type <universityOpen> universityOpen
 %type <classDuration> classDuration
@@ -146,7 +135,7 @@
 program:
 	configuration declarationList
 	{
-		// The program is a list of entities (professors and courses).
+		// The declaration list is already a program (without configuration).
 		$$ = newProgram(currentCompilerState(), $1, $2);
 	}
 ;
@@ -167,9 +156,17 @@ configuration:
 ;
 
 declaration:
-	entity
+	professor
+	{
+		$$ = createProfessorDeclaration($1);
+	}
+	| course
+	{
+		$$ = createCourseDeclaration($1);
+	}
+	| classroom
 	{
-		$$ = createEntityDeclaration($1);
+		$$ = createClassroomDeclaration($1);
 	}
 	| preference
 	{
@@ -276,99 +273,92 @@ declarationList:
 	}
 ;
 
-entity:
+professor:
 	PROFESSOR IDENTIFIER LBRACE professorAttributeList RBRACE
 	{
 		$$ = createProfessor($2, $4);
 	}
-	| COURSE IDENTIFIER LBRACE courseAttributeList RBRACE
+;
+
+course:
+	COURSE IDENTIFIER LBRACE courseAttributeList RBRACE
 	{
 		$$ = createCourse($2, $4);
 	}
-	| CLASSROOM IDENTIFIER LBRACE classroomAttributeList RBRACE
+;
+
+classroom:
+	CLASSROOM IDENTIFIER LBRACE classroomAttributeList RBRACE
 	{
 		$$ = createClassroom($2, $4);
 	}
 ;
 
-professorAttributeList:
-	professorAttributeList professorAttribute
-	{
-		$$ = appendAttribute($1, $2);
-	}
-	| 
+nameAttribute:
+	NAME COLON STRING SEMICOLON
 	{
-		$$ = newAttributeList();
+		$$ = $3;
 	}
 ;
 
-courseAttributeList:
-	courseAttributeList courseAttribute
+professorAttributeList:
+	professorAttributeList nameAttribute
 	{
-		$$ = appendAttribute($1, $2);
+		$$ = setProfessorName($1, $2);
 	}
-	|
+	| professorAttributeList AVAILABLE intervalDayOfWeek SEMICOLON
 	{
-		$$ = newAttributeList();
+		$$ = addProfessorAvailability($1, $3);
 	}
-;
-
-classroomAttributeList:
-	classroomAttributeList classroomAttribute
+	| professorAttributeList CAN TEACH IDENTIFIER SEMICOLON
 	{
-		$$ = appendAttribute($1, $2);
+		$$ = addProfessorCourse($1, $4);
 	}
 	| 
 	{
-		$$ = newAttributeList();
+		$$ = newProfessor();
 	}
 ;
 
-nameAttribute:
-	NAME COLON STRING SEMICOLON
+courseAttributeList:
+	courseAttributeList nameAttribute
 	{
-		$$ = createStringAttribute("name", $3);
+		$$ = setCourseName($1, $2);
 	}
-
-professorAttribute:
-	nameAttribute
-	|
-	AVAILABLE intervalDayOfWeek SEMICOLON
+	| courseAttributeList HOURS COLON INTEGER SEMICOLON
+	{
+		$$ = setCourseHours($1, $4);
+	}
+	| courseAttributeList REQUIRES STRING SEMICOLON
 	{
-		$$ = createIntervalAttribute("available", $2);
+		$$ = addCourseRequirement($1, $3);
 	}
 	|
-	CAN TEACH IDENTIFIER SEMICOLON
 	{
-		$$ = createStringAttribute("canTeach", $3);
+		$$ = newCourse();
 	}
 ;
 
-courseAttribute:
-	nameAttribute
-	| HOURS COLON INTEGER SEMICOLON
+classroomAttributeList:
+	classroomAttributeList nameAttribute
 	{
-		$$ = createIntAttribute("hours", $3);
+		$$ = setClassroomName($1, $2);
 	}
-	| REQUIRES STRING SEMICOLON
+	| classroomAttributeList BUILDING COLON STRING SEMICOLON
 	{
-		$$ = createStringAttribute("requires", $2);
+		$$ = setClassroomBuilding($1, $4);
 	}
-;
-
-classroomAttribute:
-	nameAttribute
-	| BUILDING COLON STRING SEMICOLON
+	| classroomAttributeList CAPACITY COLON INTEGER SEMICOLON
 	{
-		$$ = createStringAttribute("building", $3);
+		$$ = setClassroomCapacity($1, $4);
 	}
-	| CAPACITY COLON INTEGER SEMICOLON
+	| classroomAttributeList HAS STRING SEMICOLON
 	{
-		$$ = createIntAttribute("capacity", $3);
+		$$ = addClassroomFeature($1, $3);
 	}
-	| HAS STRING SEMICOLON
+	| 
 	{
-		$$ = createStringAttribute("has", $2);
+		$$ = newClassroom();
 	}
 ;
 
@@ -18,7 +18,7 @@ void shutdownSyntacticAnalyzerModule() {
 
 /** IMPORTED FUNCTIONS */
 
-extern LexicalAnalyzerContext * createLexicalAnalyzerContext();
+extern LexicalAnalyzerContext * updateLexicalAnalyzerContext();
 
 /**
  * Bison exported functions.
@@ -35,7 +35,7 @@ extern int yyparse(void);
 
 // Bison error-reporting function.
 void yyerror(const char * string) {
-	LexicalAnalyzerContext * lexicalAnalyzerContext = createLexicalAnalyzerContext();
+	LexicalAnalyzerContext * lexicalAnalyzerContext = updateLexicalAnalyzerContext();
 	logError(_logger, "Syntax error (on line %d).", lexicalAnalyzerContext->line);
 }
 
@@ -0,0 +1,100 @@
+#include "Arena.h"
+
+/* PRIVATE FUNCTIONS */
+
+// The alignment of every block served by the arena.
+#define ARENA_ALIGNMENT (2 * sizeof(void *) < sizeof(long double) ? sizeof(long double) : 2 * sizeof(void *))
+
+static ArenaChunk * _createArenaChunk(Arena * arena, const size_t capacity);
+
+/**
+ * Reserves a new chunk from the system, and links it as the current chunk of
+ * the arena.
+ */
+static ArenaChunk * _createArenaChunk(Arena * arena, const size_t capacity) {
+	ArenaChunk * chunk = calloc(1, sizeof(ArenaChunk));
+	chunk->capacity = capacity;
+	chunk->offset = 0;
+	chunk->memory = calloc(capacity, sizeof(unsigned char));
+	chunk->previous = arena->current;
+	arena->current = chunk;
+	arena->statistics.chunks += 1;
+	arena->statistics.reservedBytes += capacity;
+	return chunk;
+}
+
+/* PUBLIC FUNCTIONS */
+
+Arena * createArena(const size_t chunkSize) {
+	Arena * arena = calloc(1, sizeof(Arena));
+	arena->chunkSize = chunkSize == 0 ? ARENA_DEFAULT_CHUNK_SIZE : chunkSize;
+	arena->current = NULL;
+	return arena;
+}
+
+void destroyArena(Arena * arena) {
+	if (arena != NULL) {
+		ArenaChunk * chunk = arena->current;
+		while (chunk != NULL) {
+			ArenaChunk * previous = chunk->previous;
+			free(chunk->memory);
+			free(chunk);
+			chunk = previous;
+		}
+		free(arena);
+	}
+}
+
+void * arenaAllocate(Arena * arena, const size_t size) {
+	const size_t alignedSize = (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+	ArenaChunk * chunk = arena->current;
+	if (chunk == NULL || chunk->capacity - chunk->offset < alignedSize) {
+		if (arena->chunkSize < alignedSize) {
+			// Oversized blocks get a dedicated chunk, so the current one can
+			// still serve the small requests.
+			ArenaChunk * dedicated = _createArenaChunk(arena, alignedSize);
+			dedicated->offset = alignedSize;
+			if (chunk != NULL) {
+				arena->current = chunk;
+				dedicated->previous = chunk->previous;
+				chunk->previous = dedicated;
+			}
+			arena->statistics.allocations += 1;
+			arena->statistics.requestedBytes += size;
+			return dedicated->memory;
+		}
+		chunk = _createArenaChunk(arena, arena->chunkSize);
+	}
+	void * block = chunk->memory + chunk->offset;
+	chunk->offset += alignedSize;
+	arena->statistics.allocations += 1;
+	arena->statistics.requestedBytes += size;
+	return block;
+}
+
+void * arenaReserveArray(Arena * arena, void * array, unsigned int * capacity, const unsigned int required, const size_t elementSize) {
+	if (required <= *capacity) {
+		return array;
+	}
+	unsigned int newCapacity = *capacity < 8 ? 8 : 2 * *capacity;
+	while (newCapacity < required) {
+		newCapacity *= 2;
+	}
+	void * newArray = arenaAllocate(arena, newCapacity * elementSize);
+	if (array != NULL) {
+		memcpy(newArray, array, *capacity * elementSize);
+	}
+	*capacity = newCapacity;
+	return newArray;
+}
+
+char * arenaDuplicateString(Arena * arena, const char * string) {
+	return arenaDuplicateStringWithLength(arena, string, strlen(string));
+}
+
+char * arenaDuplicateStringWithLength(Arena * arena, const char * string, const size_t length) {
+	char * copy = arenaAllocate(arena, 1 + length);
+	memcpy(copy, string, length);
+	copy[length] = '\0';
+	return copy;
+}
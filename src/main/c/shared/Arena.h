@@ -0,0 +1,82 @@
+#ifndef ARENA_HEADER
+#define ARENA_HEADER
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * The default size of every chunk reserved by an arena, in bytes. Requests
+ * larger than this size get a dedicated chunk.
+ */
+#define ARENA_DEFAULT_CHUNK_SIZE (64 * 1024)
+
+/**
+ * A contiguous block of heap-memory, from which the arena serves its
+ * allocations by bumping an offset.
+ */
+typedef struct ArenaChunk {
+	struct ArenaChunk * previous;
+	size_t capacity;
+	size_t offset;
+	unsigned char * memory;
+} ArenaChunk;
+
+/**
+ * Counters that describe the usage of an arena. Every call to "arenaAllocate"
+ * is an allocation, but only the chunks are requested to the system.
+ */
+typedef struct {
+	size_t allocations;
+	size_t chunks;
+	size_t requestedBytes;
+	size_t reservedBytes;
+} ArenaStatistics;
+
+/**
+ * A bump (a.k.a. region) allocator. Every block allocated from an arena lives
+ * until the arena is destroyed, and then all of them are released at once,
+ * without walking the structures built over them.
+ */
+typedef struct {
+	ArenaChunk * current;
+	size_t chunkSize;
+	ArenaStatistics statistics;
+} Arena;
+
+/**
+ * Creates a new arena that reserves chunks of the specified size (in bytes).
+ * Use zero (0) to select the default chunk size.
+ */
+Arena * createArena(const size_t chunkSize);
+
+/**
+ * Destroy an arena and every block allocated from it.
+ */
+void destroyArena(Arena * arena);
+
+/**
+ * Allocates a zero-initialized block of memory inside the arena, aligned to
+ * the strictest fundamental alignment of the platform.
+ */
+void * arenaAllocate(Arena * arena, const size_t size);
+
+/**
+ * Ensures that an array allocated in the arena can hold at least "required"
+ * elements, and returns it (possibly moved). The capacity grows geometrically,
+ * so appending N elements one by one costs O(N) amortized. The old block is
+ * not reused until the arena is destroyed.
+ */
+void * arenaReserveArray(Arena * arena, void * array, unsigned int * capacity, const unsigned int required, const size_t elementSize);
+
+/**
+ * Copies a null-terminated string inside the arena.
+ */
+char * arenaDuplicateString(Arena * arena, const char * string);
+
+/**
+ * Copies the first "length" characters of a string inside the arena, and
+ * appends a null-terminator.
+ */
+char * arenaDuplicateStringWithLength(Arena * arena, const char * string, const size_t length);
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef COMPILER_STATE_HEADER
 #define COMPILER_STATE_HEADER
 
+#include "Arena.h"
+#include "SymbolTable.h"
 #include "Type.h"
 
 /**
@@ -19,11 +21,16 @@ typedef struct {
 	// The root node of the AST.
 	void * abstractSyntaxtTree;
 
+	// The region that owns every node of the AST (and its strings).
+	Arena * arena;
+
 	// A flag that indicates the current state of the compilation so far.
 	boolean succeed;
 
+	// The professors, courses and classrooms, interned while parsing.
+	SymbolTable * symbolTable;
+
 	// TODO: Add an stack to handle nested scopes.
-	// TODO: Add a symbol table.
 	// TODO: Add configuration.
 	// TODO: ...
 
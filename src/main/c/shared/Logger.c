@@ -85,6 +85,10 @@ void destroyLogger(Logger * logger) {
 	}
 }
 
+const boolean isLoggingLevelEnabled(const Logger * logger, const LoggingLevel loggingLevel) {
+	return logger->loggingLevel <= loggingLevel;
+}
+
 void logCritical(const Logger * logger, const char * const format, ...) {
 	va_list arguments;
 	va_start(arguments, format);
@@ -86,6 +86,12 @@ Logger * createLogger(char * name);
  */
 void destroyLogger(Logger * logger);
 
+/**
+ * Returns true if the logger would emit a message at the specified level.
+ * Useful to avoid building expensive log arguments that would be discarded.
+ */
+const boolean isLoggingLevelEnabled(const Logger * logger, const LoggingLevel loggingLevel);
+
 /** Logs at CRITICAL level. */
 void logCritical(const Logger * logger, const char * const format, ...);
 
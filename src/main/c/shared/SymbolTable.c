@@ -0,0 +1,155 @@
+#include "SymbolTable.h"
+
+/* PRIVATE FUNCTIONS */
+
+// The initial amount of buckets of every namespace (a power of 2).
+#define INITIAL_BUCKET_COUNT 64
+
+static unsigned int _hash(const char * name);
+static SymbolId _find(const SymbolNamespace * namespace, const char * name, const unsigned int hash, unsigned int * bucket);
+static void _rehash(SymbolNamespace * namespace);
+static SymbolId _intern(SymbolNamespace * namespace, const char * name);
+
+/**
+ * The FNV-1a hash of a null-terminated string.
+ *
+ * @see http://www.isthe.com/chongo/tech/comp/fnv/
+ */
+static unsigned int _hash(const char * name) {
+	unsigned int hash = 2166136261u;
+	for (const unsigned char * character = (const unsigned char *) name; *character != '\0'; ++character) {
+		hash ^= *character;
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+/**
+ * Finds a name in the namespace. If it's absent, returns UNDEFINED_SYMBOL and
+ * the first empty bucket of the probe sequence (if the bucket is not NULL).
+ */
+static SymbolId _find(const SymbolNamespace * namespace, const char * name, const unsigned int hash, unsigned int * bucket) {
+	if (namespace->bucketCount == 0) {
+		return UNDEFINED_SYMBOL;
+	}
+	const unsigned int mask = namespace->bucketCount - 1;
+	unsigned int k = hash & mask;
+	while (namespace->buckets[k] != UNDEFINED_SYMBOL) {
+		const Symbol * symbol = &namespace->symbols[namespace->buckets[k]];
+		if (symbol->hash == hash && strcmp(symbol->name, name) == 0) {
+			return namespace->buckets[k];
+		}
+		k = (k + 1) & mask;
+	}
+	if (bucket != NULL) {
+		*bucket = k;
+	}
+	return UNDEFINED_SYMBOL;
+}
+
+/**
+ * Doubles the amount of buckets, and reinserts every symbol.
+ */
+static void _rehash(SymbolNamespace * namespace) {
+	const unsigned int bucketCount = namespace->bucketCount == 0 ? INITIAL_BUCKET_COUNT : 2 * namespace->bucketCount;
+	free(namespace->buckets);
+	namespace->buckets = malloc(bucketCount * sizeof(SymbolId));
+	namespace->bucketCount = bucketCount;
+	for (unsigned int k = 0; k < bucketCount; ++k) {
+		namespace->buckets[k] = UNDEFINED_SYMBOL;
+	}
+	const unsigned int mask = bucketCount - 1;
+	for (unsigned int id = 0; id < namespace->count; ++id) {
+		unsigned int k = namespace->symbols[id].hash & mask;
+		while (namespace->buckets[k] != UNDEFINED_SYMBOL) {
+			k = (k + 1) & mask;
+		}
+		namespace->buckets[k] = id;
+	}
+}
+
+/**
+ * Returns the identifier of a name, adding it to the namespace if absent. The
+ * load factor of the hash table is kept below 1/2.
+ */
+static SymbolId _intern(SymbolNamespace * namespace, const char * name) {
+	const unsigned int hash = _hash(name);
+	unsigned int bucket = 0;
+	SymbolId id = _find(namespace, name, hash, &bucket);
+	if (id != UNDEFINED_SYMBOL) {
+		return id;
+	}
+	if (namespace->bucketCount <= 2 * (namespace->count + 1)) {
+		_rehash(namespace);
+		_find(namespace, name, hash, &bucket);
+	}
+	if (namespace->count == namespace->capacity) {
+		namespace->capacity = namespace->capacity == 0 ? INITIAL_BUCKET_COUNT : 2 * namespace->capacity;
+		namespace->symbols = realloc(namespace->symbols, namespace->capacity * sizeof(Symbol));
+	}
+	id = namespace->count++;
+	Symbol * symbol = &namespace->symbols[id];
+	symbol->name = name;
+	symbol->hash = hash;
+	symbol->declarations = 0;
+	symbol->references = 0;
+	namespace->buckets[bucket] = id;
+	return id;
+}
+
+/* PUBLIC FUNCTIONS */
+
+SymbolTable * createSymbolTable() {
+	return calloc(1, sizeof(SymbolTable));
+}
+
+void destroySymbolTable(SymbolTable * symbolTable) {
+	if (symbolTable != NULL) {
+		for (unsigned int kind = 0; kind < SYMBOL_KIND_COUNT; ++kind) {
+			free(symbolTable->namespaces[kind].symbols);
+			free(symbolTable->namespaces[kind].buckets);
+		}
+		free(symbolTable);
+	}
+}
+
+SymbolId declareSymbol(SymbolTable * symbolTable, const SymbolKind kind, const char * name) {
+	SymbolNamespace * namespace = &symbolTable->namespaces[kind];
+	const SymbolId id = _intern(namespace, name);
+	namespace->symbols[id].declarations += 1;
+	return id;
+}
+
+SymbolId referenceSymbol(SymbolTable * symbolTable, const SymbolKind kind, const char * name) {
+	SymbolNamespace * namespace = &symbolTable->namespaces[kind];
+	const SymbolId id = _intern(namespace, name);
+	namespace->symbols[id].references += 1;
+	return id;
+}
+
+SymbolId lookupSymbol(const SymbolTable * symbolTable, const SymbolKind kind, const char * name) {
+	return _find(&symbolTable->namespaces[kind], name, _hash(name), NULL);
+}
+
+const Symbol * getSymbol(const SymbolTable * symbolTable, const SymbolKind kind, const SymbolId id) {
+	return &symbolTable->namespaces[kind].symbols[id];
+}
+
+unsigned int symbolCount(const SymbolTable * symbolTable, const SymbolKind kind) {
+	return symbolTable->namespaces[kind].count;
+}
+
+const char * symbolKindToString(const SymbolKind kind) {
+	switch (kind) {
+		case SYMBOL_PROFESSOR:
+			return "professor";
+		case SYMBOL_COURSE:
+			return "course";
+		case SYMBOL_CLASSROOM:
+			return "classroom";
+		case SYMBOL_FEATURE:
+			return "feature";
+		default:
+			return "symbol";
+	}
+}
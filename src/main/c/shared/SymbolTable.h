@@ -0,0 +1,107 @@
+#ifndef SYMBOL_TABLE_HEADER
+#define SYMBOL_TABLE_HEADER
+
+#include "Type.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * A dense identifier of a symbol, unique inside its kind. The symbols of each
+ * kind are numbered from zero (0), in order of first appearance, so they can
+ * be used to index plain arrays.
+ */
+typedef int SymbolId;
+
+/**
+ * The identifier of an absent symbol (e.g., a preference without classroom).
+ */
+#define UNDEFINED_SYMBOL (-1)
+
+/**
+ * Every kind has its own namespace (i.e., a professor and a course can share
+ * the same name). Features (e.g., "projector") are never declared: they are
+ * only referenced by classrooms and courses.
+ */
+typedef enum {
+	SYMBOL_PROFESSOR,
+	SYMBOL_COURSE,
+	SYMBOL_CLASSROOM,
+	SYMBOL_FEATURE,
+	SYMBOL_KIND_COUNT
+} SymbolKind;
+
+/**
+ * An interned name. The name is not copied, so it must live at least as long
+ * as the table (e.g., inside the compiler arena).
+ */
+typedef struct {
+	const char * name;
+	unsigned int hash;
+	unsigned int declarations;
+	unsigned int references;
+} Symbol;
+
+/**
+ * The symbols of a single kind: a dense array of symbols, indexed by an
+ * open-addressing hash table with linear probing.
+ */
+typedef struct {
+	Symbol * symbols;
+	unsigned int count;
+	unsigned int capacity;
+	SymbolId * buckets;
+	unsigned int bucketCount;
+} SymbolNamespace;
+
+/**
+ * A symbol table, with a namespace for each kind of symbol.
+ */
+typedef struct {
+	SymbolNamespace namespaces[SYMBOL_KIND_COUNT];
+} SymbolTable;
+
+/**
+ * Creates an empty symbol table.
+ */
+SymbolTable * createSymbolTable();
+
+/**
+ * Destroy a symbol table and its resources (but not the names).
+ */
+void destroySymbolTable(SymbolTable * symbolTable);
+
+/**
+ * Interns a name as the declaration of a symbol, and returns its identifier.
+ * Declaring the same name twice is allowed here, but it's reported later by
+ * the semantic-analysis.
+ */
+SymbolId declareSymbol(SymbolTable * symbolTable, const SymbolKind kind, const char * name);
+
+/**
+ * Interns a name as a reference to a symbol, and returns its identifier. The
+ * symbol may be declared later (or never).
+ */
+SymbolId referenceSymbol(SymbolTable * symbolTable, const SymbolKind kind, const char * name);
+
+/**
+ * Finds the identifier of a name, without interning it. Returns
+ * UNDEFINED_SYMBOL if the name is unknown.
+ */
+SymbolId lookupSymbol(const SymbolTable * symbolTable, const SymbolKind kind, const char * name);
+
+/**
+ * Retrieves a symbol by identifier.
+ */
+const Symbol * getSymbol(const SymbolTable * symbolTable, const SymbolKind kind, const SymbolId id);
+
+/**
+ * The amount of symbols of the specified kind (declared or not).
+ */
+unsigned int symbolCount(const SymbolTable * symbolTable, const SymbolKind kind);
+
+/**
+ * A human-readable name of a kind of symbol.
+ */
+const char * symbolKindToString(const SymbolKind kind);
+
+#endif
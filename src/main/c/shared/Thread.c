@@ -0,0 +1,127 @@
+#include "Thread.h"
+
+/* PRIVATE FUNCTIONS */
+
+#if defined (WINDOWS_THREADS)
+static DWORD WINAPI _run(LPVOID argument);
+
+static DWORD WINAPI _run(LPVOID argument) {
+	Thread * thread = argument;
+	thread->function(thread->argument);
+	return 0;
+}
+#else
+static void * _run(void * argument);
+
+static void * _run(void * argument) {
+	Thread * thread = argument;
+	thread->function(thread->argument);
+	return NULL;
+}
+#endif
+
+/* PUBLIC FUNCTIONS */
+
+boolean createThread(Thread * thread, ThreadFunction function, void * argument) {
+	thread->function = function;
+	thread->argument = argument;
+#if defined (WINDOWS_THREADS)
+	thread->handle = CreateThread(NULL, 0, _run, thread, 0, NULL);
+	return thread->handle == NULL ? false : true;
+#else
+	return pthread_create(&thread->handle, NULL, _run, thread) == 0 ? true : false;
+#endif
+}
+
+void joinThread(Thread * thread) {
+#if defined (WINDOWS_THREADS)
+	WaitForSingleObject(thread->handle, INFINITE);
+	CloseHandle(thread->handle);
+#else
+	pthread_join(thread->handle, NULL);
+#endif
+}
+
+void yieldThread() {
+#if defined (WINDOWS_THREADS)
+	SwitchToThread();
+#else
+	sched_yield();
+#endif
+}
+
+unsigned int availableProcessors() {
+#if defined (WINDOWS_THREADS)
+	SYSTEM_INFO information;
+	GetSystemInfo(&information);
+	return information.dwNumberOfProcessors < 1 ? 1 : information.dwNumberOfProcessors;
+#else
+	const long processors = sysconf(_SC_NPROCESSORS_ONLN);
+	return processors < 1 ? 1 : (unsigned int) processors;
+#endif
+}
+
+void createMutex(Mutex * mutex) {
+#if defined (WINDOWS_THREADS)
+	InitializeCriticalSection(&mutex->handle);
+#else
+	pthread_mutex_init(&mutex->handle, NULL);
+#endif
+}
+
+void destroyMutex(Mutex * mutex) {
+#if defined (WINDOWS_THREADS)
+	DeleteCriticalSection(&mutex->handle);
+#else
+	pthread_mutex_destroy(&mutex->handle);
+#endif
+}
+
+void lockMutex(Mutex * mutex) {
+#if defined (WINDOWS_THREADS)
+	EnterCriticalSection(&mutex->handle);
+#else
+	pthread_mutex_lock(&mutex->handle);
+#endif
+}
+
+void unlockMutex(Mutex * mutex) {
+#if defined (WINDOWS_THREADS)
+	LeaveCriticalSection(&mutex->handle);
+#else
+	pthread_mutex_unlock(&mutex->handle);
+#endif
+}
+
+long atomicLoad(Atomic * atomic) {
+#if defined (WINDOWS_THREADS)
+	return InterlockedCompareExchange(atomic, 0, 0);
+#else
+	return __atomic_load_n(atomic, __ATOMIC_ACQUIRE);
+#endif
+}
+
+void atomicStore(Atomic * atomic, const long value) {
+#if defined (WINDOWS_THREADS)
+	InterlockedExchange(atomic, value);
+#else
+	__atomic_store_n(atomic, value, __ATOMIC_RELEASE);
+#endif
+}
+
+long atomicAdd(Atomic * atomic, const long delta) {
+#if defined (WINDOWS_THREADS)
+	return InterlockedExchangeAdd(atomic, delta) + delta;
+#else
+	return __atomic_add_fetch(atomic, delta, __ATOMIC_ACQ_REL);
+#endif
+}
+
+boolean atomicCompareAndSwap(Atomic * atomic, const long expected, const long value) {
+#if defined (WINDOWS_THREADS)
+	return InterlockedCompareExchange(atomic, value, expected) == expected ? true : false;
+#else
+	long current = expected;
+	return __atomic_compare_exchange_n(atomic, &current, value, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) ? true : false;
+#endif
+}
@@ -0,0 +1,111 @@
+#ifndef THREAD_HEADER
+#define THREAD_HEADER
+
+#include "Type.h"
+#include <stdlib.h>
+
+/**
+ * Platform dependent threads.
+ *
+ * @see https://sourceforge.net/p/predef/wiki/OperatingSystems/
+ */
+#if defined (__TOS_WIN__) \
+	|| defined (__WIN32__) \
+	|| defined (__WINDOWS__) \
+	|| defined (_WIN16) \
+	|| defined (_WIN32) \
+	|| defined (_WIN64)
+#define WINDOWS_THREADS
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#define POSIX_THREADS
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+/**
+ * The body of a thread. It receives the argument passed to "createThread".
+ */
+typedef void (* ThreadFunction)(void * argument);
+
+/**
+ * A native thread, and the function it runs.
+ */
+typedef struct {
+#if defined (WINDOWS_THREADS)
+	HANDLE handle;
+#else
+	pthread_t handle;
+#endif
+	ThreadFunction function;
+	void * argument;
+} Thread;
+
+/**
+ * A mutual exclusion lock.
+ */
+typedef struct {
+#if defined (WINDOWS_THREADS)
+	CRITICAL_SECTION handle;
+#else
+	pthread_mutex_t handle;
+#endif
+} Mutex;
+
+/**
+ * An integer that can be shared between threads without locks (e.g., a flag
+ * to cancel the work of other threads).
+ */
+typedef volatile long Atomic;
+
+/**
+ * Starts a thread that runs the function with the argument. Returns false if
+ * the system cannot create more threads.
+ */
+boolean createThread(Thread * thread, ThreadFunction function, void * argument);
+
+/**
+ * Waits until the thread finishes, and releases its resources.
+ */
+void joinThread(Thread * thread);
+
+/**
+ * Gives the processor to other thread (e.g., while waiting for work).
+ */
+void yieldThread();
+
+/**
+ * The amount of processors available to this process (at least one).
+ */
+unsigned int availableProcessors();
+
+/** Initializes a mutex. */
+void createMutex(Mutex * mutex);
+
+/** Releases the resources of a mutex. */
+void destroyMutex(Mutex * mutex);
+
+/** Blocks until the mutex is acquired. */
+void lockMutex(Mutex * mutex);
+
+/** Releases the mutex. */
+void unlockMutex(Mutex * mutex);
+
+/** Reads an atomic integer. */
+long atomicLoad(Atomic * atomic);
+
+/** Writes an atomic integer. */
+void atomicStore(Atomic * atomic, const long value);
+
+/** Adds a delta to an atomic integer, and returns the new value. */
+long atomicAdd(Atomic * atomic, const long delta);
+
+/**
+ * Replaces the value of an atomic integer only if it's equal to the expected
+ * one. Returns true if the value was replaced.
+ */
+boolean atomicCompareAndSwap(Atomic * atomic, const long expected, const long value);
+
+#endif